@@ -0,0 +1,53 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_BENCHMARK_UTIL_H_
+#define FLATBUFFERS_BENCHMARK_UTIL_H_
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Helpers for the benchmarks in this directory, which are built with
+// -DFLATBUFFERS_BUILD_BENCHMARKS=ON. Build them with optimizations
+// (-DCMAKE_BUILD_TYPE=Release), timings of a debug build mean little.
+
+// The best time of `runs` calls of `f`, in milliseconds.
+template<typename F> double BestTimeMs(int runs, F f) {
+  double best = 0;
+  for (int i = 0; i < runs; i++) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+    if (!i || ms < best) best = ms;
+  }
+  return best;
+}
+
+// The first command line argument as a count, if given.
+inline int CountArg(int argc, char *argv[], int default_count) {
+  if (argc < 2) return default_count;
+  auto count = atoi(argv[1]);
+  return count > 0 ? count : default_count;
+}
+
+inline void PrintResult(const char *name, double ms, int count) {
+  printf("%-40s %8.1f ms %8.1f ns/op\n", name, ms, ms * 1e6 / count);
+}
+
+#endif  // FLATBUFFERS_BENCHMARK_UTIL_H_
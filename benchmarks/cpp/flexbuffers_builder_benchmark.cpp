@@ -0,0 +1,105 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Builds many small FlexBuffers in a loop, handing each to a consumer that
+// keeps the last few, like a send queue: with a new Builder each time, with
+// one Builder and a copy of its buffer, and with Release() and a BufferPool.
+// Usage: flatbenchmark_flexbuffers_builder [buffers]
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "flatbuffers/flexbuffers.h"
+
+namespace {
+
+const size_t kQueueSize = 8;
+
+void Build(flexbuffers::Builder &builder, int i) {
+  builder.Map([&]() {
+    builder.Int("id", i);
+    builder.String("name", "event");
+    builder.Double("value", i * 0.25);
+  });
+  builder.Finish();
+}
+
+class Consumer {
+ public:
+  explicit Consumer(flexbuffers::BufferPool *pool = nullptr)
+      : pool_(pool), bytes_(0) {}
+
+  void Consume(std::vector<uint8_t> &&buf) {
+    bytes_ += buf.size();
+    queue_.push_back(std::move(buf));
+    if (queue_.size() > kQueueSize) {
+      if (pool_) pool_->Deallocate(&queue_.front());
+      queue_.pop_front();
+    }
+  }
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  flexbuffers::BufferPool *pool_;
+  std::deque<std::vector<uint8_t>> queue_;
+  size_t bytes_;
+};
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  auto buffers = CountArg(argc, argv, 1000000);
+  printf("%d small maps\n", buffers);
+
+  size_t bytes = 0;
+  auto ms = BestTimeMs(3, [&]() {
+    Consumer consumer;
+    for (int i = 0; i < buffers; i++) {
+      flexbuffers::Builder builder;
+      Build(builder, i);
+      consumer.Consume(std::vector<uint8_t>(builder.GetBuffer()));
+    }
+    bytes = consumer.bytes();
+  });
+  PrintResult("new Builder + copy", ms, buffers);
+
+  ms = BestTimeMs(3, [&]() {
+    Consumer consumer;
+    flexbuffers::Builder builder;
+    for (int i = 0; i < buffers; i++) {
+      builder.Clear();
+      Build(builder, i);
+      consumer.Consume(std::vector<uint8_t>(builder.GetBuffer()));
+    }
+  });
+  PrintResult("Clear() + copy", ms, buffers);
+
+  ms = BestTimeMs(3, [&]() {
+    flexbuffers::BufferPool pool;
+    Consumer consumer(&pool);
+    flexbuffers::Builder builder(256, flexbuffers::BUILDER_FLAG_SHARE_KEYS,
+                                 &pool);
+    for (int i = 0; i < buffers; i++) {
+      Build(builder, i);
+      consumer.Consume(builder.Release());
+    }
+  });
+  PrintResult("Release() + BufferPool", ms, buffers);
+  return bytes ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Converts a large JSON document of many small objects to a FlexBuffer with
+// Parser::ParseFlexBuffer() and with JsonToFlexBuffer, given the whole
+// document and in 4KB chunks. Usage: flatbenchmark_json_to_flexbuffer [items]
+
+#include <algorithm>
+#include <string>
+
+#include "benchmark_util.h"
+#include "flatbuffers/flexbuffers.h"
+#include "flatbuffers/idl.h"
+#include "flatbuffers/json.h"
+#include "flatbuffers/util.h"
+
+namespace {
+
+const size_t kChunkSize = 4096;
+
+std::string MakeJson(int items) {
+  std::string json = "{ \"items\": [\n";
+  for (int i = 0; i < items; i++) {
+    json += "  { \"id\": " + flatbuffers::NumToString(i * 7919) +
+            ", \"name\": \"item number " + flatbuffers::NumToString(i) +
+            "\", \"price\": " + flatbuffers::NumToString(i * 0.37) +
+            ", \"tags\": [\"red\", \"large\", \"sale\"], \"active\": " +
+            (i % 2 ? "true" : "false") + ", \"ref\": null }" +
+            (i + 1 < items ? ",\n" : "\n");
+  }
+  json += "] }";
+  return json;
+}
+
+void Report(const char *name, double ms, const std::string &json,
+            size_t size) {
+  printf("%-40s %8.1f ms %8.1f MB/s -> %d bytes\n", name, ms,
+         static_cast<double>(json.size()) / 1e3 / ms, static_cast<int>(size));
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  auto items = CountArg(argc, argv, 100000);
+  auto json = MakeJson(items);
+  printf("%.1f MB of JSON, %d objects\n",
+         static_cast<double>(json.size()) / 1e6, items);
+
+  size_t size = 0;
+  auto ms = BestTimeMs(3, [&]() {
+    flatbuffers::Parser parser;
+    flexbuffers::Builder builder(1 << 20);
+    if (!parser.ParseFlexBuffer(json.c_str(), nullptr, &builder)) {
+      printf("error: %s\n", parser.error_.c_str());
+    }
+    size = builder.GetSize();
+  });
+  Report("Parser::ParseFlexBuffer", ms, json, size);
+
+  ms = BestTimeMs(3, [&]() {
+    flexbuffers::Builder builder(1 << 20);
+    flatbuffers::JsonToFlexBuffer converter(&builder);
+    if (!converter.Feed(json) || !converter.Finish()) {
+      printf("error: %s\n", converter.error().c_str());
+    }
+    size = builder.GetSize();
+  });
+  Report("JsonToFlexBuffer, whole input", ms, json, size);
+
+  ms = BestTimeMs(3, [&]() {
+    flexbuffers::Builder builder(1 << 20);
+    flatbuffers::JsonToFlexBuffer converter(&builder);
+    for (size_t i = 0; i < json.size(); i += kChunkSize) {
+      if (!converter.Feed(json.c_str() + i,
+                          (std::min)(kChunkSize, json.size() - i))) {
+        break;
+      }
+    }
+    if (!converter.Finish()) {
+      printf("error: %s\n", converter.error().c_str());
+    }
+    size = builder.GetSize();
+  });
+  Report("JsonToFlexBuffer, 4KB chunks", ms, json, size);
+  return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Builds many small messages that repeat the same strings, such as host and
+// metric names, with CreateString(), CreateSharedString() and a
+// StringDictionary. Usage: flatbenchmark_string_dictionary [messages]
+
+#include <string>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/string_dictionary.h"
+#include "flatbuffers/util.h"
+
+namespace {
+
+const int kStringsPerMessage = 6;
+
+enum Mode { kCreateString, kCreateSharedString, kDictionary };
+
+struct Strings {
+  std::vector<std::string> hosts;
+  std::vector<std::string> metrics;
+  std::vector<const flatbuffers::InternedString *> interned_hosts;
+  std::vector<const flatbuffers::InternedString *> interned_metrics;
+};
+
+size_t Build(const Strings &strings, const flatbuffers::StringDictionary &dict,
+             Mode mode, int messages) {
+  flatbuffers::FlatBufferBuilder fbb(256);
+  fbb.SetStringDictionary(&dict);
+  size_t total = 0;
+  for (int n = 0; n < messages; n++) {
+    fbb.Clear();
+    flatbuffers::Offset<flatbuffers::String> offsets[kStringsPerMessage];
+    for (int k = 0; k < kStringsPerMessage; k++) {
+      // Alternate hosts and metrics, and repeat some within a message.
+      auto is_host = (k & 1) != 0;
+      auto &names = is_host ? strings.hosts : strings.metrics;
+      auto &interned =
+          is_host ? strings.interned_hosts : strings.interned_metrics;
+      auto i = static_cast<size_t>(is_host ? n + k / 3 : n * 7 + k % 3) %
+               names.size();
+      switch (mode) {
+        case kCreateString: offsets[k] = fbb.CreateString(names[i]); break;
+        case kCreateSharedString:
+          offsets[k] = fbb.CreateSharedString(names[i]);
+          break;
+        case kDictionary:
+          offsets[k] = fbb.CreateSharedString(*interned[i]);
+          break;
+      }
+    }
+    fbb.Finish(fbb.CreateVector(offsets, kStringsPerMessage));
+    total += fbb.GetSize();
+  }
+  return total;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  auto messages = CountArg(argc, argv, 1000000);
+  Strings strings;
+  flatbuffers::StringDictionary dict;
+  for (int i = 0; i < 50; i++) {
+    strings.hosts.push_back("host-" + flatbuffers::NumToString(i) +
+                            ".cluster.example.com");
+    strings.interned_hosts.push_back(&dict.Intern(strings.hosts.back()));
+  }
+  for (int i = 0; i < 200; i++) {
+    strings.metrics.push_back("service.request.latency.p" +
+                              flatbuffers::NumToString(i));
+    strings.interned_metrics.push_back(&dict.Intern(strings.metrics.back()));
+  }
+
+  printf("%d messages of %d strings from a set of %d\n", messages,
+         kStringsPerMessage,
+         static_cast<int>(strings.hosts.size() + strings.metrics.size()));
+  const char *names[] = { "CreateString", "CreateSharedString",
+                          "CreateSharedString(InternedString)" };
+  for (int mode = kCreateString; mode <= kDictionary; mode++) {
+    size_t total = 0;
+    auto ms = BestTimeMs(3, [&]() {
+      total = Build(strings, dict, static_cast<Mode>(mode), messages);
+    });
+    PrintResult(names[mode], ms, messages);
+    if (!total) return 1;
+  }
+  return 0;
+}
@@ -263,6 +263,17 @@ namespace flatbuffers {
   #endif
 #endif // !FLATBUFFERS_HAS_NEW_STRTOD
 
+#ifndef FLATBUFFERS_HAS_THREADS
+  // std::thread, std::mutex and std::atomic are available for use, they are
+  // only used by the opt-in multithreaded paths (see idl_gen_text.cpp).
+  // Define FLATBUFFERS_HAS_THREADS=0 on targets without thread support.
+  #if !defined(FLATBUFFERS_CPP98_STL) && !defined(__EMSCRIPTEN__)
+    #define FLATBUFFERS_HAS_THREADS 1
+  #else
+    #define FLATBUFFERS_HAS_THREADS 0
+  #endif
+#endif // !FLATBUFFERS_HAS_THREADS
+
 #ifndef FLATBUFFERS_LOCALE_INDEPENDENT
   // Enable locale independent functions {strtof_l, strtod_l,strtoll_l, strtoull_l}.
   #if ((defined(_MSC_VER) && _MSC_VER >= 1800)            || \
@@ -18,6 +18,7 @@
 #define FLATBUFFERS_H_
 
 #include "flatbuffers/base.h"
+#include "flatbuffers/hash.h"
 #include "flatbuffers/stl_emulation.h"
 
 #ifndef FLATBUFFERS_CPP98_STL
@@ -936,12 +937,103 @@ class DetachedBuffer {
   }
 };
 
+// What a FlatBufferBuilder spent its time and space on, to tune its initial
+// size, growth and deduplication. Filled in by a builder given to
+// FlatBufferBuilder::SetStats(), which only does so when compiled with
+// FLATBUFFERS_BUILDER_STATS. Like VerifierStats, none of the bookkeeping is
+// compiled in without it (builders keep the same layout either way), and a
+// builder without stats costs a pointer check per allocation, table, shared
+// string and alignment with it.
+struct BuilderStats {
+  size_t allocations;    // Of buffer blocks, including segments.
+  size_t reallocations;  // Of a full buffer into a larger one.
+  size_t bytes_copied;   // Moving data and scratchpad to new blocks.
+  size_t vtables_written;
+  size_t vtables_deduped;
+  size_t vtable_bytes_saved;  // By the deduplicated vtables.
+  size_t shared_string_hits;
+  size_t shared_string_misses;
+  size_t shared_string_bytes_saved;  // Including padding.
+  size_t padding_bytes;
+  size_t max_scratch_bytes;
+
+  BuilderStats() { Reset(); }
+
+  void Reset() {
+    allocations = reallocations = bytes_copied = 0;
+    vtables_written = vtables_deduped = vtable_bytes_saved = 0;
+    shared_string_hits = shared_string_misses = 0;
+    shared_string_bytes_saved = padding_bytes = max_scratch_bytes = 0;
+  }
+
+  // Adds up the statistics of builders, e.g. all builders of a service.
+  void Merge(const BuilderStats &other) {
+    allocations += other.allocations;
+    reallocations += other.reallocations;
+    bytes_copied += other.bytes_copied;
+    vtables_written += other.vtables_written;
+    vtables_deduped += other.vtables_deduped;
+    vtable_bytes_saved += other.vtable_bytes_saved;
+    shared_string_hits += other.shared_string_hits;
+    shared_string_misses += other.shared_string_misses;
+    shared_string_bytes_saved += other.shared_string_bytes_saved;
+    padding_bytes += other.padding_bytes;
+    max_scratch_bytes = (std::max)(max_scratch_bytes, other.max_scratch_bytes);
+  }
+};
+
+// How a FlatBufferBuilder grows its buffer once it is full. Without one, the
+// buffer grows by half of its size.
+class GrowthPolicy {
+ public:
+  virtual ~GrowthPolicy() {}
+
+  // Returns how many bytes to add to a buffer of `reserved` bytes that needs
+  // `len` more. Anything less than `len` counts as `len`.
+  virtual size_t Grow(size_t reserved, size_t len) = 0;
+};
+
+// Grows the buffer to `factor` times its size. `factor` must be at least 1,
+// with 1 the buffer grows by just what is needed.
+class GeometricGrowth : public GrowthPolicy {
+ public:
+  explicit GeometricGrowth(double factor) : factor_(factor) {
+    FLATBUFFERS_ASSERT(factor >= 1);
+  }
+
+  size_t Grow(size_t reserved, size_t) FLATBUFFERS_OVERRIDE {
+    // Converting a negative double to size_t is undefined, a release build
+    // without the assert grows by what is needed instead.
+    if (!(factor_ > 1)) return 0;
+    return static_cast<size_t>(static_cast<double>(reserved) * (factor_ - 1));
+  }
+
+ private:
+  double factor_;
+};
+
+// Grows the buffer by the same number of bytes every time, so that building
+// a large buffer never allocates much more than it needs.
+class FixedGrowth : public GrowthPolicy {
+ public:
+  explicit FixedGrowth(size_t increment) : increment_(increment) {}
+
+  size_t Grow(size_t, size_t) FLATBUFFERS_OVERRIDE { return increment_; }
+
+ private:
+  size_t increment_;
+};
+
 // This is a minimal replication of std::vector<uint8_t> functionality,
 // except growing from higher to lower addresses. i.e push_back() inserts data
 // in the lowest address in the vector.
 // Since this vector leaves the lower part unused, we support a "scratch-pad"
 // that can be stored there for temporary data, to share the allocated space.
 // Essentially, this supports 2 std::vectors in a single buffer.
+// With a segment size set, a full buffer isn't reallocated: what it holds
+// is kept as a segment and building continues in a new block, see
+// FlatBufferBuilder::SetSegmentSize(). Offsets into the vector (size(),
+// data_at()) count across segments.
 class vector_downward {
  public:
   explicit vector_downward(size_t initial_size, Allocator *allocator,
@@ -950,6 +1042,11 @@ class vector_downward {
         own_allocator_(own_allocator),
         initial_size_(initial_size),
         buffer_minalign_(buffer_minalign),
+        growth_policy_(nullptr),
+        segment_size_(0),
+        sealed_size_(0),
+        skew_(0),
+        stats_(nullptr),
         reserved_(0),
         buf_(nullptr),
         cur_(nullptr),
@@ -966,6 +1063,11 @@ class vector_downward {
         own_allocator_(other.own_allocator_),
         initial_size_(other.initial_size_),
         buffer_minalign_(other.buffer_minalign_),
+        growth_policy_(other.growth_policy_),
+        segment_size_(other.segment_size_),
+        sealed_size_(other.sealed_size_),
+        skew_(other.skew_),
+        stats_(other.stats_),
         reserved_(other.reserved_),
         buf_(other.buf_),
         cur_(other.cur_),
@@ -973,7 +1075,13 @@ class vector_downward {
     // No change in other.allocator_
     // No change in other.initial_size_
     // No change in other.buffer_minalign_
+    // No change in other.growth_policy_
+    // No change in other.segment_size_
+    sealed_.swap(other.sealed_);
+    other.stats_ = nullptr;
     other.own_allocator_ = false;
+    other.sealed_size_ = 0;
+    other.skew_ = 0;
     other.reserved_ = 0;
     other.buf_ = nullptr;
     other.cur_ = nullptr;
@@ -1004,6 +1112,18 @@ class vector_downward {
   }
 
   void clear() {
+    if (!sealed_.empty()) {
+      // Keep the first segment, the only one aligned for a new buffer.
+      Deallocate(allocator_, buf_, reserved_ + skew_);
+      for (size_t i = 1; i < sealed_.size(); i++) {
+        Deallocate(allocator_, sealed_[i].buf, sealed_[i].allocated);
+      }
+      buf_ = sealed_[0].buf;
+      reserved_ = sealed_[0].allocated;
+      sealed_.clear();
+      sealed_size_ = 0;
+      skew_ = 0;
+    }
     if (buf_) {
       cur_ = buf_ + reserved_;
     } else {
@@ -1022,12 +1142,19 @@ class vector_downward {
   }
 
   void clear_buffer() {
-    if (buf_) Deallocate(allocator_, buf_, reserved_);
+    if (buf_) Deallocate(allocator_, buf_, reserved_ + skew_);
     buf_ = nullptr;
+    for (size_t i = 0; i < sealed_.size(); i++) {
+      Deallocate(allocator_, sealed_[i].buf, sealed_[i].allocated);
+    }
+    sealed_.clear();
+    sealed_size_ = 0;
+    skew_ = 0;
   }
 
   // Relinquish the pointer to the caller.
   uint8_t *release_raw(size_t &allocated_bytes, size_t &offset) {
+    gather();
     auto *buf = buf_;
     allocated_bytes = reserved_;
     offset = static_cast<size_t>(cur_ - buf_);
@@ -1041,6 +1168,7 @@ class vector_downward {
 
   // Relinquish the pointer to the caller.
   DetachedBuffer release() {
+    gather();
     // allocator ownership (if any) is transferred to DetachedBuffer.
     DetachedBuffer fb(allocator_, own_allocator_, buf_, reserved_, cur_,
                       size());
@@ -1055,13 +1183,72 @@ class vector_downward {
 
   size_t ensure_space(size_t len) {
     FLATBUFFERS_ASSERT(cur_ >= scratch_ && scratch_ >= buf_);
-    if (len > static_cast<size_t>(cur_ - scratch_)) { reallocate(len); }
+    if (len > static_cast<size_t>(cur_ - scratch_)) {
+      if (segment_size_) {
+        start_segment(len);
+      } else {
+        reallocate(len);
+      }
+    }
     // Beyond this, signed offsets may not have enough range:
     // (FlatBuffers > 2GB not supported).
     FLATBUFFERS_ASSERT(size() < FLATBUFFERS_MAX_BUFFER_SIZE);
     return len;
   }
 
+  // Makes room for `len` more bytes with a single allocation of exactly
+  // that much, if there isn't enough already.
+  void reserve(size_t len) {
+    auto space = static_cast<size_t>(cur_ - scratch_);
+    if (len <= space) return;
+    if (segment_size_) {
+      start_segment(len);
+    } else {
+      resize(reserved_ + len - space);
+    }
+  }
+
+  void set_growth_policy(GrowthPolicy *policy) { growth_policy_ = policy; }
+
+  // Only while empty, 0 goes back to a single block.
+  void set_segment_size(size_t segment_size) {
+    FLATBUFFERS_ASSERT(!size());
+    segment_size_ = segment_size;
+  }
+
+  // Keeps the next `len` bytes in one segment, so they can be read back as
+  // one object. Without segments, they are anyway.
+  void ensure_contiguous(size_t len) {
+    if (segment_size_) ensure_space(len);
+  }
+
+  bool segmented() const { return !sealed_.empty(); }
+
+  void set_stats(BuilderStats *stats) { stats_ = stats; }
+  BuilderStats *stats() const { return stats_; }
+
+  // The data in order, oldest segment last.
+  std::vector<span<const uint8_t>> segments() const {
+    std::vector<span<const uint8_t>> out;
+    auto current = static_cast<size_t>(buf_ + reserved_ - cur_);
+    if (current) out.push_back(span<const uint8_t>(cur_, current));
+    for (auto it = sealed_.rbegin(); it != sealed_.rend(); ++it) {
+      out.push_back(span<const uint8_t>(it->end - it->size, it->size));
+    }
+    return out;
+  }
+
+  // Copies the data, size() bytes, to `dest`.
+  void copy_to(uint8_t *dest) const {
+    auto current = static_cast<size_t>(buf_ + reserved_ - cur_);
+    if (current) memcpy(dest, cur_, current);
+    dest += current;
+    for (auto it = sealed_.rbegin(); it != sealed_.rend(); ++it) {
+      memcpy(dest, it->end - it->size, it->size);
+      dest += it->size;
+    }
+  }
+
   inline uint8_t *make_space(size_t len) {
     size_t space = ensure_space(len);
     cur_ -= space;
@@ -1072,7 +1259,8 @@ class vector_downward {
   Allocator *get_custom_allocator() { return allocator_; }
 
   uoffset_t size() const {
-    return static_cast<uoffset_t>(reserved_ - static_cast<size_t>(cur_ - buf_));
+    return static_cast<uoffset_t>(sealed_size_ + reserved_ -
+                                  static_cast<size_t>(cur_ - buf_));
   }
 
   uoffset_t scratch_size() const {
@@ -1096,7 +1284,22 @@ class vector_downward {
     return scratch_;
   }
 
-  uint8_t *data_at(size_t offset) const { return buf_ + reserved_ - offset; }
+  uint8_t *data_at(size_t offset) const {
+    if (offset > sealed_size_ || sealed_.empty()) {
+      return buf_ + reserved_ - (offset - sealed_size_);
+    }
+    // The last segment that starts below `offset`.
+    size_t lo = 0, hi = sealed_.size();
+    while (hi - lo > 1) {
+      auto mid = (lo + hi) / 2;
+      if (sealed_[mid].base < offset) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    return sealed_[lo].end - (offset - sealed_[lo].base);
+  }
 
   void push(const uint8_t *bytes, size_t num) {
     if (num > 0) { memcpy(make_space(num), bytes, num); }
@@ -1112,6 +1315,15 @@ class vector_downward {
     ensure_space(sizeof(T));
     *reinterpret_cast<T *>(scratch_) = t;
     scratch_ += sizeof(T);
+    // clang-format off
+    #ifdef FLATBUFFERS_BUILDER_STATS
+      if (stats_) {
+        stats_->max_scratch_bytes =
+            (std::max)(stats_->max_scratch_bytes,
+                       static_cast<size_t>(scratch_size()));
+      }
+    #endif
+    // clang-format on
   }
 
   // fill() is most frequently called with small byte counts (<= 4),
@@ -1127,7 +1339,11 @@ class vector_downward {
     memset(make_space(zero_pad_bytes), 0, zero_pad_bytes);
   }
 
-  void pop(size_t bytes_to_remove) { cur_ += bytes_to_remove; }
+  void pop(size_t bytes_to_remove) {
+    FLATBUFFERS_ASSERT(bytes_to_remove <=
+                       static_cast<size_t>(buf_ + reserved_ - cur_));
+    cur_ += bytes_to_remove;
+  }
   void scratch_pop(size_t bytes_to_remove) { scratch_ -= bytes_to_remove; }
 
   void swap(vector_downward &other) {
@@ -1136,6 +1352,12 @@ class vector_downward {
     swap(own_allocator_, other.own_allocator_);
     swap(initial_size_, other.initial_size_);
     swap(buffer_minalign_, other.buffer_minalign_);
+    swap(growth_policy_, other.growth_policy_);
+    swap(segment_size_, other.segment_size_);
+    swap(sealed_, other.sealed_);
+    swap(sealed_size_, other.sealed_size_);
+    swap(skew_, other.skew_);
+    swap(stats_, other.stats_);
     swap(reserved_, other.reserved_);
     swap(buf_, other.buf_);
     swap(cur_, other.cur_);
@@ -1157,18 +1379,99 @@ class vector_downward {
   bool own_allocator_;
   size_t initial_size_;
   size_t buffer_minalign_;
+  GrowthPolicy *growth_policy_;
+  size_t segment_size_;  // 0 if not segmented.
+  // Full blocks, oldest first, and their bytes in total.
+  struct Segment {
+    uint8_t *buf;
+    size_t allocated;
+    uint8_t *end;  // Of the data, which is `size` bytes below it.
+    size_t size;
+    size_t base;  // size() when the segment was started.
+  };
+  std::vector<Segment> sealed_;
+  size_t sealed_size_;
+  // Bytes unused at the end of the current block, which align it like a
+  // single block would be. reserved_ excludes them.
+  size_t skew_;
+  // Only used with FLATBUFFERS_BUILDER_STATS, but always there so that the
+  // layout doesn't depend on it.
+  BuilderStats *stats_;
   size_t reserved_;
   uint8_t *buf_;
   uint8_t *cur_;  // Points at location between empty (below) and used (above).
   uint8_t *scratch_;  // Points to the end of the scratchpad in use.
 
   void reallocate(size_t len) {
+    auto grow = reserved_ ? reserved_ / 2 : initial_size_;
+    if (reserved_ && growth_policy_) {
+      grow = growth_policy_->Grow(reserved_, len);
+    }
+    resize(reserved_ + (std::max)(len, grow));
+  }
+
+  // Keeps the current block as a segment, and continues in a new block with
+  // room for `len` bytes and the scratchpad, which moves along.
+  void start_segment(size_t len) {
+    auto base = size();
+    auto used = static_cast<size_t>(buf_ + reserved_ - cur_);
+    auto scratch = scratch_size();
+    // Addresses in the new block need the alignment of their offset.
+    auto skew = base & (buffer_minalign_ - 1);
+    auto allocated = (std::max)(segment_size_, len + scratch + skew);
+    allocated = (allocated + buffer_minalign_ - 1) & ~(buffer_minalign_ - 1);
+    auto buf = Allocate(allocator_, allocated);
+    if (scratch) memcpy(buf, buf_, scratch);
+    // clang-format off
+    #ifdef FLATBUFFERS_BUILDER_STATS
+      if (stats_) {
+        stats_->allocations++;
+        stats_->bytes_copied += scratch;
+      }
+    #endif
+    // clang-format on
+    if (used) {
+      Segment segment = { buf_, reserved_ + skew_, buf_ + reserved_, used,
+                          sealed_size_ };
+      sealed_.push_back(segment);
+      sealed_size_ += used;
+    } else if (buf_) {
+      Deallocate(allocator_, buf_, reserved_ + skew_);
+    }
+    buf_ = buf;
+    skew_ = skew;
+    reserved_ = allocated - skew;
+    cur_ = buf_ + reserved_;
+    scratch_ = buf_ + scratch;
+  }
+
+  // Copies all segments into one block.
+  void gather() {
+    if (sealed_.empty()) return;
+    auto len = size();
+    auto allocated = (len + buffer_minalign_ - 1) & ~(buffer_minalign_ - 1);
+    auto buf = Allocate(allocator_, allocated);
+    copy_to(buf + allocated - len);
+    // clang-format off
+    #ifdef FLATBUFFERS_BUILDER_STATS
+      if (stats_) {
+        stats_->allocations++;
+        stats_->bytes_copied += len;
+      }
+    #endif
+    // clang-format on
+    clear_buffer();
+    buf_ = buf;
+    reserved_ = allocated;
+    cur_ = buf_ + reserved_ - len;
+    scratch_ = buf_;
+  }
+
+  void resize(size_t reserved) {
     auto old_reserved = reserved_;
     auto old_size = size();
     auto old_scratch_size = scratch_size();
-    reserved_ +=
-        (std::max)(len, old_reserved ? old_reserved / 2 : initial_size_);
-    reserved_ = (reserved_ + buffer_minalign_ - 1) & ~(buffer_minalign_ - 1);
+    reserved_ = (reserved + buffer_minalign_ - 1) & ~(buffer_minalign_ - 1);
     if (buf_) {
       buf_ = ReallocateDownward(allocator_, buf_, old_reserved, reserved_,
                                 old_size, old_scratch_size);
@@ -1177,6 +1480,17 @@ class vector_downward {
     }
     cur_ = buf_ + reserved_ - old_size;
     scratch_ = buf_ + old_scratch_size;
+    // clang-format off
+    #ifdef FLATBUFFERS_BUILDER_STATS
+      if (stats_) {
+        stats_->allocations++;
+        if (old_reserved) {
+          stats_->reallocations++;
+          stats_->bytes_copied += old_size + old_scratch_size;
+        }
+      }
+    #endif
+    // clang-format on
   }
 };
 
@@ -1203,6 +1517,18 @@ template<typename T, typename Alloc> T *data(std::vector<T, Alloc> &v) {
 
 /// @endcond
 
+class StringDictionary;
+
+/// @brief A string of a StringDictionary (see string_dictionary.h), which
+/// keeps it unchanged for as long as the dictionary lives.
+struct InternedString {
+  const char *data;
+  size_t size;
+  uint32_t hash;  // HashStringBytes(data, size).
+  uint32_t id;    // Numbers the strings of a dictionary from 0.
+  const StringDictionary *dictionary;
+};
+
 /// @addtogroup flatbuffers_cpp_api
 /// @{
 /// @class FlatBufferBuilder
@@ -1237,7 +1563,8 @@ class FlatBufferBuilder {
         minalign_(1),
         force_defaults_(false),
         dedup_vtables_(true),
-        string_pool(nullptr) {
+        string_pool(nullptr),
+        string_dictionary_(nullptr) {
     EndianCheck();
   }
 
@@ -1256,7 +1583,8 @@ class FlatBufferBuilder {
       minalign_(1),
       force_defaults_(false),
       dedup_vtables_(true),
-      string_pool(nullptr) {
+      string_pool(nullptr),
+      string_dictionary_(nullptr) {
     EndianCheck();
     // Default construct and swap idiom.
     // Lack of delegating constructors in vs2010 makes it more verbose than needed.
@@ -1289,6 +1617,9 @@ class FlatBufferBuilder {
     swap(force_defaults_, other.force_defaults_);
     swap(dedup_vtables_, other.dedup_vtables_);
     swap(string_pool, other.string_pool);
+    swap(string_dictionary_, other.string_dictionary_);
+    interned_offsets_.swap(other.interned_offsets_);
+    interned_used_.swap(other.interned_used_);
   }
 
   ~FlatBufferBuilder() {
@@ -1309,6 +1640,7 @@ class FlatBufferBuilder {
     finished = false;
     minalign_ = 1;
     if (string_pool) string_pool->clear();
+    ClearInterned();
   }
 
   /// @brief The current size of the serialized buffer, counting from the end.
@@ -1320,6 +1652,8 @@ class FlatBufferBuilder {
   /// buffer.
   uint8_t *GetBufferPointer() const {
     Finished();
+    // A buffer in several segments needs GetBufferSegments() or Release().
+    FLATBUFFERS_ASSERT(!buf_.segmented());
     return buf_.data();
   }
 
@@ -1328,6 +1662,7 @@ class FlatBufferBuilder {
   /// FlatBuffer data inside the buffer.
   flatbuffers::span<uint8_t> GetBufferSpan() const {
     Finished();
+    FLATBUFFERS_ASSERT(!buf_.segmented());
     return flatbuffers::span<uint8_t>(buf_.data(), buf_.size());
   }
 
@@ -1345,7 +1680,25 @@ class FlatBufferBuilder {
     return buf_.release();
   }
 
-  /// @brief Get the released DetachedBuffer.
+  /// @brief Get the serialized buffer (after you call `Finish()`) as the
+  /// segments it was built in, see SetSegmentSize().
+  /// @return The spans that make up the buffer when concatenated in order,
+  /// e.g. for `writev()`. Without segments, there is just one.
+  std::vector<flatbuffers::span<const uint8_t>> GetBufferSegments() const {
+    Finished();
+    return buf_.segments();
+  }
+
+  /// @brief Copy the serialized buffer (after you call `Finish()`) whether
+  /// it was built in segments or not.
+  /// @param[out] dest Where to write GetSize() bytes to.
+  void CopyBufferTo(uint8_t *dest) const {
+    Finished();
+    buf_.copy_to(dest);
+  }
+
+  /// @brief Get the released DetachedBuffer. A buffer built in segments is
+  /// copied into one block first.
   /// @return A `DetachedBuffer` that owns the buffer and its allocator.
   DetachedBuffer Release() {
     Finished();
@@ -1398,8 +1751,75 @@ class FlatBufferBuilder {
   /// @param[in] dedup When set to `true`, dedup vtables.
   void DedupVtables(bool dedup) { dedup_vtables_ = dedup; }
 
+  /// @brief Changes how the buffer grows once it is full. By default it grows
+  /// by half of its size.
+  /// @param[in] policy The policy to use, or `nullptr` for the default. It is
+  /// not owned by the builder.
+  void SetGrowthPolicy(GrowthPolicy *policy) {
+    buf_.set_growth_policy(policy);
+  }
+
+  /// @brief Makes room for `len` more bytes and what Finish() adds, so that
+  /// building that much doesn't reallocate the buffer. With the upper bound
+  /// generated by `flatc --gen-packed-size`, Pack() allocates just once:
+  /// `fbb.Reserve(Monster::PackedSizeUpperBound(monster_t))`.
+  /// @param[in] len Bytes of tables, vectors and strings still to be added,
+  /// plus the scratch space used while building them.
+  void Reserve(size_t len) {
+    buf_.reserve(len + 3 * sizeof(uoffset_t) + FLATBUFFERS_MAX_ALIGNMENT);
+  }
+
+  /// @brief Attaches a StringDictionary, whose strings can then be added with
+  /// CreateSharedString(const InternedString &). It must outlive the builder,
+  /// or be replaced before the builder is used again.
+  void SetStringDictionary(const StringDictionary *dictionary) {
+    ClearInterned();
+    interned_offsets_.clear();
+    string_dictionary_ = dictionary;
+  }
+
+  /// @brief Collects statistics of what the builder does from now on into
+  /// `stats`, until SetStats(nullptr). They aren't reset first, so one
+  /// BuilderStats can count several buffers.
+  /// @return `false` if statistics are compiled out, see BuilderStats.
+  bool SetStats(BuilderStats *stats) {
+    // clang-format off
+    #ifdef FLATBUFFERS_BUILDER_STATS
+      buf_.set_stats(stats);
+      return true;
+    #else
+      (void)stats;
+      return false;
+    #endif
+    // clang-format on
+  }
+
+  /// @brief Builds into a chain of blocks of at least `segment_size` bytes
+  /// instead of a single block, which is reallocated and copied as it grows.
+  /// Full blocks are kept as they are, so building a large buffer copies
+  /// nothing and needs little more memory than the buffer itself. Get the
+  /// result with GetBufferSegments(), CopyBufferTo() or, as one block copied
+  /// from the segments, Release().
+  ///
+  /// Strings and vectors are kept within a segment; tables may span two.
+  /// That doesn't matter for offsets, but GetBufferPointer(),
+  /// GetTemporaryPointer() and CreateVectorOfSortedTables() need a single
+  /// segment.
+  /// @param[in] segment_size The size of each new block, or 0 to go back to
+  /// a single block. Only while the builder is empty.
+  void SetSegmentSize(size_t segment_size) {
+    buf_.set_segment_size(segment_size);
+  }
+
   /// @cond FLATBUFFERS_INTERNAL
-  void Pad(size_t num_bytes) { buf_.fill(num_bytes); }
+  void Pad(size_t num_bytes) { FillPadding(num_bytes); }
+
+  // Where an object being built starts, see GetTemporaryPointer().
+  uint8_t *GetTemporaryAddress(uoffset_t offset) const {
+    // Tables may span two segments, so there's no pointer to all of them.
+    FLATBUFFERS_ASSERT(!buf_.segmented());
+    return buf_.data_at(offset);
+  }
 
   void TrackMinAlign(size_t elem_size) {
     if (elem_size > minalign_) minalign_ = elem_size;
@@ -1407,7 +1827,16 @@ class FlatBufferBuilder {
 
   void Align(size_t elem_size) {
     TrackMinAlign(elem_size);
-    buf_.fill(PaddingBytes(buf_.size(), elem_size));
+    FillPadding(PaddingBytes(buf_.size(), elem_size));
+  }
+
+  void FillPadding(size_t num_bytes) {
+    buf_.fill(num_bytes);
+    // clang-format off
+    #ifdef FLATBUFFERS_BUILDER_STATS
+      if (buf_.stats()) buf_.stats()->padding_bytes += num_bytes;
+    #endif
+    // clang-format on
   }
 
   void PushFlatBuffer(const uint8_t *bytes, size_t size) {
@@ -1560,6 +1989,18 @@ class FlatBufferBuilder {
         break;
       }
     }
+    // clang-format off
+    #ifdef FLATBUFFERS_BUILDER_STATS
+      if (buf_.stats()) {
+        if (vt_use == GetSize()) {
+          buf_.stats()->vtables_written++;
+        } else {
+          buf_.stats()->vtables_deduped++;
+          buf_.stats()->vtable_bytes_saved += vt1_size;
+        }
+      }
+    #endif
+    // clang-format on
     // If this is a new vtable, remember it.
     if (vt_use == GetSize()) { buf_.scratch_push_small(vt_use); }
     // Fill the vtable offset we created above.
@@ -1601,7 +2042,7 @@ class FlatBufferBuilder {
   // after it with "alignment" without padding.
   void PreAlign(size_t len, size_t alignment) {
     TrackMinAlign(alignment);
-    buf_.fill(PaddingBytes(GetSize() + len, alignment));
+    FillPadding(PaddingBytes(GetSize() + len, alignment));
   }
   template<typename T> void PreAlign(size_t len) {
     AssertScalarT<T>();
@@ -1615,6 +2056,8 @@ class FlatBufferBuilder {
   /// @return Returns the offset in the buffer where the string starts.
   Offset<String> CreateString(const char *str, size_t len) {
     NotNested();
+    // With its padding and length.
+    buf_.ensure_contiguous(len + 1 + 2 * sizeof(uoffset_t));
     PreAlign<uoffset_t>(len + 1);  // Always 0-terminated.
     buf_.fill(1);
     PushBytes(reinterpret_cast<const uint8_t *>(str), len);
@@ -1671,36 +2114,44 @@ class FlatBufferBuilder {
 
   /// @brief Store a string in the buffer, which can contain any binary data.
   /// If a string with this exact contents has already been serialized before,
-  /// instead simply returns the offset of the existing string. This uses a map
-  /// stored on the heap, but only stores the numerical offsets.
+  /// instead simply returns the offset of the existing string. This uses a hash
+  /// table stored on the heap, but only stores the numerical offsets.
   /// @param[in] str A const char pointer to the data to be stored as a string.
   /// @param[in] len The number of bytes that should be stored from `str`.
   /// @return Returns the offset in the buffer where the string starts.
   Offset<String> CreateSharedString(const char *str, size_t len) {
-    FLATBUFFERS_ASSERT(FLATBUFFERS_GENERAL_HEAP_ALLOC_OK);
-    if (!string_pool)
-      string_pool = new StringOffsetMap(StringOffsetCompare(buf_));
-    auto size_before_string = buf_.size();
-    // Must first serialize the string, since the set is all offsets into
-    // buffer.
-    auto off = CreateString(str, len);
-    auto it = string_pool->find(off);
-    // If it exists we reuse existing serialized data!
-    if (it != string_pool->end()) {
-      // We can remove the string we serialized.
-      buf_.pop(buf_.size() - size_before_string);
-      return *it;
+    return CreateSharedString(str, len, HashStringBytes(str, len));
+  }
+
+  /// @brief Store a string of the attached StringDictionary in the buffer,
+  /// or return the offset of where it was stored before. Strings added here
+  /// are shared with those of the other CreateSharedString() overloads.
+  /// Repeating a string only costs a lookup by its id, it isn't hashed or
+  /// compared again.
+  /// @param[in] str A string of the dictionary set by SetStringDictionary().
+  /// @return Returns the offset in the buffer where the string starts.
+  Offset<String> CreateSharedString(const InternedString &str) {
+    FLATBUFFERS_ASSERT(str.dictionary && str.dictionary == string_dictionary_);
+    if (str.id >= interned_offsets_.size()) {
+      interned_offsets_.resize(str.id + 1, 0);
     }
-    // Record this string for future use.
-    string_pool->insert(off);
-    return off;
+    auto off = interned_offsets_[str.id];
+    if (off) {
+      NotNested();
+      CountSharedStringHit(str.size);
+      return Offset<String>(off);
+    }
+    off = CreateSharedString(str.data, str.size, str.hash).o;
+    interned_offsets_[str.id] = off;
+    interned_used_.push_back(str.id);
+    return Offset<String>(off);
   }
 
 #ifdef FLATBUFFERS_HAS_STRING_VIEW
   /// @brief Store a string in the buffer, which can contain any binary data.
   /// If a string with this exact contents has already been serialized before,
-  /// instead simply returns the offset of the existing string. This uses a map
-  /// stored on the heap, but only stores the numerical offsets.
+  /// instead simply returns the offset of the existing string. This uses a hash
+  /// table stored on the heap, but only stores the numerical offsets.
   /// @param[in] str A const std::string_view to store in the buffer.
   /// @return Returns the offset in the buffer where the string starts
   Offset<String> CreateSharedString(const flatbuffers::string_view str) {
@@ -1709,8 +2160,8 @@ class FlatBufferBuilder {
 #else
   /// @brief Store a string in the buffer, which null-terminated.
   /// If a string with this exact contents has already been serialized before,
-  /// instead simply returns the offset of the existing string. This uses a map
-  /// stored on the heap, but only stores the numerical offsets.
+  /// instead simply returns the offset of the existing string. This uses a hash
+  /// table stored on the heap, but only stores the numerical offsets.
   /// @param[in] str A const char pointer to a C-string to add to the buffer.
   /// @return Returns the offset in the buffer where the string starts.
   Offset<String> CreateSharedString(const char *str) {
@@ -1719,8 +2170,8 @@ class FlatBufferBuilder {
 
   /// @brief Store a string in the buffer, which can contain any binary data.
   /// If a string with this exact contents has already been serialized before,
-  /// instead simply returns the offset of the existing string. This uses a map
-  /// stored on the heap, but only stores the numerical offsets.
+  /// instead simply returns the offset of the existing string. This uses a hash
+  /// table stored on the heap, but only stores the numerical offsets.
   /// @param[in] str A const reference to a std::string to store in the buffer.
   /// @return Returns the offset in the buffer where the string starts.
   Offset<String> CreateSharedString(const std::string &str) {
@@ -1730,8 +2181,8 @@ class FlatBufferBuilder {
 
   /// @brief Store a string in the buffer, which can contain any binary data.
   /// If a string with this exact contents has already been serialized before,
-  /// instead simply returns the offset of the existing string. This uses a map
-  /// stored on the heap, but only stores the numerical offsets.
+  /// instead simply returns the offset of the existing string. This uses a hash
+  /// table stored on the heap, but only stores the numerical offsets.
   /// @param[in] str A const pointer to a `String` struct to add to the buffer.
   /// @return Returns the offset in the buffer where the string starts
   Offset<String> CreateSharedString(const String *str) {
@@ -1739,6 +2190,54 @@ class FlatBufferBuilder {
   }
 
   /// @cond FLATBUFFERS_INTERNAL
+  // CreateSharedString() of a string with a known HashStringBytes().
+  Offset<String> CreateSharedString(const char *str, size_t len,
+                                    uint32_t hash) {
+    FLATBUFFERS_ASSERT(FLATBUFFERS_GENERAL_HEAP_ALLOC_OK);
+    NotNested();
+    if (!string_pool) string_pool = new StringOffsetPool();
+    // Look the string up before serializing it, so a string seen before
+    // costs a compare.
+    size_t existing;
+    if (string_pool->Find(hash, len, SharedStringEquals(buf_, str, len),
+                          &existing)) {
+      CountSharedStringHit(len);
+      return Offset<String>(static_cast<uoffset_t>(existing));
+    }
+    // clang-format off
+    #ifdef FLATBUFFERS_BUILDER_STATS
+      if (buf_.stats()) buf_.stats()->shared_string_misses++;
+    #endif
+    // clang-format on
+    auto off = CreateString(str, len);
+    // Record this string for future use.
+    string_pool->Insert(hash, len, off.o);
+    return off;
+  }
+
+  void CountSharedStringHit(size_t len) {
+    // clang-format off
+    #ifdef FLATBUFFERS_BUILDER_STATS
+      if (buf_.stats()) {
+        buf_.stats()->shared_string_hits++;
+        buf_.stats()->shared_string_bytes_saved +=
+            PaddingBytes(GetSize() + len + 1, sizeof(uoffset_t)) + len + 1 +
+            sizeof(uoffset_t);
+      }
+    #else
+      (void)len;
+    #endif
+    // clang-format on
+  }
+
+  // Forgets where the strings of the dictionary are, for a new buffer.
+  void ClearInterned() {
+    for (auto it = interned_used_.begin(); it != interned_used_.end(); ++it) {
+      interned_offsets_[*it] = 0;
+    }
+    interned_used_.clear();
+  }
+
   uoffset_t EndVector(size_t len) {
     FLATBUFFERS_ASSERT(nested);  // Hit if no corresponding StartVector.
     nested = false;
@@ -1748,6 +2247,7 @@ class FlatBufferBuilder {
   void StartVector(size_t len, size_t elemsize) {
     NotNested();
     nested = true;
+    buf_.ensure_contiguous((len + 1) * elemsize + 2 * sizeof(uoffset_t));
     PreAlign<uoffset_t>(len * elemsize);
     PreAlign(len * elemsize, elemsize);  // Just in case elemsize > uoffset_t.
   }
@@ -2131,6 +2631,8 @@ class FlatBufferBuilder {
   template<typename T>
   Offset<Vector<Offset<T>>> CreateVectorOfSortedTables(Offset<T> *v,
                                                        size_t len) {
+    // The comparator reads tables directly, see SetSegmentSize().
+    FLATBUFFERS_ASSERT(!buf_.segmented());
     std::sort(v, v + len, TableKeyComparator<T>(buf_));
     return CreateVector(v, len);
   }
@@ -2284,20 +2786,28 @@ class FlatBufferBuilder {
 
   bool dedup_vtables_;
 
-  struct StringOffsetCompare {
-    StringOffsetCompare(const vector_downward &buf) : buf_(&buf) {}
-    bool operator()(const Offset<String> &a, const Offset<String> &b) const {
-      auto stra = reinterpret_cast<const String *>(buf_->data_at(a.o));
-      auto strb = reinterpret_cast<const String *>(buf_->data_at(b.o));
-      return StringLessThan(stra->data(), stra->size(), strb->data(),
-                            strb->size());
+  // Compares a string in the buffer, of the length looked up, with `str_`.
+  struct SharedStringEquals {
+    SharedStringEquals(const vector_downward &buf, const char *str, size_t len)
+        : buf_(&buf), str_(str), len_(len) {}
+    bool operator()(size_t off) const {
+      auto data = buf_->data_at(off) + sizeof(uoffset_t);
+      return memcmp(data, str_, len_) == 0;
     }
     const vector_downward *buf_;
+    const char *str_;
+    size_t len_;
   };
 
   // For use with CreateSharedString. Instantiated on first use only.
-  typedef std::set<Offset<String>, StringOffsetCompare> StringOffsetMap;
-  StringOffsetMap *string_pool;
+  StringOffsetPool *string_pool;
+
+  // For CreateSharedString(const InternedString &): the offsets of the
+  // strings of the dictionary by their ids, 0 if not in this buffer yet, and
+  // the ids with an offset.
+  const StringDictionary *string_dictionary_;
+  std::vector<uoffset_t> interned_offsets_;
+  std::vector<uint32_t> interned_used_;
 
  private:
   // Allocates space for a vector of structures.
@@ -2335,11 +2845,11 @@ template<typename T> const T *GetSizePrefixedRoot(const void *buf) {
 
 /// Helpers to get a typed pointer to objects that are currently being built.
 /// @warning Creating new objects will lead to reallocations and invalidates
-/// the pointer!
+/// the pointer! Not available while building in segments, see
+/// FlatBufferBuilder::SetSegmentSize().
 template<typename T>
 T *GetMutableTemporaryPointer(FlatBufferBuilder &fbb, Offset<T> offset) {
-  return reinterpret_cast<T *>(fbb.GetCurrentBufferPointer() + fbb.GetSize() -
-                               offset.o);
+  return reinterpret_cast<T *>(fbb.GetTemporaryAddress(offset.o));
 }
 
 template<typename T>
@@ -2367,6 +2877,106 @@ inline bool BufferHasIdentifier(const void *buf, const char *identifier,
                  FlatBufferBuilder::kFileIdentifierLength) == 0;
 }
 
+// Whether `s` is well-formed UTF-8 (RFC 3629): no overlong encodings,
+// surrogates or code points past U+10FFFF. Runs of ASCII, the common case,
+// are skipped 8 bytes at a time.
+inline bool IsValidUtf8(const char *s, size_t len) {
+  auto p = reinterpret_cast<const uint8_t *>(s);
+  auto end = p + len;
+  while (p != end) {
+    if (*p < 0x80) {
+      for (; end - p >= 8; p += 8) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        if (word & 0x8080808080808080ULL) break;
+      }
+      while (p != end && *p < 0x80) p++;
+      continue;
+    }
+    // The number of continuation bytes, and the range of the first of them,
+    // which rules out overlong encodings, surrogates and values too large.
+    auto c = *p;
+    size_t n = 0;
+    uint8_t lo = 0x80, hi = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF) {
+      n = 1;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+      n = 2;
+      if (c == 0xE0) lo = 0xA0;
+      if (c == 0xED) hi = 0x9F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+      n = 3;
+      if (c == 0xF0) lo = 0x90;
+      if (c == 0xF4) hi = 0x8F;
+    } else {
+      return false;
+    }
+    if (static_cast<size_t>(end - p) <= n || p[1] < lo || p[1] > hi) {
+      return false;
+    }
+    for (size_t i = 2; i <= n; i++) {
+      if ((p[i] & 0xC0) != 0x80) return false;
+    }
+    p += n + 1;
+  }
+  return true;
+}
+
+// Runs independent tasks concurrently, for Verifier::SetParallel(). See
+// ThreadPool in thread_pool.h for an implementation on std::thread.
+class ParallelRunner {
+ public:
+  virtual ~ParallelRunner() {}
+
+  // The number of tasks that can run at the same time.
+  virtual int Concurrency() const = 0;
+
+  // Calls task(context, i) for all i in [0, count), and returns once all of
+  // them have returned.
+  virtual void Run(size_t count, void (*task)(void *context, size_t index),
+                   void *context) = 0;
+};
+
+// What a Verifier did, to find out why a buffer is slow to verify or got
+// rejected. Filled in by a Verifier given to Verifier::SetStats(), which only
+// does so when compiled with FLATBUFFERS_VERIFIER_STATS. Without it none of
+// the bookkeeping is compiled in (the Verifier keeps the same layout either
+// way), and with it a Verifier without stats costs a pointer check per range,
+// so sampling a fraction of buffers is cheap.
+// Nested flatbuffers are verified by a Verifier of their own, and are not
+// counted.
+struct VerifierStats {
+  struct PathEntry {
+    size_t table;     // Offset of the table in the buffer.
+    voffset_t field;  // Its field being verified, as a vtable offset, or 0.
+  };
+
+  size_t tables;
+  size_t vectors;  // Including vectors of strings, but not strings.
+  size_t strings;
+  size_t bytes_checked;  // Total size of the ranges checked, with overlaps.
+  size_t max_depth;
+  bool failed;
+  // Where the first failure was found: the start of the last range checked,
+  // and the tables and their fields leading to it, from the root down.
+  // VerifierFailurePath() in minireflect.h turns these into field names.
+  size_t failure_offset;
+  std::vector<PathEntry> failure_path;
+  // The tables currently being verified, by depth.
+  std::vector<PathEntry> path;
+
+  VerifierStats() { Reset(); }
+
+  // Keeps the capacity of the vectors, so reusing stats doesn't allocate.
+  void Reset() {
+    tables = vectors = strings = bytes_checked = max_depth = 0;
+    failed = false;
+    failure_offset = 0;
+    failure_path.clear();
+    path.clear();
+  }
+};
+
 // Helper class to verify the integrity of a FlatBuffer
 class Verifier FLATBUFFERS_FINAL_CLASS {
  public:
@@ -2379,10 +2989,46 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
         num_tables_(0),
         max_tables_(_max_tables),
         upper_bound_(0),
-        check_alignment_(_check_alignment) {
+        check_alignment_(_check_alignment),
+        check_utf8_(false),
+        runner_(nullptr),
+        parallel_min_elements_(0),
+        stats_(nullptr),
+        checked_offset_(0) {
     FLATBUFFERS_ASSERT(size_ < FLATBUFFERS_MAX_BUFFER_SIZE);
   }
 
+  // Collects statistics of the following verification into `stats` (which
+  // is reset first), or stops collecting them if null. Returns false if
+  // statistics are compiled out, see VerifierStats.
+  bool SetStats(VerifierStats *stats) {
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_STATS
+      stats_ = stats;
+      if (stats) stats->Reset();
+      return true;
+    #else
+      (void)stats;
+      return false;
+    #endif
+    // clang-format on
+  }
+
+  // Also checks that strings are valid UTF-8 (see IsValidUtf8), which
+  // FlatBuffers requires but doesn't check by default.
+  void SetCheckUtf8(bool check_utf8) { check_utf8_ = check_utf8; }
+
+  // Verifies vectors of at least `min_elements` tables in chunks on `runner`,
+  // which is used for the duration of the verification. Each chunk gets a
+  // Verifier of its own, whose table counts are added to this one after, so
+  // the result is the same as when verifying serially. Tables nested in a
+  // chunk are verified serially. A null runner turns this off again.
+  void SetParallel(ParallelRunner *runner, uoffset_t min_elements = 4096) {
+    runner_ = runner;
+    parallel_min_elements_ =
+        (std::max)(min_elements, static_cast<uoffset_t>(2));
+  }
+
   // Central location where any verification failures register.
   bool Check(bool ok) const {
     // clang-format off
@@ -2393,6 +3039,16 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
       if (!ok)
         upper_bound_ = 0;
     #endif
+    #ifdef FLATBUFFERS_VERIFIER_STATS
+      if (!ok && stats_ && !stats_->failed) {
+        stats_->failed = true;
+        stats_->failure_offset = checked_offset_;
+        auto depth = (std::min)(static_cast<size_t>(depth_),
+                                stats_->path.size());
+        stats_->failure_path.assign(stats_->path.begin(),
+                                    stats_->path.begin() + depth);
+      }
+    #endif
     // clang-format on
     return ok;
   }
@@ -2405,6 +3061,12 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
       if (upper_bound_ < upper_bound)
         upper_bound_ =  upper_bound;
     #endif
+    #ifdef FLATBUFFERS_VERIFIER_STATS
+      if (stats_) {
+        stats_->bytes_checked += elem_len;
+        checked_offset_ = elem;
+      }
+    #endif
     // clang-format on
     return Check(elem_len < size_ && elem <= size_ - elem_len);
   }
@@ -2451,43 +3113,83 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
 
   // Verify a pointer (may be NULL) to string.
   bool VerifyString(const String *str) const {
+    if (!str) return true;
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_STATS
+      if (stats_) stats_->strings++;
+    #endif
+    // clang-format on
     size_t end;
-    return !str || (VerifyVectorOrString(reinterpret_cast<const uint8_t *>(str),
-                                         1, &end) &&
-                    Verify(end, 1) &&           // Must have terminator
-                    Check(buf_[end] == '\0'));  // Terminating byte must be 0.
+    return VerifyVectorOrStringImpl(reinterpret_cast<const uint8_t *>(str), 1,
+                                    &end) &&
+           Verify(end, 1) &&           // Must have terminator
+           Check(buf_[end] == '\0') &&  // Terminating byte must be 0.
+           (!check_utf8_ || Check(IsValidUtf8(str->c_str(), str->size())));
   }
 
   // Common code between vectors and strings.
   bool VerifyVectorOrString(const uint8_t *vec, size_t elem_size,
                             size_t *end = nullptr) const {
-    auto veco = static_cast<size_t>(vec - buf_);
-    // Check we can read the size field.
-    if (!Verify<uoffset_t>(veco)) return false;
-    // Check the whole array. If this is a string, the byte past the array
-    // must be 0.
-    auto size = ReadScalar<uoffset_t>(vec);
-    auto max_elems = FLATBUFFERS_MAX_BUFFER_SIZE / elem_size;
-    if (!Check(size < max_elems))
-      return false;  // Protect against byte_size overflowing.
-    auto byte_size = sizeof(size) + elem_size * size;
-    if (end) *end = veco + byte_size;
-    return Verify(veco, byte_size);
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_STATS
+      if (stats_) stats_->vectors++;
+    #endif
+    // clang-format on
+    return VerifyVectorOrStringImpl(vec, elem_size, end);
   }
 
   // Special case for string contents, after the above has been called.
+  // The checks of VerifyString() are done in one go per string here. A
+  // string failing them is passed to VerifyString(), to fail the same way.
   bool VerifyVectorOfStrings(const Vector<Offset<String>> *vec) const {
-    if (vec) {
-      for (uoffset_t i = 0; i < vec->size(); i++) {
-        if (!VerifyString(vec->Get(i))) return false;
+    if (!vec) return true;
+    const auto elems = static_cast<size_t>(vec->Data() - buf_);
+    const size_t count = vec->size();
+    size_t max_end = 0;
+    for (size_t i = 0; i < count; i++) {
+      const auto elem = elems + i * sizeof(uoffset_t);
+      const auto veco = elem + ReadScalar<uoffset_t>(buf_ + elem);
+      // Room for the size, the characters and the terminator.
+      size_t size = 0;
+      auto ok = ((veco & (sizeof(uoffset_t) - 1)) == 0 || !check_alignment_) &&
+                size_ > sizeof(uoffset_t) && veco <= size_ - sizeof(uoffset_t);
+      if (ok) {
+        size = ReadScalar<uoffset_t>(buf_ + veco);
+        ok = size < FLATBUFFERS_MAX_BUFFER_SIZE &&
+             size < size_ - sizeof(uoffset_t) - veco &&
+             buf_[veco + sizeof(uoffset_t) + size] == '\0' &&
+             (!check_utf8_ ||
+              IsValidUtf8(reinterpret_cast<const char *>(buf_) + veco +
+                              sizeof(uoffset_t),
+                          size));
       }
+      if (!ok) {
+        if (!VerifyString(vec->Get(static_cast<uoffset_t>(i)))) return false;
+        continue;
+      }
+      const auto end = veco + sizeof(uoffset_t) + size;
+      max_end = (std::max)(max_end, end + 1);
+      // clang-format off
+      #ifdef FLATBUFFERS_VERIFIER_STATS
+        if (stats_) {
+          // As counted by the three ranges VerifyString() checks.
+          stats_->strings++;
+          stats_->bytes_checked += 2 * sizeof(uoffset_t) + size + 1;
+          checked_offset_ = end;
+        }
+      #endif
+      // clang-format on
     }
+    upper_bound_ = (std::max)(upper_bound_, max_end);
     return true;
   }
 
   // Special case for table contents, after the above has been called.
   template<typename T> bool VerifyVectorOfTables(const Vector<Offset<T>> *vec) {
     if (vec) {
+      if (runner_ && vec->size() >= parallel_min_elements_) {
+        return VerifyTablesParallel(vec);
+      }
       for (uoffset_t i = 0; i < vec->size(); i++) {
         if (!vec->Get(i)->Verify(*this)) return false;
       }
@@ -2500,6 +3202,15 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
     // Check the vtable offset.
     auto tableo = static_cast<size_t>(table - buf_);
     if (!Verify<soffset_t>(tableo)) return false;
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_STATS
+      if (stats_) {
+        if (stats_->path.size() <= depth_) stats_->path.resize(depth_ + 1);
+        stats_->path[depth_].table = tableo;
+        stats_->path[depth_].field = 0;
+      }
+    #endif
+    // clang-format on
     // This offset may be signed, but doing the subtraction unsigned always
     // gives the result we want.
     auto vtableo = tableo - static_cast<size_t>(ReadScalar<soffset_t>(table));
@@ -2564,9 +3275,32 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
   bool VerifyComplexity() {
     depth_++;
     num_tables_++;
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_STATS
+      if (stats_) {
+        stats_->tables++;
+        stats_->max_depth = (std::max)(stats_->max_depth,
+                                       static_cast<size_t>(depth_));
+      }
+    #endif
+    // clang-format on
     return Check(depth_ <= max_depth_ && num_tables_ <= max_tables_);
   }
 
+  // Called by Table before verifying one of its fields, to know the path to
+  // a failure.
+  void TrackField(voffset_t field) const {
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_STATS
+      if (stats_ && depth_ && depth_ <= stats_->path.size()) {
+        stats_->path[depth_ - 1].field = field;
+      }
+    #else
+      (void)field;
+    #endif
+    // clang-format on
+  }
+
   // Called at the end of a table to pop the depth count.
   bool EndTable() {
     depth_--;
@@ -2591,6 +3325,121 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
   }
 
  private:
+  // A range of a vector of tables verified on the ParallelRunner.
+  struct ParallelChunk {
+    uoffset_t begin;
+    uoffset_t end;
+    bool ok;
+    uoffset_t num_tables;
+    size_t upper_bound;
+    VerifierStats stats;  // Only collected if this Verifier collects them.
+  };
+
+  template<typename T> struct ParallelJob {
+    const Verifier *parent;
+    const Vector<Offset<T>> *vec;
+    ParallelChunk *chunks;
+  };
+
+  template<typename T> static void VerifyChunk(void *context, size_t index) {
+    auto &job = *static_cast<ParallelJob<T> *>(context);
+    auto &parent = *job.parent;
+    auto &chunk = job.chunks[index];
+    // Continue at the depth of the vector, with what is left of the table
+    // budget.
+    Verifier verifier(parent.buf_, parent.size_, parent.max_depth_,
+                      parent.max_tables_ - parent.num_tables_,
+                      parent.check_alignment_);
+    verifier.depth_ = parent.depth_;
+    verifier.check_utf8_ = parent.check_utf8_;
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_STATS
+      if (parent.stats_) verifier.SetStats(&chunk.stats);
+    #endif
+    // clang-format on
+    chunk.ok = true;
+    for (auto i = chunk.begin; i < chunk.end && chunk.ok; i++) {
+      chunk.ok = job.vec->Get(i)->Verify(verifier);
+    }
+    chunk.num_tables = verifier.num_tables_;
+    chunk.upper_bound = verifier.upper_bound_;
+  }
+
+  template<typename T>
+  bool VerifyTablesParallel(const Vector<Offset<T>> *vec) {
+    // A few chunks per thread, to even out tables of different sizes.
+    const size_t size = vec->size();
+    const auto num_chunks = (std::min)(
+        static_cast<size_t>((std::max)(runner_->Concurrency(), 1)) * 4, size);
+    std::vector<ParallelChunk> chunks(num_chunks);
+    for (size_t k = 0; k < num_chunks; k++) {
+      chunks[k].begin = static_cast<uoffset_t>(size * k / num_chunks);
+      chunks[k].end = static_cast<uoffset_t>(size * (k + 1) / num_chunks);
+    }
+    ParallelJob<T> job = { this, vec, vector_data(chunks) };
+    runner_->Run(num_chunks, VerifyChunk<T>, &job);
+    // Merge in order, up to the first chunk that failed, as far as a serial
+    // verification would have gotten.
+    size_t num_tables = num_tables_;
+    for (size_t k = 0; k < num_chunks; k++) {
+      auto &chunk = chunks[k];
+      num_tables += chunk.num_tables;
+      upper_bound_ = (std::max)(upper_bound_, chunk.upper_bound);
+      // clang-format off
+      #ifdef FLATBUFFERS_VERIFIER_STATS
+        if (stats_) MergeStats(chunk.stats);
+      #endif
+      // clang-format on
+      if (!chunk.ok) {
+        num_tables_ = static_cast<uoffset_t>(
+            (std::min)(num_tables, static_cast<size_t>(max_tables_) + 1));
+        return Check(false);
+      }
+    }
+    // Each chunk stayed within the budget left, together they may not have.
+    if (!Check(num_tables <= max_tables_)) return false;
+    num_tables_ = static_cast<uoffset_t>(num_tables);
+    return true;
+  }
+
+  void MergeStats(const VerifierStats &chunk) {
+    stats_->tables += chunk.tables;
+    stats_->vectors += chunk.vectors;
+    stats_->strings += chunk.strings;
+    stats_->bytes_checked += chunk.bytes_checked;
+    stats_->max_depth = (std::max)(stats_->max_depth, chunk.max_depth);
+    if (chunk.failed && !stats_->failed) {
+      stats_->failed = true;
+      stats_->failure_offset = chunk.failure_offset;
+      // The path of the chunk starts at the depth of the vector.
+      auto depth = (std::min)(static_cast<size_t>(depth_),
+                              stats_->path.size());
+      stats_->failure_path.assign(stats_->path.begin(),
+                                  stats_->path.begin() + depth);
+      if (chunk.failure_path.size() > depth) {
+        stats_->failure_path.insert(stats_->failure_path.end(),
+                                    chunk.failure_path.begin() + depth,
+                                    chunk.failure_path.end());
+      }
+    }
+  }
+
+  bool VerifyVectorOrStringImpl(const uint8_t *vec, size_t elem_size,
+                                size_t *end) const {
+    auto veco = static_cast<size_t>(vec - buf_);
+    // Check we can read the size field.
+    if (!Verify<uoffset_t>(veco)) return false;
+    // Check the whole array. If this is a string, the byte past the array
+    // must be 0.
+    auto size = ReadScalar<uoffset_t>(vec);
+    auto max_elems = FLATBUFFERS_MAX_BUFFER_SIZE / elem_size;
+    if (!Check(size < max_elems))
+      return false;  // Protect against byte_size overflowing.
+    auto byte_size = sizeof(size) + elem_size * size;
+    if (end) *end = veco + byte_size;
+    return Verify(veco, byte_size);
+  }
+
   const uint8_t *buf_;
   size_t size_;
   uoffset_t depth_;
@@ -2599,6 +3448,13 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
   uoffset_t max_tables_;
   mutable size_t upper_bound_;
   bool check_alignment_;
+  bool check_utf8_;
+  ParallelRunner *runner_;
+  uoffset_t parallel_min_elements_;
+  // Only used with FLATBUFFERS_VERIFIER_STATS, but always there so that the
+  // layout doesn't depend on it.
+  VerifierStats *stats_;
+  mutable size_t checked_offset_;
 };
 
 // Convenient way to bundle a buffer and its length, to pass it around
@@ -2744,6 +3600,7 @@ class Table {
   // Verify a particular field.
   template<typename T>
   bool VerifyField(const Verifier &verifier, voffset_t field) const {
+    verifier.TrackField(field);
     // Calling GetOptionalFieldOffset should be safe now thanks to
     // VerifyTable().
     auto field_offset = GetOptionalFieldOffset(field);
@@ -2754,6 +3611,7 @@ class Table {
   // VerifyField for required fields.
   template<typename T>
   bool VerifyFieldRequired(const Verifier &verifier, voffset_t field) const {
+    verifier.TrackField(field);
     auto field_offset = GetOptionalFieldOffset(field);
     return verifier.Check(field_offset != 0) &&
            verifier.Verify<T>(data_, field_offset);
@@ -2761,11 +3619,13 @@ class Table {
 
   // Versions for offsets.
   bool VerifyOffset(const Verifier &verifier, voffset_t field) const {
+    verifier.TrackField(field);
     auto field_offset = GetOptionalFieldOffset(field);
     return !field_offset || verifier.VerifyOffset(data_, field_offset);
   }
 
   bool VerifyOffsetRequired(const Verifier &verifier, voffset_t field) const {
+    verifier.TrackField(field);
     auto field_offset = GetOptionalFieldOffset(field);
     return verifier.Check(field_offset != 0) &&
            verifier.VerifyOffset(data_, field_offset);
@@ -2794,8 +3654,11 @@ inline flatbuffers::Optional<bool> Table::GetOptional<uint8_t, bool>(
 
 template<typename T>
 void FlatBufferBuilder::Required(Offset<T> table, voffset_t field) {
-  auto table_ptr = reinterpret_cast<const Table *>(buf_.data_at(table.o));
-  bool ok = table_ptr->GetOptionalFieldOffset(field) != 0;
+  // Finds the vtable by offset, it may be in another segment than the table.
+  auto vtable_offset = ReadScalar<soffset_t>(buf_.data_at(table.o));
+  auto vtable = buf_.data_at(table.o + static_cast<size_t>(vtable_offset));
+  bool ok = field < ReadScalar<voffset_t>(vtable) &&
+            ReadScalar<voffset_t>(vtable + field) != 0;
   // If this fails, the caller will show what field needs to be set.
   FLATBUFFERS_ASSERT(ok);
   (void)ok;
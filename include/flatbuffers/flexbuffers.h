@@ -22,6 +22,7 @@
 #include "flatbuffers/base.h"
 // We use the basic binary writing functions from the regular FlatBuffers.
 #include "flatbuffers/util.h"
+#include "flatbuffers/hash.h"
 
 #ifdef _MSC_VER
 #  include <intrin.h>
@@ -37,6 +38,8 @@ namespace flexbuffers {
 class Reference;
 class Map;
 
+inline std::vector<uint8_t> Canonicalize(const Reference &root);
+
 // These are used in the lower 2 bits of a type field to determine the size of
 // the elements (and or size field) of the item pointed to (e.g. vector).
 enum BitWidth {
@@ -203,6 +206,81 @@ inline BitWidth WidthF(double f) {
                                                          : BIT_WIDTH_64;
 }
 
+// What AsInt64(), AsUInt64() or AsDouble() converts a scalar to on the way
+// to T, as AsInt32(), AsFloat() etc. do.
+template<typename T> struct ConvertedVia {
+  typedef typename flatbuffers::conditional<
+      flatbuffers::is_floating_point<T>::value, double,
+      typename flatbuffers::conditional<flatbuffers::is_unsigned<T>::value,
+                                        uint64_t, int64_t>::type>::type type;
+};
+
+// Converts `len` scalars of type S at `src` into `dest`. Each instantiation
+// is a loop over one pair of types, which compilers vectorize (sign and zero
+// extension, float widening), or a memcpy if the types are the same.
+template<typename S, typename T>
+void ConvertScalars(const uint8_t *src, size_t len, T *dest) {
+  typedef typename ConvertedVia<T>::type Via;
+  // clang-format off
+  #if FLATBUFFERS_LITTLEENDIAN
+    if (flatbuffers::is_same<S, T>::value) {
+      if (len) memcpy(dest, src, len * sizeof(T));
+      return;
+    }
+  #endif
+  // clang-format on
+  // Blocks of a fixed size are vectorized by compilers that won't vectorize
+  // loops of unknown length at their default optimization level.
+  const size_t kBlock = 8;
+  size_t i = 0;
+  for (; i + kBlock <= len; i += kBlock) {
+    for (size_t j = 0; j < kBlock; j++) {
+      dest[i + j] = static_cast<T>(static_cast<Via>(
+          flatbuffers::ReadScalar<S>(src + (i + j) * sizeof(S))));
+    }
+  }
+  for (; i < len; i++) {
+    dest[i] = static_cast<T>(
+        static_cast<Via>(flatbuffers::ReadScalar<S>(src + i * sizeof(S))));
+  }
+}
+
+// Converts the `len` elements of a typed vector into `dest` as AsInt64(),
+// AsDouble() etc. would, false if they aren't numbers or bools.
+template<typename T>
+bool ConvertTypedElements(const uint8_t *data, uint8_t byte_width, Type type,
+                          size_t len, T *dest) {
+  switch (type) {
+    case FBT_INT:
+      switch (byte_width) {
+        case 1: ConvertScalars<int8_t>(data, len, dest); return true;
+        case 2: ConvertScalars<int16_t>(data, len, dest); return true;
+        case 4: ConvertScalars<int32_t>(data, len, dest); return true;
+        case 8: ConvertScalars<int64_t>(data, len, dest); return true;
+      }
+      break;
+    case FBT_UINT:
+    case FBT_BOOL:
+      switch (byte_width) {
+        case 1: ConvertScalars<uint8_t>(data, len, dest); return true;
+        case 2: ConvertScalars<uint16_t>(data, len, dest); return true;
+        case 4: ConvertScalars<uint32_t>(data, len, dest); return true;
+        case 8: ConvertScalars<uint64_t>(data, len, dest); return true;
+      }
+      break;
+    case FBT_FLOAT:
+      switch (byte_width) {
+        case 1: ConvertScalars<quarter>(data, len, dest); return true;
+        case 2: ConvertScalars<half>(data, len, dest); return true;
+        case 4: ConvertScalars<float>(data, len, dest); return true;
+        case 8: ConvertScalars<double>(data, len, dest); return true;
+      }
+      break;
+    default: break;
+  }
+  return false;
+}
+
 // Base class of all types below.
 // Points into the data buffer and allows access to one type.
 class Object {
@@ -213,6 +291,8 @@ class Object {
  protected:
   const uint8_t *data_;
   uint8_t byte_width_;
+
+  friend class Editor;
 };
 
 // Object that has a size, obtained either from size prefix, or elsewhere.
@@ -296,6 +376,13 @@ class TypedVector : public Sized {
 
   Type ElementType() { return type_; }
 
+  // Copies all elements into `dest`, which has room for size() of them,
+  // converted to T as AsInt64(), AsDouble() etc. would. Much faster than
+  // reading them one by one. Returns false if they aren't numbers or bools.
+  template<typename T> bool CopyTo(T *dest) const {
+    return ConvertTypedElements(data_, byte_width_, type_, size_, dest);
+  }
+
   friend Reference;
 
  private:
@@ -323,17 +410,60 @@ class FixedTypedVector : public Object {
   Type ElementType() { return type_; }
   uint8_t size() { return len_; }
 
+  // Like TypedVector::CopyTo().
+  template<typename T> bool CopyTo(T *dest) const {
+    return ConvertTypedElements(data_, byte_width_, type_, len_, dest);
+  }
+
  private:
   Type type_;
   uint8_t len_;
 };
 
+// A key to look up in many maps, such as a setting read from every config:
+//
+//   flexbuffers::MapKey timeout("timeout");
+//   for (...) total += GetRoot(config).AsMap()[timeout].AsInt64();
+//
+// Remembers where it was found in the last few key vectors, so it is found
+// again with one compare in maps that share their keys vector
+// (BUILDER_FLAG_SHARE_KEY_VECTORS) or that are read again, and in maps with
+// the same keys in other buffers. Not thread safe, lookups update what it
+// remembers.
+class MapKey {
+ public:
+  explicit MapKey(const char *key) : key_(key) { Init(); }
+  explicit MapKey(const std::string &key) : key_(key) { Init(); }
+
+  const std::string &str() const { return key_; }
+
+ private:
+  friend class Map;
+
+  void Init() {
+    for (size_t i = 0; i < kCacheSize; i++) cache_[i].keys = nullptr;
+    next_ = 0;
+  }
+
+  static const size_t kCacheSize = 4;
+
+  struct CacheEntry {
+    const uint8_t *keys;  // Data of the keys vector.
+    size_t index;
+  };
+
+  std::string key_;
+  mutable CacheEntry cache_[kCacheSize];
+  mutable size_t next_;  // The entry replaced next.
+};
+
 class Map : public Vector {
  public:
   Map(const uint8_t *data, uint8_t byte_width) : Vector(data, byte_width) {}
 
   Reference operator[](const char *key) const;
   Reference operator[](const std::string &key) const;
+  Reference operator[](const MapKey &key) const;
 
   Vector Values() const { return Vector(data_, byte_width_); }
 
@@ -354,14 +484,22 @@ class Map : public Vector {
   }
 
   bool IsTheEmptyMap() const { return data_ == EmptyMap().data_; }
+
+ private:
+  // Binary search of `keys` for `key`.
+  static bool FindKey(const TypedVector &keys, const char *key,
+                      size_t *index);
+
+  friend class Editor;
 };
 
 template<typename T>
-void AppendToString(std::string &s, T &&v, bool keys_quoted) {
+void AppendToString(std::string &s, T &&v, bool keys_quoted,
+                    flatbuffers::TextSink *sink = nullptr) {
   s += "[ ";
   for (size_t i = 0; i < v.size(); i++) {
     if (i) s += ", ";
-    v[i].ToString(true, keys_quoted, s);
+    v[i].ToString(true, keys_quoted, s, sink);
   }
   s += " ]";
 }
@@ -543,6 +681,25 @@ class Reference {
   // they always do). keys_quoted determines if keys are quoted, at any level.
   // TODO(wvo): add further options to have indentation/newlines.
   void ToString(bool strings_quoted, bool keys_quoted, std::string &s) const {
+    ToString(strings_quoted, keys_quoted, s, nullptr);
+  }
+
+  // Streams the same text to `sink` in bounded chunks, returns false if the
+  // sink failed to write.
+  bool ToString(bool strings_quoted, bool keys_quoted,
+                flatbuffers::TextSink &sink) const {
+    ToString(strings_quoted, keys_quoted, sink.buffer(), &sink);
+    return sink.Flush();
+  }
+
+  // Appends to `s`, which is the buffer of `sink` if it isn't null: the sink
+  // is flushed after every value of a map or vector.
+  void ToString(bool strings_quoted, bool keys_quoted, std::string &s,
+                flatbuffers::TextSink *sink) const {
+    if (sink) {
+      FLATBUFFERS_ASSERT(&s == &sink->buffer());
+      sink->MaybeFlush();
+    }
     if (type_ == FBT_STRING) {
       String str(Indirect(), byte_width_);
       if (strings_quoted) {
@@ -573,18 +730,19 @@ class Reference {
       auto keys = m.Keys();
       auto vals = m.Values();
       for (size_t i = 0; i < keys.size(); i++) {
-        keys[i].ToString(true, keys_quoted, s);
+        keys[i].ToString(true, keys_quoted, s, sink);
         s += ": ";
-        vals[i].ToString(true, keys_quoted, s);
+        vals[i].ToString(true, keys_quoted, s, sink);
         if (i < keys.size() - 1) s += ", ";
       }
       s += " }";
     } else if (IsVector()) {
-      AppendToString<Vector>(s, AsVector(), keys_quoted);
+      AppendToString<Vector>(s, AsVector(), keys_quoted, sink);
     } else if (IsTypedVector()) {
-      AppendToString<TypedVector>(s, AsTypedVector(), keys_quoted);
+      AppendToString<TypedVector>(s, AsTypedVector(), keys_quoted, sink);
     } else if (IsFixedTypedVector()) {
-      AppendToString<FixedTypedVector>(s, AsFixedTypedVector(), keys_quoted);
+      AppendToString<FixedTypedVector>(s, AsFixedTypedVector(), keys_quoted,
+                                       sink);
     } else if (IsBlob()) {
       auto blob = AsBlob();
       flatbuffers::EscapeString(reinterpret_cast<const char *>(blob.data()),
@@ -761,6 +919,8 @@ class Reference {
   uint8_t parent_width_;
   uint8_t byte_width_;
   Type type_;
+
+  friend class Editor;
 };
 
 // Template specialization for As().
@@ -841,20 +1001,48 @@ template<typename T> int KeyCompare(const void *key, const void *elem) {
   return strcmp(skey, str_elem);
 }
 
-inline Reference Map::operator[](const char *key) const {
-  auto keys = Keys();
-  // We can't pass keys.byte_width_ to the comparison function, so we have
-  // to pick the right one ahead of time.
-  int (*comp)(const void *, const void *) = nullptr;
+// Compares the first characters inline, most probes of a binary search end
+// there without calling strcmp().
+template<typename T>
+bool FindKeyIndex(const uint8_t *keys, size_t len, const char *key,
+                  size_t *index) {
+  auto first = static_cast<unsigned char>(*key);
+  size_t lo = 0;
+  while (len) {
+    auto mid = lo + len / 2;
+    auto elem = reinterpret_cast<const char *>(
+        Indirect<T>(keys + mid * sizeof(T)));
+    auto comp = first - static_cast<int>(static_cast<unsigned char>(*elem));
+    if (!comp && first) comp = strcmp(key + 1, elem + 1);
+    if (!comp) {
+      *index = mid;
+      return true;
+    }
+    if (comp > 0) {
+      lo = mid + 1;
+      len -= len / 2 + 1;
+    } else {
+      len /= 2;
+    }
+  }
+  return false;
+}
+
+inline bool Map::FindKey(const TypedVector &keys, const char *key,
+                         size_t *index) {
+  // Pick the search for the width of the offsets to the keys ahead of time.
   switch (keys.byte_width_) {
-    case 1: comp = KeyCompare<uint8_t>; break;
-    case 2: comp = KeyCompare<uint16_t>; break;
-    case 4: comp = KeyCompare<uint32_t>; break;
-    case 8: comp = KeyCompare<uint64_t>; break;
-  }
-  auto res = std::bsearch(key, keys.data_, keys.size(), keys.byte_width_, comp);
-  if (!res) return Reference(nullptr, 1, NullPackedType());
-  auto i = (reinterpret_cast<uint8_t *>(res) - keys.data_) / keys.byte_width_;
+    case 1: return FindKeyIndex<uint8_t>(keys.data_, keys.size(), key, index);
+    case 2: return FindKeyIndex<uint16_t>(keys.data_, keys.size(), key, index);
+    case 4: return FindKeyIndex<uint32_t>(keys.data_, keys.size(), key, index);
+    case 8: return FindKeyIndex<uint64_t>(keys.data_, keys.size(), key, index);
+  }
+  return false;
+}
+
+inline Reference Map::operator[](const char *key) const {
+  size_t i;
+  if (!FindKey(Keys(), key, &i)) return Reference(nullptr, 1, NullPackedType());
   return (*static_cast<const Vector *>(this))[i];
 }
 
@@ -862,6 +1050,38 @@ inline Reference Map::operator[](const std::string &key) const {
   return (*this)[key.c_str()];
 }
 
+inline Reference Map::operator[](const MapKey &key) const {
+  auto keys = Keys();
+  auto str = key.key_.c_str();
+  for (size_t c = 0; c < MapKey::kCacheSize; c++) {
+    const MapKey::CacheEntry &entry = key.cache_[c];
+    // Another keys vector may be at the same place now, check the key.
+    if (entry.keys == keys.data_ && entry.index < keys.size() &&
+        !strcmp(str, reinterpret_cast<const char *>(Indirect(
+                         keys.data_ + entry.index * keys.byte_width_,
+                         keys.byte_width_)))) {
+      return (*static_cast<const Vector *>(this))[entry.index];
+    }
+  }
+  // Maps of the same shape in other buffers, such as records of a log, have
+  // the key where it was found last.
+  const MapKey::CacheEntry &last =
+      key.cache_[(key.next_ + MapKey::kCacheSize - 1) % MapKey::kCacheSize];
+  size_t i = last.index;
+  if (!last.keys || i >= keys.size() ||
+      strcmp(str, reinterpret_cast<const char *>(Indirect(
+                      keys.data_ + i * keys.byte_width_, keys.byte_width_)))) {
+    if (!FindKey(keys, str, &i)) {
+      return Reference(nullptr, 1, NullPackedType());
+    }
+  }
+  MapKey::CacheEntry &entry = key.cache_[key.next_];
+  key.next_ = (key.next_ + 1) % MapKey::kCacheSize;
+  entry.keys = keys.data_;
+  entry.index = i;
+  return (*static_cast<const Vector *>(this))[i];
+}
+
 inline Reference GetRoot(const uint8_t *buffer, size_t size) {
   // See Finish() below for the serialization counterpart of this.
   // The root starts at the end of the buffer, so we parse backwards from there.
@@ -880,12 +1100,15 @@ inline Reference GetRoot(const std::vector<uint8_t> &buffer) {
 // The "Share" flags determine if the Builder automatically tries to pool
 // this type. Pooling can reduce the size of serialized data if there are
 // multiple maps of the same kind, at the expense of slightly slower
-// serialization (the cost of lookups) and more memory use (std::set).
+// serialization (the cost of lookups) and more memory use (a hash table).
 // By default this is on for keys, but off for strings.
 // Turn keys off if you have e.g. only one map.
 // Turn strings on if you expect many non-unique string values.
 // Additionally, sharing key vectors can save space if you have maps with
 // identical field populations.
+// With BUILDER_FLAG_CANONICAL, Finish() writes the buffer again in canonical
+// form (see Canonicalize()), whatever the other flags and the order values
+// were added in, so that equal documents are equal bytes.
 enum BuilderFlag {
   BUILDER_FLAG_NONE = 0,
   BUILDER_FLAG_SHARE_KEYS = 1,
@@ -893,20 +1116,77 @@ enum BuilderFlag {
   BUILDER_FLAG_SHARE_KEYS_AND_STRINGS = 3,
   BUILDER_FLAG_SHARE_KEY_VECTORS = 4,
   BUILDER_FLAG_SHARE_ALL = 7,
+  BUILDER_FLAG_CANONICAL = 8,
+};
+
+// Supplies the buffers Builders write into, for callers that want to reuse
+// the memory of buffers they are done with, such as those taken from
+// Builder::Release(). A Builder given one gives its buffer back when it is
+// destroyed.
+class BufferAllocator {
+ public:
+  virtual ~BufferAllocator() {}
+
+  // Makes `buf` an empty buffer with room for at least `size` bytes.
+  virtual void Allocate(size_t size, std::vector<uint8_t> *buf) = 0;
+
+  // Takes the memory of `buf`, leaving it empty.
+  virtual void Deallocate(std::vector<uint8_t> *buf) = 0;
+};
+
+// Keeps up to `max_buffers` of the buffers given back, and hands them out
+// again. Not thread safe.
+class BufferPool : public BufferAllocator {
+ public:
+  explicit BufferPool(size_t max_buffers = 16) : max_buffers_(max_buffers) {}
+
+  void Allocate(size_t size, std::vector<uint8_t> *buf) FLATBUFFERS_OVERRIDE {
+    if (free_.empty()) {
+      buf->clear();
+    } else {
+      buf->swap(free_.back());
+      free_.pop_back();
+      buf->clear();
+    }
+    buf->reserve(size);
+  }
+
+  void Deallocate(std::vector<uint8_t> *buf) FLATBUFFERS_OVERRIDE {
+    if (free_.size() < max_buffers_ && buf->capacity()) {
+      free_.push_back(std::vector<uint8_t>());
+      free_.back().swap(*buf);
+    } else {
+      std::vector<uint8_t>().swap(*buf);
+    }
+  }
+
+  // The number of buffers kept.
+  size_t size() const { return free_.size(); }
+
+ private:
+  size_t max_buffers_;
+  std::vector<std::vector<uint8_t>> free_;
 };
 
 class Builder FLATBUFFERS_FINAL_CLASS {
  public:
+  // The buffer comes from `allocator` if there is one, which must outlive
+  // the Builder.
   Builder(size_t initial_size = 256,
-          BuilderFlag flags = BUILDER_FLAG_SHARE_KEYS)
-      : buf_(initial_size),
-        finished_(false),
+          BuilderFlag flags = BUILDER_FLAG_SHARE_KEYS,
+          BufferAllocator *allocator = nullptr)
+      : finished_(false),
         has_duplicate_keys_(false),
         flags_(flags),
         force_min_bit_width_(BIT_WIDTH_8),
-        key_pool(KeyOffsetCompare(buf_)),
-        string_pool(StringOffsetCompare(buf_)) {
-    buf_.clear();
+        allocator_(allocator),
+        initial_size_(initial_size),
+        max_retained_(0) {
+    NewBuffer();
+  }
+
+  ~Builder() {
+    if (allocator_) allocator_->Deallocate(&buf_);
   }
 
 #ifdef FLATBUFFERS_DEFAULT_DECLARATION
@@ -921,18 +1201,45 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     return buf_;
   }
 
+  /// @brief Take the serialized buffer (after you call `Finish()`), without
+  /// copying it. The Builder is cleared, and gets a new buffer.
+  std::vector<uint8_t> Release() {
+    Finished();
+    std::vector<uint8_t> buf;
+    buf.swap(buf_);
+    Clear();
+    NewBuffer();
+    return buf;
+  }
+
   // Size of the buffer. Does not include unfinished values.
   size_t GetSize() const { return buf_.size(); }
 
+  // Makes Clear() free the buffer or the stack of values when they have
+  // grown to more than `bytes`, so that one large buffer doesn't keep its
+  // memory for all the small ones built after it. With 0, the default, they
+  // keep their memory.
+  void SetMaxRetainedCapacity(size_t bytes) { max_retained_ = bytes; }
+
   // Reset all state so we can re-use the buffer.
   void Clear() {
     buf_.clear();
     stack_.clear();
+    if (max_retained_ && buf_.capacity() > max_retained_) {
+      std::vector<uint8_t>().swap(buf_);
+      NewBuffer();
+    }
+    if (max_retained_ && stack_.capacity() * sizeof(Value) > max_retained_) {
+      std::vector<Value>().swap(stack_);
+    }
     finished_ = false;
     // flags_ remains as-is;
     force_min_bit_width_ = BIT_WIDTH_8;
     key_pool.clear();
     string_pool.clear();
+    shared_keys_.clear();
+    key_vectors_.clear();
+    key_vector_pool.clear();
   }
 
   // All value constructing functions below have two versions: one that
@@ -1007,17 +1314,15 @@ class Builder FLATBUFFERS_FINAL_CLASS {
 
   size_t Key(const char *str, size_t len) {
     auto sloc = buf_.size();
-    WriteBytes(str, len + 1);
     if (flags_ & BUILDER_FLAG_SHARE_KEYS) {
-      auto it = key_pool.find(sloc);
-      if (it != key_pool.end()) {
-        // Already in the buffer. Remove key we just serialized, and use
-        // existing offset instead.
-        buf_.resize(sloc);
-        sloc = *it;
-      } else {
-        key_pool.insert(sloc);
+      // Use the key already in the buffer if there is one, or write this one.
+      auto hash = flatbuffers::HashStringBytes(str, len);
+      if (!key_pool.Find(hash, len, PoolEquals(buf_, str, len), &sloc)) {
+        WriteKey(str, len);
+        key_pool.Insert(hash, len, sloc);
       }
+    } else {
+      WriteKey(str, len);
     }
     stack_.push_back(Value(static_cast<uint64_t>(sloc), FBT_KEY, BIT_WIDTH_8));
     return sloc;
@@ -1027,20 +1332,19 @@ class Builder FLATBUFFERS_FINAL_CLASS {
   size_t Key(const std::string &str) { return Key(str.c_str(), str.size()); }
 
   size_t String(const char *str, size_t len) {
-    auto reset_to = buf_.size();
-    auto sloc = CreateBlob(str, len, 1, FBT_STRING);
-    if (flags_ & BUILDER_FLAG_SHARE_STRINGS) {
-      StringOffset so(sloc, len);
-      auto it = string_pool.find(so);
-      if (it != string_pool.end()) {
-        // Already in the buffer. Remove string we just serialized, and use
-        // existing offset instead.
-        buf_.resize(reset_to);
-        sloc = it->first;
-        stack_.back().u_ = sloc;
-      } else {
-        string_pool.insert(so);
-      }
+    if (!(flags_ & BUILDER_FLAG_SHARE_STRINGS)) {
+      return CreateBlob(str, len, 1, FBT_STRING);
+    }
+    // Use the string already in the buffer if there is one, or write this
+    // one.
+    auto hash = flatbuffers::HashStringBytes(str, len);
+    size_t sloc;
+    if (string_pool.Find(hash, len, PoolEquals(buf_, str, len), &sloc)) {
+      stack_.push_back(Value(static_cast<uint64_t>(sloc), FBT_STRING,
+                             WidthU(len)));
+    } else {
+      sloc = CreateBlob(str, len, 1, FBT_STRING);
+      string_pool.Insert(hash, len, sloc);
     }
     return sloc;
   }
@@ -1144,9 +1448,7 @@ class Builder FLATBUFFERS_FINAL_CLASS {
                 return comp < 0;
               });
     // First create a vector out of all keys.
-    // TODO(wvo): if kBuilderFlagShareKeyVectors is true, see if we can share
-    // the first vector.
-    auto keys = CreateVector(start, len, 2, true, false);
+    auto keys = KeysVector(start, len);
     auto vec = CreateVector(start + 1, len, 2, false, false, &keys);
     // Remove temp elements and return map.
     stack_.resize(start);
@@ -1297,6 +1599,63 @@ class Builder FLATBUFFERS_FINAL_CLASS {
   void Add(const std::string &str) { String(str); }
   void Add(const flexbuffers::String &str) { String(str); }
 
+  // Adds a copy of `ref` and everything it refers to, which may be in another
+  // buffer. Values are stored with the smallest widths that fit them.
+  void Add(const Reference &ref) {
+    switch (ref.GetType()) {
+      case FBT_NULL: Null(); break;
+      case FBT_INT: Int(ref.AsInt64()); break;
+      case FBT_UINT: UInt(ref.AsUInt64()); break;
+      case FBT_FLOAT: Double(ref.AsDouble()); break;
+      case FBT_BOOL: Bool(ref.AsBool()); break;
+      case FBT_KEY: Key(ref.AsKey()); break;
+      case FBT_STRING: String(ref.AsString()); break;
+      case FBT_BLOB: {
+        auto blob = ref.AsBlob();
+        Blob(blob.data(), blob.size());
+        break;
+      }
+      case FBT_INDIRECT_INT: IndirectInt(ref.AsInt64()); break;
+      case FBT_INDIRECT_UINT: IndirectUInt(ref.AsUInt64()); break;
+      case FBT_INDIRECT_FLOAT: IndirectDouble(ref.AsDouble()); break;
+      case FBT_MAP: {
+        auto map = ref.AsMap();
+        auto keys = map.Keys();
+        auto values = map.Values();
+        auto start = StartMap();
+        for (size_t i = 0; i < map.size(); i++) {
+          Key(keys[i].AsKey());
+          Add(values[i]);
+        }
+        EndMap(start);
+        break;
+      }
+      case FBT_VECTOR: {
+        auto vec = ref.AsVector();
+        auto start = StartVector();
+        for (size_t i = 0; i < vec.size(); i++) Add(vec[i]);
+        EndVector(start, false, false);
+        break;
+      }
+      default:
+        if (ref.IsTypedVector()) {
+          auto vec = ref.AsTypedVector();
+          auto start = StartVector();
+          for (size_t i = 0; i < vec.size(); i++) Add(vec[i]);
+          EndVector(start, true, false);
+        } else if (ref.IsFixedTypedVector()) {
+          auto vec = ref.AsFixedTypedVector();
+          auto start = StartVector();
+          for (size_t i = 0; i < vec.size(); i++) Add(vec[i]);
+          EndVector(start, true, true);
+        } else {
+          FLATBUFFERS_ASSERT(false);  // Unknown type.
+          Null();
+        }
+        break;
+    }
+  }
+
   template<typename T> void Add(const std::vector<T> &vec) { Vector(vec); }
 
   template<typename T> void Add(const char *key, const T &t) {
@@ -1334,6 +1693,7 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     Write(byte_width, 1);
 
     finished_ = true;
+    if (flags_ & BUILDER_FLAG_CANONICAL) MakeCanonical();
   }
 
  private:
@@ -1344,6 +1704,92 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     FLATBUFFERS_ASSERT(finished_);
   }
 
+  // Writes a copy of `ref` in canonical form: maps in key order, integers as
+  // Int unless they only fit a UInt, floats as Double (narrowed to 32 bits
+  // when exact) with a single NaN, indirect values inline, and vectors typed
+  // when their elements are scalars of one type, untyped otherwise.
+  void AddCanonical(const Reference &ref) {
+    switch (ref.GetType()) {
+      case FBT_INT:
+      case FBT_INDIRECT_INT: Int(ref.AsInt64()); break;
+      case FBT_UINT:
+      case FBT_INDIRECT_UINT: {
+        auto u = ref.AsUInt64();
+        if (u <= static_cast<uint64_t>((std::numeric_limits<int64_t>::max)())) {
+          Int(static_cast<int64_t>(u));
+        } else {
+          UInt(u);
+        }
+        break;
+      }
+      case FBT_FLOAT:
+      case FBT_INDIRECT_FLOAT: {
+        auto d = ref.AsDouble();
+        Double(d == d ? d : std::numeric_limits<double>::quiet_NaN());
+        break;
+      }
+      case FBT_MAP: {
+        auto map = ref.AsMap();
+        auto keys = map.Keys();
+        auto values = map.Values();
+        auto start = StartMap();
+        for (size_t i = 0; i < map.size(); i++) {
+          Key(keys[i].AsKey());
+          AddCanonical(values[i]);
+        }
+        EndMap(start);
+        break;
+      }
+      default:
+        if (!ref.IsAnyVector()) {
+          Add(ref);  // Null, bool, key, string or blob.
+          break;
+        }
+        auto start = StartVector();
+        if (ref.IsFixedTypedVector()) {
+          auto vec = ref.AsFixedTypedVector();
+          for (size_t i = 0; i < vec.size(); i++) AddCanonical(vec[i]);
+        } else if (ref.IsTypedVector()) {
+          auto vec = ref.AsTypedVector();
+          for (size_t i = 0; i < vec.size(); i++) AddCanonical(vec[i]);
+        } else {
+          auto vec = ref.AsVector();
+          for (size_t i = 0; i < vec.size(); i++) AddCanonical(vec[i]);
+        }
+        auto typed = start < stack_.size();
+        for (auto i = start; i < stack_.size() && typed; i++) {
+          auto type = stack_[i].type_;
+          typed = type == stack_[start].type_ &&
+                  (type == FBT_INT || type == FBT_UINT || type == FBT_FLOAT ||
+                   type == FBT_BOOL);
+        }
+        EndVector(start, typed, false);
+    }
+  }
+
+  // Replaces the finished buffer with its canonical form.
+  void MakeCanonical() {
+    Builder canonical(buf_.size(), BUILDER_FLAG_SHARE_ALL, allocator_);
+    canonical.AddCanonical(flexbuffers::GetRoot(buf_));
+    canonical.Finish();
+    // The old buffer goes back to the allocator with `canonical`.
+    buf_.swap(canonical.buf_);
+    // The pools are of offsets in the old buffer.
+    key_pool.clear();
+    string_pool.clear();
+    shared_keys_.clear();
+    key_vectors_.clear();
+    key_vector_pool.clear();
+  }
+
+  void NewBuffer() {
+    if (allocator_) {
+      allocator_->Allocate(initial_size_, &buf_);
+    } else {
+      buf_.reserve(initial_size_);
+    }
+  }
+
   // Align to prepare for writing a scalar with a certain size.
   uint8_t Align(BitWidth alignment) {
     auto byte_width = 1U << alignment;
@@ -1357,6 +1803,12 @@ class Builder FLATBUFFERS_FINAL_CLASS {
                 reinterpret_cast<const uint8_t *>(val) + size);
   }
 
+  // Keys are zero terminated, `str` doesn't need to be.
+  void WriteKey(const char *str, size_t len) {
+    WriteBytes(str, len);
+    buf_.push_back(0);
+  }
+
   template<typename T> void Write(T val, size_t byte_width) {
     FLATBUFFERS_ASSERT(sizeof(T) >= byte_width);
     val = flatbuffers::EndianScalar(val);
@@ -1497,7 +1949,9 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     auto byte_width = Align(bit_width);
     Write<uint64_t>(len, byte_width);
     auto sloc = buf_.size();
-    WriteBytes(data, len + trailing);
+    // The trailing bytes are zeros, `data` doesn't need to have them.
+    WriteBytes(data, len);
+    for (size_t i = 0; i < trailing; i++) buf_.push_back(0);
     stack_.push_back(Value(static_cast<uint64_t>(sloc), type, bit_width));
     return sloc;
   }
@@ -1523,6 +1977,40 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     return vloc;
   }
 
+  // The vector of the keys at stack_[start], stack_[start + 2].. of a map.
+  // With BUILDER_FLAG_SHARE_KEY_VECTORS, maps with the same keys share it.
+  // Equal keys are found by their offsets, so this needs
+  // BUILDER_FLAG_SHARE_KEYS as well.
+  Value KeysVector(size_t start, size_t len) {
+    if (!(flags_ & BUILDER_FLAG_SHARE_KEY_VECTORS)) {
+      return CreateVector(start, len, 2, true, false);
+    }
+    auto first = shared_keys_.size();
+    for (auto i = start; i < stack_.size(); i += 2) {
+      shared_keys_.push_back(stack_[i].u_);
+    }
+    auto data = reinterpret_cast<const char *>(
+        flatbuffers::vector_data(shared_keys_) + first);
+    auto size = len * sizeof(uint64_t);
+    auto hash = flatbuffers::HashStringBytes(data, size);
+    size_t found;
+    if (key_vector_pool.Find(
+            hash, size,
+            [&](size_t i) {
+              return memcmp(flatbuffers::vector_data(shared_keys_) +
+                                key_vectors_[i].first,
+                            data, size) == 0;
+            },
+            &found)) {
+      shared_keys_.resize(first);
+      return key_vectors_[found].second;
+    }
+    auto keys = CreateVector(start, len, 2, true, false);
+    key_vector_pool.Insert(hash, size, key_vectors_.size());
+    key_vectors_.push_back(std::make_pair(first, keys));
+    return keys;
+  }
+
   Value CreateVector(size_t start, size_t vec_len, size_t step, bool typed,
                      bool fixed, const Value *keys = nullptr) {
     FLATBUFFERS_ASSERT(
@@ -1595,37 +2083,736 @@ class Builder FLATBUFFERS_FINAL_CLASS {
 
   BitWidth force_min_bit_width_;
 
-  struct KeyOffsetCompare {
-    explicit KeyOffsetCompare(const std::vector<uint8_t> &buf) : buf_(&buf) {}
-    bool operator()(size_t a, size_t b) const {
-      auto stra =
-          reinterpret_cast<const char *>(flatbuffers::vector_data(*buf_) + a);
-      auto strb =
-          reinterpret_cast<const char *>(flatbuffers::vector_data(*buf_) + b);
-      return strcmp(stra, strb) < 0;
+  BufferAllocator *allocator_;
+  size_t initial_size_;
+  size_t max_retained_;
+
+  // Compares a key or string in the buffer, of the length looked up, with
+  // `str_`.
+  struct PoolEquals {
+    PoolEquals(const std::vector<uint8_t> &buf, const char *str, size_t len)
+        : buf_(&buf), str_(str), len_(len) {}
+    bool operator()(size_t off) const {
+      return memcmp(flatbuffers::vector_data(*buf_) + off, str_, len_) == 0;
     }
     const std::vector<uint8_t> *buf_;
+    const char *str_;
+    size_t len_;
   };
 
-  typedef std::pair<size_t, size_t> StringOffset;
-  struct StringOffsetCompare {
-    explicit StringOffsetCompare(const std::vector<uint8_t> &buf)
-        : buf_(&buf) {}
-    bool operator()(const StringOffset &a, const StringOffset &b) const {
-      auto stra = reinterpret_cast<const char *>(
-          flatbuffers::vector_data(*buf_) + a.first);
-      auto strb = reinterpret_cast<const char *>(
-          flatbuffers::vector_data(*buf_) + b.first);
-      return strncmp(stra, strb, (std::min)(a.second, b.second) + 1) < 0;
+  // The offsets of the keys and strings shared by the flags.
+  flatbuffers::StringOffsetPool key_pool;
+  flatbuffers::StringOffsetPool string_pool;
+
+  // For BUILDER_FLAG_SHARE_KEY_VECTORS: the keys of each shared keys vector,
+  // one after another, where each one's keys start with the vector, and the
+  // indices into key_vectors_ by the hash of the keys.
+  std::vector<uint64_t> shared_keys_;
+  std::vector<std::pair<size_t, Value>> key_vectors_;
+  flatbuffers::StringOffsetPool key_vector_pool;
+
+  friend class Editor;
+  friend std::vector<uint8_t> Canonicalize(const Reference &root);
+};
+
+// A copy of a FlexBuffer whose bytes depend only on its contents, for
+// comparing documents by their bytes or hashes. Equal documents are equal
+// bytes whatever Builder flags and order of adding values made them. Maps are
+// equal when they have the same keys and values, numbers when they have the
+// same value and kind (integer or floating point), and vectors when they have
+// equal elements, typed or not.
+inline std::vector<uint8_t> Canonicalize(const Reference &root) {
+  Builder builder(256, BUILDER_FLAG_SHARE_ALL);
+  builder.AddCanonical(root);
+  builder.Finish();
+  std::vector<uint8_t> buf;
+  buf.swap(builder.buf_);
+  return buf;
+}
+
+// A hash of the contents of a FlexBuffer, for finding equal documents (as
+// Canonicalize() compares them) without building their canonical form.
+// Equal documents have equal hashes, the other way around is likely.
+inline uint64_t CanonicalHash(const Reference &root, uint64_t seed = 0) {
+  struct Hash {
+    // One step of XXH64, for 8 bytes of input.
+    static uint64_t Mix(uint64_t h, uint64_t v) {
+      v *= 0xC2B2AE3D27D4EB4FULL;
+      h ^= ((v << 31) | (v >> 33)) * 0x9E3779B185EBCA87ULL;
+      return ((h << 27) | (h >> 37)) * 0x9E3779B185EBCA87ULL +
+             0x85EBCA77C2B2AE63ULL;
     }
-    const std::vector<uint8_t> *buf_;
+    static uint64_t Bytes(uint64_t h, Type type, const char *data,
+                          size_t size) {
+      return flatbuffers::HashXxh64(data, size, Mix(h, type));
+    }
+  };
+  uint64_t h;
+  switch (root.GetType()) {
+    case FBT_NULL: h = Hash::Mix(seed, FBT_NULL); break;
+    case FBT_BOOL:
+      h = Hash::Mix(Hash::Mix(seed, FBT_BOOL), root.AsBool());
+      break;
+    case FBT_INT:
+    case FBT_INDIRECT_INT:
+      h = Hash::Mix(Hash::Mix(seed, FBT_INT),
+                    static_cast<uint64_t>(root.AsInt64()));
+      break;
+    case FBT_UINT:
+    case FBT_INDIRECT_UINT: {
+      auto u = root.AsUInt64();
+      auto fits = u <= static_cast<uint64_t>(
+                           (std::numeric_limits<int64_t>::max)());
+      h = Hash::Mix(Hash::Mix(seed, fits ? FBT_INT : FBT_UINT), u);
+      break;
+    }
+    case FBT_FLOAT:
+    case FBT_INDIRECT_FLOAT: {
+      auto d = root.AsDouble();
+      if (d != d) d = std::numeric_limits<double>::quiet_NaN();
+      uint64_t bits;
+      memcpy(&bits, &d, sizeof(bits));
+      h = Hash::Mix(Hash::Mix(seed, FBT_FLOAT), bits);
+      break;
+    }
+    case FBT_KEY: {
+      auto key = root.AsKey();
+      h = Hash::Bytes(seed, FBT_KEY, key, strlen(key));
+      break;
+    }
+    case FBT_STRING: {
+      auto str = root.AsString();
+      h = Hash::Bytes(seed, FBT_STRING, str.c_str(), str.length());
+      break;
+    }
+    case FBT_BLOB: {
+      auto blob = root.AsBlob();
+      h = Hash::Bytes(seed, FBT_BLOB,
+                      reinterpret_cast<const char *>(blob.data()),
+                      blob.size());
+      break;
+    }
+    case FBT_MAP: {
+      auto map = root.AsMap();
+      auto keys = map.Keys();
+      auto values = map.Values();
+      h = Hash::Mix(Hash::Mix(seed, FBT_MAP), map.size());
+      for (size_t i = 0; i < map.size(); i++) {
+        auto key = keys[i].AsKey();
+        h = CanonicalHash(values[i], Hash::Bytes(h, FBT_KEY, key, strlen(key)));
+      }
+      break;
+    }
+    default:
+      // Vectors, which are the same typed or not.
+      if (root.IsFixedTypedVector()) {
+        auto vec = root.AsFixedTypedVector();
+        h = Hash::Mix(Hash::Mix(seed, FBT_VECTOR), vec.size());
+        for (size_t i = 0; i < vec.size(); i++) h = CanonicalHash(vec[i], h);
+      } else if (root.IsTypedVector()) {
+        auto vec = root.AsTypedVector();
+        h = Hash::Mix(Hash::Mix(seed, FBT_VECTOR), vec.size());
+        for (size_t i = 0; i < vec.size(); i++) h = CanonicalHash(vec[i], h);
+      } else {
+        auto vec = root.AsVector();
+        h = Hash::Mix(Hash::Mix(seed, FBT_VECTOR), vec.size());
+        for (size_t i = 0; i < vec.size(); i++) h = CanonicalHash(vec[i], h);
+      }
+  }
+  // The XXH64 avalanche.
+  h ^= h >> 33;
+  h *= 0xC2B2AE3D27D4EB4FULL;
+  h ^= h >> 29;
+  h *= 0x165667B19E3779F9ULL;
+  h ^= h >> 32;
+  return h;
+}
+
+// One step of a path from the root of a FlexBuffer: a key of a map, or an
+// index of a vector. Paths can be written as lists, such as
+// { "servers", 2, "port" }.
+struct PathStep {
+  PathStep(const char *k) : key(k), index(0) {}
+  PathStep(const std::string &k) : key(k.c_str()), index(0) {}
+  PathStep(int i) : key(nullptr), index(static_cast<size_t>(i)) {}
+  PathStep(size_t i) : key(nullptr), index(i) {}
+
+  const char *key;  // nullptr for an index.
+  size_t index;
+};
+
+typedef std::vector<PathStep> Path;
+
+// Edits a FlexBuffer without building it again, for changing a few values
+// of a large document:
+//
+//   flexbuffers::Editor editor(buf);
+//   editor.SetInt({ "servers", 2, "port" }, 8080);
+//   editor.SetString({ "owner" }, "ops");  // Adds the key if it's new.
+//   send(editor.GetBuffer());
+//
+// A scalar that fits where the old one is (see Reference::MutateInt() etc.)
+// is changed in place. Strings never are, as other values may share them
+// (BUILDER_FLAG_SHARE_STRINGS). Otherwise the value is appended to the buffer,
+// followed by new copies of the vectors and maps on its path, which refer to
+// the unchanged values where they are, and a new root. That costs the size
+// of those vectors and maps rather than of the document, but leaves the old
+// copies unused in the buffer, until Compact() builds it again.
+//
+// Setters return false if the path doesn't exist, or when the value can't be
+// stored there (a value of another type in a typed vector, a new element of
+// a fixed size vector).
+class Editor {
+ public:
+  Editor(const uint8_t *buf, size_t size,
+         BuilderFlag flags = BUILDER_FLAG_SHARE_KEYS)
+      : flags_(flags), builder_(new Builder(size + 256, EditFlags(flags))) {
+    builder_->buf_.assign(buf, buf + size);
+  }
+  explicit Editor(const std::vector<uint8_t> &buf,
+                  BuilderFlag flags = BUILDER_FLAG_SHARE_KEYS)
+      : flags_(flags),
+        builder_(new Builder(buf.size() + 256, EditFlags(flags))) {
+    builder_->buf_ = buf;
+  }
+
+  // Valid until the next edit.
+  Reference GetRoot() const { return flexbuffers::GetRoot(GetBuffer()); }
+  const std::vector<uint8_t> &GetBuffer() const { return builder_->buf_; }
+  size_t GetSize() const { return builder_->buf_.size(); }
+
+  // The last step of the path may be a key the map doesn't have yet, or an
+  // index one past the end of a vector, which appends to it.
+  bool SetInt(const Path &path, int64_t i) {
+    return Set(path, FBT_INT,
+               [&](Reference r) { return r.MutateInt(i); },
+               [&]() { builder_->Int(i); });
+  }
+
+  bool SetUInt(const Path &path, uint64_t u) {
+    return Set(path, FBT_UINT,
+               [&](Reference r) { return r.MutateUInt(u); },
+               [&]() { builder_->UInt(u); });
+  }
+
+  bool SetDouble(const Path &path, double d) {
+    return Set(path, FBT_FLOAT,
+               [&](Reference r) { return r.MutateFloat(d); },
+               [&]() { builder_->Double(d); });
+  }
+
+  bool SetBool(const Path &path, bool b) {
+    return Set(path, FBT_BOOL,
+               [&](Reference r) { return r.MutateBool(b); },
+               [&]() { builder_->Bool(b); });
+  }
+
+  bool SetString(const Path &path, const char *str, size_t len) {
+    return Set(
+        path, FBT_STRING, [](Reference) { return false; },
+        [&]() { builder_->String(str, len); });
+  }
+  bool SetString(const Path &path, const char *str) {
+    return SetString(path, str, strlen(str));
+  }
+  bool SetString(const Path &path, const std::string &str) {
+    return SetString(path, str.c_str(), str.size());
+  }
+
+  bool SetNull(const Path &path) {
+    return Set(
+        path, FBT_NULL, [](Reference r) { return r.IsNull(); },
+        [&]() { builder_->Null(); });
+  }
+
+  // Sets a value to the root of another FlexBuffer, such as a map made with
+  // a Builder. Its bytes are appended as they are.
+  bool SetFlexBuffer(const Path &path, const uint8_t *buf, size_t size) {
+    auto root = flexbuffers::GetRoot(buf, size);
+    return Set(
+        path, root.GetType(), [](Reference) { return false; },
+        [&]() {
+          // Keep the alignment the buffer was built with.
+          auto &dest = builder_->buf_;
+          dest.resize(dest.size() + flatbuffers::PaddingBytes(
+                                        dest.size(), sizeof(uint64_t)));
+          dest.insert(dest.end(), buf, buf + size);
+          builder_->stack_.push_back(ValueOf(flexbuffers::GetRoot(
+              flatbuffers::vector_data(dest) + dest.size() - size, size)));
+        });
+  }
+  bool SetFlexBuffer(const Path &path, const std::vector<uint8_t> &buf) {
+    return SetFlexBuffer(path, flatbuffers::vector_data(buf), buf.size());
+  }
+
+  // Removes a key from a map, or an element from a vector.
+  bool Erase(const Path &path) {
+    std::vector<Level> levels;
+    Reference leaf;
+    if (path.empty() || !Walk(path, false, &levels, &leaf)) return false;
+    if (IsFixedTypedVector(levels.back().type)) return false;
+    Rewrite(path, levels, true);
+    return true;
+  }
+
+  // Builds the buffer again without the values that edits left unused, in
+  // canonical form with BUILDER_FLAG_CANONICAL.
+  void Compact() {
+    std::unique_ptr<Builder> compact(new Builder(GetSize(), flags_));
+    compact->Add(GetRoot());
+    compact->Finish();
+    compact->stack_.clear();
+    compact->flags_ = EditFlags(flags_);
+    builder_.swap(compact);
+  }
+
+ private:
+  // Edits append to the buffer, only Compact() makes it canonical.
+  static BuilderFlag EditFlags(BuilderFlag flags) {
+    return static_cast<BuilderFlag>(flags & ~BUILDER_FLAG_CANONICAL);
+  }
+
+  FLATBUFFERS_DELETE_FUNC(Editor(const Editor &));
+  FLATBUFFERS_DELETE_FUNC(Editor &operator=(const Editor &));
+
+  // A vector or map on the path to the value edited, by its offset in the
+  // buffer, which may move while the new copies are written.
+  struct Level {
+    size_t loc;
+    uint8_t byte_width;
+    Type type;
+    size_t size;
+    size_t index;  // Of the next step.
+    bool found;    // Whether the key or index of the next step is there.
+  };
+
+  template<typename M, typename W>
+  bool Set(const Path &path, Type type, M mutate, W write) {
+    std::vector<Level> levels;
+    Reference leaf;
+    if (!Walk(path, true, &levels, &leaf)) return false;
+    if (path.empty() || levels.back().found) {
+      if (mutate(leaf)) return true;
+    }
+    if (!levels.empty()) {
+      auto &level = levels.back();
+      if (IsFixedTypedVector(level.type) && !level.found) return false;
+      if (level.type != FBT_MAP && level.type != FBT_VECTOR &&
+          ElementType(level) != type) {
+        return false;
+      }
+    }
+    write();
+    Rewrite(path, levels, false);
+    return true;
+  }
+
+  static Type ElementType(const Level &level) {
+    if (IsTypedVector(level.type)) return ToTypedVectorElementType(level.type);
+    uint8_t len;
+    return ToFixedTypedVectorElementType(level.type, &len);
+  }
+
+  // Finds the vectors and maps on `path`, and the value it leads to. The
+  // last step may be a new key or the end of a vector if `create`.
+  bool Walk(const Path &path, bool create, std::vector<Level> *levels,
+            Reference *leaf) const {
+    auto base = flatbuffers::vector_data(builder_->buf_);
+    auto ref = GetRoot();
+    for (size_t i = 0; i < path.size(); i++) {
+      auto &step = path[i];
+      auto last = i + 1 == path.size();
+      if (!ref.IsAnyVector() || (step.key != nullptr) != ref.IsMap()) {
+        return false;
+      }
+      Level level;
+      level.loc = static_cast<size_t>(ref.Indirect() - base);
+      level.byte_width = ref.byte_width_;
+      level.type = ref.type_;
+      if (ref.IsMap()) {
+        auto map = ref.AsMap();
+        level.size = map.size();
+        level.found = Map::FindKey(map.Keys(), step.key, &level.index);
+        ref = level.found ? map.Values()[level.index] : Reference();
+      } else if (ref.IsFixedTypedVector()) {
+        auto vec = ref.AsFixedTypedVector();
+        level.size = vec.size();
+        level.index = step.index;
+        level.found = step.index < level.size;
+        ref = vec[step.index];
+      } else {
+        level.size = ref.IsTypedVector() ? ref.AsTypedVector().size()
+                                         : ref.AsVector().size();
+        level.index = step.index;
+        level.found = step.index < level.size;
+        ref = ref.IsTypedVector() ? ref.AsTypedVector()[step.index]
+                                  : ref.AsVector()[step.index];
+        if (!level.found && step.index != level.size) return false;
+      }
+      if (!level.found && !(create && last)) return false;
+      levels->push_back(level);
+    }
+    *leaf = ref;
+    return true;
+  }
+
+  // A Builder::Value for a value of the buffer.
+  Builder::Value ValueOf(const Reference &ref) const {
+    switch (ref.type_) {
+      case FBT_NULL: return Builder::Value();
+      case FBT_INT: {
+        auto i = ref.AsInt64();
+        return Builder::Value(i, FBT_INT, WidthI(i));
+      }
+      case FBT_UINT: {
+        auto u = ref.AsUInt64();
+        return Builder::Value(u, FBT_UINT, WidthU(u));
+      }
+      case FBT_FLOAT: return Builder::Value(ref.AsDouble());
+      case FBT_BOOL: return Builder::Value(ref.AsBool());
+      default: {
+        auto loc = ref.Indirect() - flatbuffers::vector_data(builder_->buf_);
+        return Builder::Value(static_cast<uint64_t>(loc), ref.type_,
+                              Builder::WidthB(ref.byte_width_));
+      }
+    }
+  }
+
+  // Writes new copies of the vectors and maps of `levels`, bottom up, with
+  // the value on top of the stack (unless `erase`) at the end of the path,
+  // and a new root.
+  void Rewrite(const Path &path, const std::vector<Level> &levels,
+               bool erase) {
+    auto &stack = builder_->stack_;
+    for (size_t l = levels.size(); l-- > 0;) {
+      auto &level = levels[l];
+      auto last = l + 1 == levels.size();
+      // The value to put at level.index, unless erasing it.
+      auto value = erase && last ? Builder::Value() : stack.back();
+      if (!(erase && last)) stack.pop_back();
+      if (level.type == FBT_MAP) {
+        auto start = stack.size();
+        if (last && (erase || !level.found)) {
+          // The keys change, make a new map.
+          if (!erase) builder_->Key(path[l].key);
+          auto new_key = erase ? Builder::Value() : stack.back();
+          stack.resize(start);
+          auto map = Map(Data(level), level.byte_width);
+          auto keys = map.Keys();
+          auto values = map.Values();
+          for (size_t i = 0; i < level.size; i++) {
+            if (erase && i == level.index) continue;
+            stack.push_back(ValueOf(keys[i]));
+            stack.push_back(ValueOf(values[i]));
+          }
+          if (!erase) {
+            stack.push_back(new_key);
+            stack.push_back(value);
+          }
+          builder_->EndMap(start);
+        } else {
+          // Only a value changes, keep the keys vector.
+          auto map = Map(Data(level), level.byte_width);
+          auto keys_ref = ValueOfKeys(map);
+          auto values = map.Values();
+          for (size_t i = 0; i < level.size; i++) {
+            stack.push_back(i == level.index ? value : ValueOf(values[i]));
+          }
+          auto vec = builder_->CreateVector(start, level.size, 1, false, false,
+                                            &keys_ref);
+          stack.resize(start);
+          stack.push_back(vec);
+        }
+      } else {
+        auto start = stack.size();
+        auto typed = level.type != FBT_VECTOR;
+        auto fixed = IsFixedTypedVector(level.type);
+        auto data = Data(level);
+        for (size_t i = 0; i < level.size; i++) {
+          if (i == level.index) {
+            if (!(erase && last)) stack.push_back(value);
+          } else {
+            stack.push_back(ValueOf(Element(level, data, i)));
+          }
+        }
+        if (!level.found) stack.push_back(value);
+        auto vec = builder_->CreateVector(start, stack.size() - start, 1, typed,
+                                          fixed);
+        // Without elements to take it from, keep the type of the old vector.
+        if (typed && stack.size() == start) vec.type_ = level.type;
+        stack.resize(start);
+        stack.push_back(vec);
+      }
+    }
+    builder_->Finish();
+    stack.clear();
+  }
+
+  const uint8_t *Data(const Level &level) const {
+    return flatbuffers::vector_data(builder_->buf_) + level.loc;
+  }
+
+  static Reference Element(const Level &level, const uint8_t *data,
+                           size_t i) {
+    if (level.type == FBT_VECTOR) {
+      return Vector(data, level.byte_width)[i];
+    } else if (IsTypedVector(level.type)) {
+      return TypedVector(data, level.byte_width,
+                         ToTypedVectorElementType(level.type))[i];
+    } else {
+      uint8_t len;
+      auto type = ToFixedTypedVectorElementType(level.type, &len);
+      return FixedTypedVector(data, level.byte_width, type, len)[i];
+    }
+  }
+
+  Builder::Value ValueOfKeys(const Map &map) const {
+    auto keys = map.Keys();
+    auto loc = keys.data_ - flatbuffers::vector_data(builder_->buf_);
+    return Builder::Value(static_cast<uint64_t>(loc), FBT_VECTOR_KEY,
+                          Builder::WidthB(keys.byte_width_));
+  }
+
+  BuilderFlag flags_;
+  // Swapped for the one that built the compacted buffer, whose pools of
+  // shared keys and strings are for that buffer.
+  std::unique_ptr<Builder> builder_;
+};
+
+// A path to look up in many FlexBuffers, such as a field read from every log
+// record:
+//
+//   flexbuffers::CompiledPath status;
+//   status.Parse("$.response.status");  // Or "/response/status".
+//   for (...) {
+//     if (status.Evaluate(GetRoot(record)).AsInt64() >= 500) ...
+//   }
+//
+// The path is parsed once, and its keys are MapKeys, so maps that share
+// their keys vector find them again with one compare. Paths are either JSON
+// pointers ("/servers/2/port", with ~0 and ~1 for ~ and /), where a number
+// is an index of a vector or a key of a map, or JSONPath: "$" followed by
+// ".key", "['key']" and "[2]" steps.
+//
+// Evaluate() returns a null Reference if the path leads nowhere. Not thread
+// safe, lookups update the MapKeys.
+class CompiledPath {
+ public:
+  CompiledPath() {}
+  explicit CompiledPath(const Path &path) {
+    for (auto it = path.begin(); it != path.end(); ++it) {
+      steps_.push_back(it->key ? Step(it->key) : Step(it->index));
+    }
+  }
+
+  // Returns false, and leaves the path empty, if `path` is malformed.
+  bool Parse(const char *path) {
+    steps_.clear();
+    auto ok = *path == '$' ? ParseJsonPath(path + 1)
+                           : ParseJsonPointer(path);
+    if (!ok) steps_.clear();
+    return ok;
+  }
+  bool Parse(const std::string &path) { return Parse(path.c_str()); }
+
+  size_t size() const { return steps_.size(); }
+
+  Reference Evaluate(const Reference &root) const {
+    auto ref = root;
+    for (auto it = steps_.begin(); it != steps_.end() && !ref.IsNull(); ++it) {
+      ref = it->Apply(ref);
+    }
+    return ref;
+  }
+
+ private:
+  friend class PathSet;
+
+  struct Step {
+    explicit Step(const std::string &k)
+        : key(k), has_key(true), has_index(false), index(0) {}
+    explicit Step(size_t i)
+        : key(""), has_key(false), has_index(true), index(i) {}
+    Step(const std::string &k, size_t i)
+        : key(k), has_key(true), has_index(true), index(i) {}
+
+    Reference Apply(const Reference &ref) const {
+      if (ref.IsMap() && has_key) return ref.AsMap()[key];
+      if (has_index && !ref.IsMap()) {
+        if (ref.IsFixedTypedVector()) return ref.AsFixedTypedVector()[index];
+        if (ref.IsTypedVector()) return ref.AsTypedVector()[index];
+        if (ref.IsVector()) return ref.AsVector()[index];
+      }
+      return Reference(nullptr, 1, NullPackedType());
+    }
+
+    bool operator==(const Step &other) const {
+      return has_key == other.has_key && has_index == other.has_index &&
+             index == other.index && key.str() == other.key.str();
+    }
+
+    MapKey key;
+    bool has_key;
+    bool has_index;
+    size_t index;
   };
 
-  typedef std::set<size_t, KeyOffsetCompare> KeyOffsetMap;
-  typedef std::set<StringOffset, StringOffsetCompare> StringOffsetMap;
+  // Reads the digits of an index, returns false if there are none or too
+  // many.
+  static bool ParseIndex(const char **p, size_t *index) {
+    auto start = *p;
+    *index = 0;
+    while (**p >= '0' && **p <= '9') {
+      *index = *index * 10 + static_cast<size_t>(**p - '0');
+      ++*p;
+    }
+    auto digits = *p - start;
+    return digits > 0 && digits <= 9 && (digits == 1 || *start != '0');
+  }
+
+  bool ParseJsonPointer(const char *p) {
+    if (!*p) return true;  // The root.
+    if (*p != '/') return false;
+    while (*p == '/') {
+      std::string key;
+      for (p++; *p && *p != '/'; p++) {
+        if (*p == '~') {
+          p++;
+          if (*p != '0' && *p != '1') return false;
+          key += *p == '0' ? '~' : '/';
+        } else {
+          key += *p;
+        }
+      }
+      auto digits = key.c_str();
+      size_t index;
+      if (ParseIndex(&digits, &index) && !*digits) {
+        steps_.push_back(Step(key, index));
+      } else {
+        steps_.push_back(Step(key));
+      }
+    }
+    return true;
+  }
+
+  bool ParseJsonPath(const char *p) {
+    while (*p) {
+      if (*p == '.') {
+        auto start = ++p;
+        while (*p && *p != '.' && *p != '[') p++;
+        if (p == start) return false;
+        steps_.push_back(Step(std::string(start, p)));
+      } else if (*p == '[') {
+        p++;
+        if (*p == '\'' || *p == '"') {
+          auto quote = *p++;
+          std::string key;
+          for (; *p != quote; p++) {
+            if (*p == '\\') p++;
+            if (!*p) return false;
+            key += *p;
+          }
+          p++;
+          steps_.push_back(Step(key));
+        } else {
+          size_t index;
+          if (!ParseIndex(&p, &index)) return false;
+          steps_.push_back(Step(index));
+        }
+        if (*p++ != ']') return false;
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<Step> steps_;
+};
+
+// Paths evaluated together, such as the fields a log filter reads from
+// every record:
+//
+//   flexbuffers::PathSet fields;
+//   fields.Add("$.response.status");  // values[0]
+//   fields.Add("$.request.user");     // values[1]
+//   std::vector<flexbuffers::Reference> values;
+//   for (...) {
+//     fields.Evaluate(GetRoot(record), &values);
+//     if (values[0].AsInt64() >= 500) Log(values[1].AsString().c_str());
+//   }
+//
+// The paths are kept as a tree, so their common steps are taken once: above,
+// "request" and "response" are looked up in the root map once each, however
+// many fields are read from them. Not thread safe, like CompiledPath.
+class PathSet {
+ public:
+  PathSet() : num_paths_(0) {
+    nodes_.push_back(Node(CompiledPath::Step(static_cast<size_t>(0))));
+  }
+
+  // Returns false if `path` is malformed (see CompiledPath), otherwise its
+  // results are at `*index`, which is the number of paths added before it.
+  bool Add(const char *path, size_t *index = nullptr) {
+    CompiledPath compiled;
+    if (!compiled.Parse(path)) return false;
+    auto i = Add(compiled);
+    if (index) *index = i;
+    return true;
+  }
+
+  size_t Add(const CompiledPath &path) {
+    size_t node = 0;
+    for (auto it = path.steps_.begin(); it != path.steps_.end(); ++it) {
+      auto &children = nodes_[node].children;
+      auto child = children.begin();
+      while (child != children.end() && !(nodes_[*child].step == *it)) {
+        ++child;
+      }
+      if (child != children.end()) {
+        node = *child;
+      } else {
+        children.push_back(nodes_.size());
+        node = nodes_.size();
+        nodes_.push_back(Node(*it));
+      }
+    }
+    nodes_[node].paths.push_back(num_paths_);
+    return num_paths_++;
+  }
+
+  size_t size() const { return num_paths_; }
+
+  // Sets `results` to the value of each path, in the order they were added.
+  void Evaluate(const Reference &root, std::vector<Reference> *results) const {
+    results->assign(num_paths_, Reference(nullptr, 1, NullPackedType()));
+    Evaluate(0, root, results);
+  }
+
+ private:
+  struct Node {
+    explicit Node(const CompiledPath::Step &s) : step(s) {}
+
+    CompiledPath::Step step;  // From the parent, unused for the root.
+    std::vector<size_t> children;  // Into nodes_.
+    std::vector<size_t> paths;  // The paths ending here.
+  };
+
+  void Evaluate(size_t node, const Reference &ref,
+                std::vector<Reference> *results) const {
+    auto &n = nodes_[node];
+    for (auto it = n.paths.begin(); it != n.paths.end(); ++it) {
+      (*results)[*it] = ref;
+    }
+    // Results below a null are already null.
+    if (ref.IsNull()) return;
+    for (auto it = n.children.begin(); it != n.children.end(); ++it) {
+      Evaluate(*it, nodes_[*it].step.Apply(ref), results);
+    }
+  }
 
-  KeyOffsetMap key_pool;
-  StringOffsetMap string_pool;
+  std::vector<Node> nodes_;  // The root first.
+  size_t num_paths_;
 };
 
 }  // namespace flexbuffers
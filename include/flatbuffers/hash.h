@@ -20,7 +20,7 @@
 #include <cstdint>
 #include <cstring>
 
-#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/base.h"
 
 namespace flatbuffers {
 
@@ -67,6 +67,167 @@ template<> inline uint16_t HashFnv1a<uint16_t>(const char *input) {
   return (hash >> 16) ^ (hash & 0xffff);
 }
 
+// XXH64 of a range of bytes, for hashing whole buffers: it reads 32 bytes per
+// step where the FNV hashes above go byte by byte.
+inline uint64_t HashXxh64(const void *data, size_t size, uint64_t seed = 0) {
+  const uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+  const uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+  const uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+  const uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+  const uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+  struct Xxh64 {
+    static uint64_t Rotl(uint64_t x, int r) {
+      return (x << r) | (x >> (64 - r));
+    }
+    static uint64_t Read64(const uint8_t *p) {
+      uint64_t v;
+      memcpy(&v, p, sizeof(v));
+      return EndianScalar(v);
+    }
+    static uint64_t Read32(const uint8_t *p) {
+      uint32_t v;
+      memcpy(&v, p, sizeof(v));
+      return EndianScalar(v);
+    }
+    static uint64_t Round(uint64_t acc, uint64_t input) {
+      return Rotl(acc + input * kPrime2, 31) * kPrime1;
+    }
+    static uint64_t Merge(uint64_t acc, uint64_t val) {
+      return (acc ^ Round(0, val)) * kPrime1 + kPrime4;
+    }
+  };
+  auto p = static_cast<const uint8_t *>(data);
+  auto end = p + size;
+  uint64_t h;
+  if (size >= 32) {
+    uint64_t v1 = seed + kPrime1 + kPrime2, v2 = seed + kPrime2, v3 = seed,
+             v4 = seed - kPrime1;
+    for (; end - p >= 32; p += 32) {
+      v1 = Xxh64::Round(v1, Xxh64::Read64(p));
+      v2 = Xxh64::Round(v2, Xxh64::Read64(p + 8));
+      v3 = Xxh64::Round(v3, Xxh64::Read64(p + 16));
+      v4 = Xxh64::Round(v4, Xxh64::Read64(p + 24));
+    }
+    h = Xxh64::Rotl(v1, 1) + Xxh64::Rotl(v2, 7) + Xxh64::Rotl(v3, 12) +
+        Xxh64::Rotl(v4, 18);
+    h = Xxh64::Merge(h, v1);
+    h = Xxh64::Merge(h, v2);
+    h = Xxh64::Merge(h, v3);
+    h = Xxh64::Merge(h, v4);
+  } else {
+    h = seed + kPrime5;
+  }
+  h += size;
+  for (; end - p >= 8; p += 8) {
+    h = Xxh64::Rotl(h ^ Xxh64::Round(0, Xxh64::Read64(p)), 27) * kPrime1 +
+        kPrime4;
+  }
+  if (end - p >= 4) {
+    h = Xxh64::Rotl(h ^ (Xxh64::Read32(p) * kPrime1), 23) * kPrime2 + kPrime3;
+    p += 4;
+  }
+  for (; p != end; p++) {
+    h = Xxh64::Rotl(h ^ (*p * kPrime5), 11) * kPrime1;
+  }
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= kPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+// Hash of the bytes of a string, for StringOffsetPool. Reads 8 bytes at a
+// time, and differs between little and big endian machines.
+__supress_ubsan__("unsigned-integer-overflow")
+inline uint32_t HashStringBytes(const char *str, size_t len) {
+  const uint64_t kMul = 0x9E3779B97F4A7C15ULL;
+  uint64_t h = static_cast<uint64_t>(len) * kMul;
+  uint64_t word;
+  for (; len >= sizeof(word); str += sizeof(word), len -= sizeof(word)) {
+    memcpy(&word, str, sizeof(word));
+    h = (h ^ word) * kMul;
+    h ^= h >> 29;
+  }
+  if (len) {
+    word = 0;
+    memcpy(&word, str, len);
+    h = (h ^ word) * kMul;
+  }
+  h ^= h >> 32;
+  h *= kMul;
+  return static_cast<uint32_t>(h >> 32);
+}
+
+// The strings written to a buffer being built, by their offsets, for builders
+// that write equal strings once. A string is hashed before it is written and
+// looked up among those with the same hash and length, so a hit writes
+// nothing. Open addressing keeps the slots in one array of at most twice the
+// number of strings.
+class StringOffsetPool {
+ public:
+  StringOffsetPool() : size_(0) {}
+
+  // Looks for a string of `len` bytes hashed by HashStringBytes(), calling
+  // `equal(offset)` to compare the string at an offset with it.
+  template<typename Equal>
+  bool Find(uint32_t hash, size_t len, const Equal &equal,
+            size_t *offset) const {
+    if (slots_.empty()) return false;
+    auto mask = slots_.size() - 1;
+    for (auto i = hash & mask; slots_[i].offset; i = (i + 1) & mask) {
+      const Slot &slot = slots_[i];
+      if (slot.hash == hash && slot.len == len && equal(slot.offset - 1)) {
+        *offset = slot.offset - 1;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Adds a string that Find() didn't find.
+  void Insert(uint32_t hash, size_t len, size_t offset) {
+    if (2 * (size_ + 1) > slots_.size()) Grow();
+    Slot slot = { offset + 1, len, hash };
+    Place(slot);
+    size_++;
+  }
+
+  // Keeps the slots for the next buffer.
+  void clear() {
+    std::fill(slots_.begin(), slots_.end(), Slot());
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+
+ private:
+  struct Slot {
+    size_t offset;  // Plus one, 0 for an empty slot.
+    size_t len;
+    uint32_t hash;
+  };
+
+  void Place(const Slot &slot) {
+    auto mask = slots_.size() - 1;
+    auto i = slot.hash & mask;
+    while (slots_[i].offset) i = (i + 1) & mask;
+    slots_[i] = slot;
+  }
+
+  void Grow() {
+    std::vector<Slot> old;
+    old.swap(slots_);
+    slots_.resize(old.empty() ? 16 : old.size() * 2, Slot());
+    for (auto it = old.begin(); it != old.end(); ++it) {
+      if (it->offset) Place(*it);
+    }
+  }
+
+  std::vector<Slot> slots_;
+  size_t size_;
+};
+
 template<typename T> struct NamedHashFunction {
   const char *name;
 
@@ -589,11 +589,18 @@ struct IDLOptions {
   std::vector<std::string> cpp_includes;
   std::string cpp_std;
   bool cpp_static_reflection;
+  bool cpp_gen_json;
+  bool cpp_gen_packed_size;
   std::string proto_namespace_suffix;
   std::string filename_suffix;
   std::string filename_extension;
   bool no_warnings;
   std::string project_root;
+  // Text generation prints vectors of tables with more than `json_chunk_size`
+  // elements in chunks of that size on up to `json_threads` threads. A chunk
+  // size of 0 prints every vector on the calling thread.
+  int json_threads;
+  size_t json_chunk_size;
 
   // Possible options for the more general generator below.
   enum Language {
@@ -677,10 +684,14 @@ struct IDLOptions {
         java_primitive_has_method(false),
         cs_gen_json_serializer(false),
         cpp_static_reflection(false),
+        cpp_gen_json(false),
+        cpp_gen_packed_size(false),
         filename_suffix("_generated"),
         filename_extension(),
         no_warnings(false),
         project_root(""),
+        json_threads(1),
+        json_chunk_size(4096),
         lang(IDLOptions::kJava),
         mini_reflect(IDLOptions::kNone),
         require_explicit_ids(false),
@@ -1054,6 +1065,15 @@ extern bool GenerateTextFromTable(const Parser &parser, const void *table,
                                   std::string *text);
 extern bool GenerateText(const Parser &parser, const void *flatbuffer,
                          std::string *text);
+
+// As above, but streams the text to `sink` in chunks of bounded size, for
+// outputs too large to build in memory. The sink is flushed before returning,
+// false is also returned if it failed to write.
+extern bool GenerateTextFromTable(const Parser &parser, const void *table,
+                                  const std::string &tablename,
+                                  TextSink *sink);
+extern bool GenerateText(const Parser &parser, const void *flatbuffer,
+                         TextSink *sink);
 extern bool GenerateTextFile(const Parser &parser, const std::string &path,
                              const std::string &file_name);
 
@@ -0,0 +1,1126 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_JSON_H_
+#define FLATBUFFERS_JSON_H_
+
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/flexbuffers.h"
+#include "flatbuffers/hash.h"
+#include "flatbuffers/util.h"
+
+#ifndef FLATBUFFERS_MAX_PARSING_DEPTH
+#  define FLATBUFFERS_MAX_PARSING_DEPTH 64
+#endif
+
+namespace flatbuffers {
+
+// Support for the JSON functions generated by flatc with --cpp --gen-json:
+// `FooToJson()` and `FooFromJson()` for every table and struct `Foo`.
+// These produce and accept the same JSON as GenerateText() and Parser, but
+// have field names, defaults and enum names compiled in, so neither the
+// schema nor the Parser is needed at runtime.
+
+// The subset of IDLOptions the generated functions honor, with the same
+// defaults.
+struct JsonOptions {
+  int indent_step;
+  bool strict_json;
+  bool output_default_scalars_in_json;
+  bool output_enum_identifiers;
+  bool natural_utf8;
+  bool allow_non_utf8;
+  bool skip_unexpected_fields_in_json;
+
+  JsonOptions()
+      : indent_step(2),
+        strict_json(false),
+        output_default_scalars_in_json(false),
+        output_enum_identifiers(true),
+        natural_utf8(false),
+        allow_non_utf8(false),
+        skip_unexpected_fields_in_json(false) {}
+};
+
+// The values of an enum in ascending order, and their names.
+struct JsonEnum {
+  size_t num_values;
+  const int64_t *values;
+  const char *const *names;
+  bool bit_flags;
+};
+
+// Formats JSON the way JsonPrinter in idl_gen_text.cpp does. Errors are
+// sticky: generated code keeps going and checks ok() at the end.
+class JsonWriter {
+ public:
+  explicit JsonWriter(std::string &text,
+                      const JsonOptions &opts = JsonOptions())
+      : opts_(opts), text_(text), sink_(nullptr) {
+    Init();
+  }
+
+  // Hands the text to `sink` in chunks while it is generated.
+  explicit JsonWriter(TextSink &sink, const JsonOptions &opts = JsonOptions())
+      : opts_(opts), text_(sink.buffer()), sink_(&sink) {
+    Init();
+  }
+
+  const JsonOptions &options() const { return opts_; }
+
+  // False once a string was not valid UTF-8 or the sink failed.
+  bool ok() const { return ok_; }
+
+  void StartObject() {
+    text_ += '{';
+    Open();
+  }
+
+  void Key(const char *name) {
+    if (!first_) Comma();
+    first_ = false;
+    NewLine();
+    AddIndent();
+    if (opts_.strict_json) text_ += '\"';
+    text_ += name;
+    if (opts_.strict_json) text_ += '\"';
+    text_ += ": ";
+  }
+
+  void EndObject() { Close('}'); }
+
+  void StartArray() {
+    text_ += '[';
+    Open();
+    NewLine();
+  }
+
+  void Element() {
+    if (!first_) {
+      Comma();
+      NewLine();
+    }
+    first_ = false;
+    AddIndent();
+  }
+
+  void EndArray() { Close(']'); }
+
+  void Bool(bool b) { text_ += b ? "true" : "false"; }
+
+  template<typename T> void Number(T val) { text_ += NumToString(val); }
+
+  // Prints the name of the enum value, a list of names for bit_flags, or
+  // the number if neither applies.
+  template<typename T> void Enum(T val, const JsonEnum *e) {
+    if (!opts_.output_enum_identifiers ||
+        !EnumName(static_cast<int64_t>(val), *e)) {
+      Number(val);
+    }
+  }
+
+  void String(const flatbuffers::String *s) {
+    if (!EscapeString(s->c_str(), s->size(), &text_, opts_.allow_non_utf8,
+                      opts_.natural_utf8)) {
+      ok_ = false;
+    }
+  }
+
+  void FlexBuffer(const Vector<uint8_t> *v) {
+    flexbuffers::GetRoot(v->data(), v->size())
+        .ToString(true, opts_.strict_json, text_, sink_);
+  }
+
+  // Ends the text like GenerateText() does and flushes the sink.
+  bool Finish() {
+    NewLine();
+    if (sink_ && !sink_->Flush()) ok_ = false;
+    return ok_;
+  }
+
+ private:
+  void Init() {
+    indent_ = 0;
+    first_ = true;
+    ok_ = true;
+  }
+
+  void Open() {
+    indent_ += (std::max)(opts_.indent_step, 0);
+    first_ = true;
+  }
+
+  void Close(char c) {
+    indent_ -= (std::max)(opts_.indent_step, 0);
+    NewLine();
+    AddIndent();
+    text_ += c;
+    first_ = false;
+  }
+
+  // Text before a comma is final, so that is where the sink gets it.
+  void Comma() {
+    text_ += ',';
+    if (sink_ && !sink_->MaybeFlush()) ok_ = false;
+  }
+
+  void NewLine() {
+    if (opts_.indent_step >= 0) text_ += '\n';
+  }
+
+  void AddIndent() { text_.append(static_cast<size_t>(indent_), ' '); }
+
+  bool EnumName(int64_t val, const JsonEnum &e) {
+    for (size_t i = 0; i < e.num_values; i++) {
+      if (e.values[i] == val) {
+        text_ += '\"';
+        text_ += e.names[i];
+        text_ += '\"';
+        return true;
+      }
+    }
+    if (!val || !e.bit_flags) return false;
+    const auto entry_len = text_.length();
+    const auto u64 = static_cast<uint64_t>(val);
+    uint64_t mask = 0;
+    text_ += '\"';
+    for (size_t i = 0; i < e.num_values; i++) {
+      const auto f = static_cast<uint64_t>(e.values[i]);
+      if (f & u64) {
+        mask |= f;
+        text_ += e.names[i];
+        text_ += ' ';
+      }
+    }
+    if (mask && u64 == mask) {
+      text_[text_.length() - 1] = '\"';
+      return true;
+    }
+    text_.resize(entry_len);
+    return false;
+  }
+
+  const JsonOptions opts_;
+  std::string &text_;
+  TextSink *sink_;
+  int indent_;
+  bool first_;
+  bool ok_;
+};
+
+// Reads the JSON accepted by Parser: comments, unquoted keys and enum
+// identifiers, single quoted strings and (unless strict_json) trailing
+// commas. Functions return false on errors, after which error() describes
+// the first one. NextField() and NextElement() also return false at the
+// end of their object or array, ok() tells the two apart.
+class JsonReader {
+ public:
+  explicit JsonReader(const char *json,
+                      const JsonOptions &opts = JsonOptions())
+      : opts_(opts) {
+    Init(json, strlen(json));
+  }
+
+  JsonReader(const char *json, size_t length,
+             const JsonOptions &opts = JsonOptions())
+      : opts_(opts) {
+    Init(json, length);
+  }
+
+  explicit JsonReader(const std::string &json,
+                      const JsonOptions &opts = JsonOptions())
+      : opts_(opts) {
+    Init(json.c_str(), json.size());
+  }
+
+  // clang-format off
+  #ifdef FLATBUFFERS_HAS_STRING_VIEW
+  explicit JsonReader(flatbuffers::string_view json,
+                      const JsonOptions &opts = JsonOptions())
+      : opts_(opts) {
+    Init(json.data(), json.size());
+  }
+  #endif // FLATBUFFERS_HAS_STRING_VIEW
+  // clang-format on
+
+  const JsonOptions &options() const { return opts_; }
+
+  bool ok() const { return error_.empty(); }
+  const std::string &error() const { return error_; }
+
+  // Records `msg` as the error, unless there already is one.
+  bool Error(const std::string &msg) {
+    if (error_.empty()) {
+      error_ = msg + " (at offset " + NumToString(Position()) + ")";
+    }
+    return false;
+  }
+
+  size_t Position() const { return static_cast<size_t>(cur_ - begin_); }
+
+  // Continues reading at a position previously returned by Position().
+  void Seek(size_t pos) { cur_ = begin_ + pos; }
+
+  // Whether the next value starts with `c`.
+  bool Peek(char c) {
+    SkipWhitespace();
+    return cur_ < end_ && *cur_ == c;
+  }
+
+  bool StartObject() { return Open('{'); }
+
+  // Reads the key of the next field of the current object. Fields set to
+  // `null` are skipped, as if they were not there.
+  bool NextField() {
+    for (;;) {
+      if (!NextKey()) return false;
+      if (!ReadNull()) return true;
+    }
+  }
+
+  const std::string &key() const { return key_; }
+  bool KeyIs(const char *name) const { return key_ == name; }
+
+  // Skips the value of a field that is not in the schema, if the options
+  // allow that.
+  bool UnknownField() {
+    if (!opts_.skip_unexpected_fields_in_json) {
+      return Error("unknown field: " + key_);
+    }
+    return SkipValue();
+  }
+
+  bool StartArray() { return Open('['); }
+  bool NextElement() { return Next(']'); }
+
+  // Reads a number or boolean, which may be quoted.
+  template<typename T> bool Scalar(T *val) {
+    return ReadToken() && TokenToNumber(val);
+  }
+
+  // Like Scalar(), but also accepts enum identifiers, separated by spaces
+  // to combine flags.
+  template<typename T> bool Enum(const JsonEnum *e, T *val) {
+    if (!ReadToken()) return false;
+    if (str_.empty() || is_digit(str_[0]) || str_[0] == '-' ||
+        str_[0] == '+' || str_ == "true" || str_ == "false") {
+      return TokenToNumber(val);
+    }
+    int64_t bits = 0;
+    for (size_t i = 0; i < str_.size();) {
+      if (str_[i] == ' ') {
+        i++;
+        continue;
+      }
+      auto end = str_.find(' ', i);
+      if (end == std::string::npos) end = str_.size();
+      // Allow qualified names, like `Color.Red`.
+      auto start = str_.rfind('.', end - 1);
+      start = start == std::string::npos || start < i ? i : start + 1;
+      size_t k = 0;
+      while (k < e->num_values &&
+             str_.compare(start, end - start, e->names[k]) != 0) {
+        k++;
+      }
+      if (k == e->num_values) {
+        return Error("unknown enum value: " + str_.substr(i, end - i));
+      }
+      bits |= e->values[k];
+      i = end;
+    }
+    *val = static_cast<T>(bits);
+    return true;
+  }
+
+  // Like Scalar(), but a string is hashed into the value.
+  template<typename T, typename H>
+  bool Hashed(H (*hash)(const char *), T *val) {
+    if (!Peek('\"') && !Peek('\'')) return Scalar(val);
+    if (!ReadString(&str_)) return false;
+    *val = static_cast<T>(hash(str_.c_str()));
+    return true;
+  }
+
+  bool String(FlatBufferBuilder &fbb, Offset<flatbuffers::String> *out,
+              bool shared = false) {
+    if (!Peek('\"') && !Peek('\'')) return Error("expecting a string");
+    if (!ReadString(&str_)) return false;
+    *out = shared ? fbb.CreateSharedString(str_) : fbb.CreateString(str_);
+    return true;
+  }
+
+  // Reads any JSON value into a FlexBuffer, stored as a vector of ubyte.
+  bool FlexBuffer(FlatBufferBuilder &fbb, Offset<Vector<uint8_t>> *out) {
+    flexbuffers::Builder builder(1024, flexbuffers::BUILDER_FLAG_SHARE_ALL);
+    if (!FlexValue(builder)) return false;
+    builder.Finish();
+    fbb.ForceVectorAlignment(builder.GetSize(), sizeof(uint8_t),
+                             sizeof(largest_scalar_t));
+    *out = fbb.CreateVector(builder.GetBuffer());
+    return true;
+  }
+
+  bool SkipValue() {
+    if (Peek('{')) {
+      if (!StartObject()) return false;
+      while (NextKey()) {
+        if (!SkipValue()) return false;
+      }
+      return ok();
+    }
+    if (Peek('[')) {
+      if (!StartArray()) return false;
+      while (NextElement()) {
+        if (!SkipValue()) return false;
+      }
+      return ok();
+    }
+    return ReadToken();
+  }
+
+  // Checks that nothing but whitespace follows the root value.
+  bool Finish() {
+    SkipWhitespace();
+    if (cur_ != end_) return Error("unexpected text after the root value");
+    return ok();
+  }
+
+ private:
+  void Init(const char *json, size_t length) {
+    begin_ = cur_ = json;
+    end_ = json + length;
+    depth_ = 0;
+    first_ = true;
+  }
+
+  void SkipWhitespace() {
+    while (cur_ < end_) {
+      const char c = *cur_;
+      if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+        cur_++;
+      } else if (c == '/' && cur_ + 1 < end_ && cur_[1] == '/') {
+        while (cur_ < end_ && *cur_ != '\n') cur_++;
+      } else if (c == '/' && cur_ + 1 < end_ && cur_[1] == '*') {
+        cur_ += 2;
+        while (cur_ + 1 < end_ && !(cur_[0] == '*' && cur_[1] == '/')) cur_++;
+        cur_ = cur_ + 1 < end_ ? cur_ + 2 : end_;
+      } else {
+        break;
+      }
+    }
+  }
+
+  bool Open(char c) {
+    if (!Peek(c)) return Error(std::string("expecting: '") + c + "'");
+    if (++depth_ > FLATBUFFERS_MAX_PARSING_DEPTH) {
+      return Error("JSON nested too deep");
+    }
+    cur_++;
+    first_ = true;
+    return true;
+  }
+
+  // Steps over the separator before the next element. Returns false at
+  // `close`, or on an error.
+  bool Next(char close) {
+    SkipWhitespace();
+    if (cur_ < end_ && *cur_ == close) return Close();
+    if (!first_) {
+      if (cur_ == end_ || *cur_ != ',') {
+        return Error(std::string("expecting: ',' or '") + close + "'");
+      }
+      cur_++;
+      SkipWhitespace();
+      if (!opts_.strict_json && cur_ < end_ && *cur_ == close) {
+        return Close();
+      }
+    }
+    if (cur_ == end_) return Error("unexpected end of JSON");
+    first_ = false;
+    return true;
+  }
+
+  bool Close() {
+    cur_++;
+    depth_--;
+    first_ = false;
+    return false;
+  }
+
+  bool NextKey() {
+    if (!Next('}')) return false;
+    if (cur_ < end_ && (*cur_ == '\"' || *cur_ == '\'')) {
+      if (!ReadString(&key_)) return false;
+    } else {
+      if (!ReadBareToken(&key_)) return false;
+    }
+    SkipWhitespace();
+    if (cur_ == end_ || *cur_ != ':') return Error("expecting: ':'");
+    cur_++;
+    return true;
+  }
+
+  bool ReadNull() {
+    SkipWhitespace();
+    if (end_ - cur_ < 4 || strncmp(cur_, "null", 4) != 0 ||
+        (end_ - cur_ > 4 && IsTokenChar(cur_[4]))) {
+      return false;
+    }
+    cur_ += 4;
+    return true;
+  }
+
+  static bool IsTokenChar(char c) {
+    return is_alnum(c) || c == '_' || c == '.' || c == '+' || c == '-';
+  }
+
+  bool ReadBareToken(std::string *s) {
+    const auto start = cur_;
+    while (cur_ < end_ && IsTokenChar(*cur_)) cur_++;
+    if (cur_ == start) return Error("expecting a value");
+    s->assign(start, cur_);
+    return true;
+  }
+
+  // Reads a string, or any other value that isn't an object or array.
+  bool ReadToken() {
+    SkipWhitespace();
+    if (cur_ < end_ && (*cur_ == '\"' || *cur_ == '\'')) {
+      return ReadString(&str_);
+    }
+    return ReadBareToken(&str_);
+  }
+
+  template<typename T> bool TokenToNumber(T *val) {
+    if (str_ == "true" || str_ == "false") {
+      *val = static_cast<T>(str_[0] == 't');
+      return true;
+    }
+    if (!StringToNumber(str_.c_str(), val)) {
+      return Error("invalid number: " + str_);
+    }
+    return true;
+  }
+
+  bool ReadHex(int digits, uint32_t *val) {
+    *val = 0;
+    for (int i = 0; i < digits; i++, cur_++) {
+      if (cur_ == end_ || !is_xdigit(*cur_)) {
+        return Error("escape code must be followed by hex digits");
+      }
+      const char c = *cur_;
+      *val = *val * 16 + static_cast<uint32_t>(is_digit(c) ? c - '0'
+                                               : (c & ~0x20) - 'A' + 10);
+    }
+    return true;
+  }
+
+  bool ReadString(std::string *s) {
+    const char quote = *cur_++;
+    s->clear();
+    for (;;) {
+      if (cur_ == end_) return Error("unterminated string constant");
+      const char c = *cur_;
+      if (c == quote) {
+        cur_++;
+        return true;
+      }
+      if (static_cast<unsigned char>(c) < ' ') {
+        return Error("illegal character in string constant");
+      }
+      if (c != '\\') {
+        if (static_cast<unsigned char>(c) < 0x80 || opts_.allow_non_utf8) {
+          *s += c;
+          cur_++;
+          continue;
+        }
+        // FromUTF8() doesn't know where the input ends, check that first.
+        int len = 0;
+        while (len < 5 && (static_cast<unsigned char>(c) << len) & 0x80) len++;
+        const char *p = cur_;
+        if (end_ - cur_ < len || FromUTF8(&p) < 0) {
+          return Error("illegal UTF-8 sequence");
+        }
+        s->append(cur_, p);
+        cur_ = p;
+        continue;
+      }
+      if (++cur_ == end_) return Error("unterminated string constant");
+      uint32_t ucc;
+      switch (*cur_++) {
+        case 'n': *s += '\n'; break;
+        case 't': *s += '\t'; break;
+        case 'r': *s += '\r'; break;
+        case 'b': *s += '\b'; break;
+        case 'f': *s += '\f'; break;
+        case '\"': *s += '\"'; break;
+        case '\'': *s += '\''; break;
+        case '\\': *s += '\\'; break;
+        case '/': *s += '/'; break;
+        case 'x':
+          if (!ReadHex(2, &ucc)) return false;
+          *s += static_cast<char>(ucc);
+          break;
+        case 'u':
+          if (!ReadHex(4, &ucc)) return false;
+          if (ucc >= 0xDC00 && ucc <= 0xDFFF) {
+            return Error("unpaired low surrogate");
+          }
+          if (ucc >= 0xD800 && ucc <= 0xDBFF) {
+            uint32_t low;
+            if (end_ - cur_ < 2 || cur_[0] != '\\' || cur_[1] != 'u') {
+              return Error("expecting a low surrogate");
+            }
+            cur_ += 2;
+            if (!ReadHex(4, &low)) return false;
+            if (low < 0xDC00 || low > 0xDFFF) {
+              return Error("expecting a low surrogate");
+            }
+            ucc = (((ucc & 0x03FF) << 10) | (low & 0x03FF)) + 0x10000;
+          }
+          ToUTF8(ucc, s);
+          break;
+        default: return Error("unknown escape code in string constant");
+      }
+    }
+  }
+
+  // Mirrors Parser::ParseFlexBufferValue().
+  bool FlexValue(flexbuffers::Builder &builder) {
+    if (Peek('{')) {
+      if (!StartObject()) return false;
+      const auto start = builder.StartMap();
+      while (NextKey()) {
+        builder.Key(key_);
+        if (!FlexValue(builder)) return false;
+      }
+      if (!ok()) return false;
+      builder.EndMap(start);
+      if (builder.HasDuplicateKeys()) {
+        return Error("FlexBuffers map has duplicate keys");
+      }
+      return true;
+    }
+    if (Peek('[')) {
+      if (!StartArray()) return false;
+      const auto start = builder.StartVector();
+      while (NextElement()) {
+        if (!FlexValue(builder)) return false;
+      }
+      if (!ok()) return false;
+      builder.EndVector(start, false, false);
+      return true;
+    }
+    const bool quoted = Peek('\"') || Peek('\'');
+    if (!ReadToken()) return false;
+    if (quoted) {
+      builder.String(str_);
+    } else if (str_ == "true" || str_ == "false") {
+      builder.Bool(str_[0] == 't');
+    } else if (str_ == "null") {
+      builder.Null();
+    } else {
+      int64_t i;
+      double d;
+      if (StringToNumber(str_.c_str(), &i)) {
+        builder.Int(i);
+      } else if (StringToNumber(str_.c_str(), &d)) {
+        builder.Double(d);
+      } else {
+        return Error("invalid value: " + str_);
+      }
+    }
+    return true;
+  }
+
+  const JsonOptions opts_;
+  const char *begin_;
+  const char *cur_;
+  const char *end_;
+  int depth_;
+  bool first_;
+  std::string key_;
+  std::string str_;
+  std::string error_;
+};
+
+// Converts JSON to a FlexBuffer as it arrives, in chunks split anywhere:
+//
+//   flexbuffers::Builder builder;
+//   flatbuffers::JsonToFlexBuffer converter(&builder);
+//   while (auto n = fread(chunk, 1, sizeof(chunk), f)) {
+//     if (!converter.Feed(chunk, n)) break;
+//   }
+//   if (!converter.Finish()) { /* converter.error() */ }
+//   Use(builder.GetBuffer());
+//
+// Accepts the same JSON as Parser::ParseFlexBuffer() and JsonReader, and
+// makes the same FlexBuffer, but goes through the text once, without the
+// tokens of the schema parser. Strings and keys that end in the chunk they
+// start in and have no escapes are written from the chunk, other strings and
+// numbers are collected in buffers that are reused. Converts one JSON value,
+// Finish() finishes the Builder.
+class JsonToFlexBuffer {
+ public:
+  explicit JsonToFlexBuffer(flexbuffers::Builder *builder,
+                            const JsonOptions &opts = JsonOptions())
+      : opts_(opts),
+        builder_(builder),
+        expect_(kValue),
+        lex_(kNone),
+        offset_(0),
+        chunk_(nullptr),
+        cur_(nullptr),
+        end_(nullptr) {}
+
+  // Returns false on errors, after which error() describes the first one.
+  bool Feed(const char *chunk, size_t size) {
+    if (!ok()) return false;
+    chunk_ = cur_ = chunk;
+    end_ = chunk + size;
+    // Continue the string, number or comment the last chunk ended in.
+    if (!Continue()) return false;
+    while (cur_ < end_) {
+      const char c = *cur_;
+      if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+        cur_++;
+      } else if (c == '/') {
+        cur_++;
+        lex_ = kSlash;
+        if (!Comment()) return false;
+      } else if (!Next(c)) {
+        return false;
+      }
+    }
+    offset_ += size;
+    return true;
+  }
+
+  bool Feed(const std::string &chunk) {
+    return Feed(chunk.c_str(), chunk.size());
+  }
+
+  // The end of the JSON: checks the value is complete, and finishes the
+  // Builder.
+  bool Finish() {
+    if (!ok()) return false;
+    chunk_ = cur_ = end_ = nullptr;
+    if (lex_ == kToken) {
+      if (!EndToken(partial_.c_str(), partial_.size())) return false;
+    } else if (lex_ == kString) {
+      return Error("unterminated string constant");
+    } else if (lex_ == kSlash) {
+      return Error("unexpected '/'");
+    } else if (lex_ == kBlockComment || lex_ == kBlockCommentStar) {
+      return Error("end of file in comment");
+    }
+    if (expect_ != kEnd) return Error("unexpected end of JSON");
+    builder_->Finish();
+    return true;
+  }
+
+  bool ok() const { return error_.empty(); }
+  const std::string &error() const { return error_; }
+
+ private:
+  FLATBUFFERS_DELETE_FUNC(JsonToFlexBuffer(const JsonToFlexBuffer &));
+  FLATBUFFERS_DELETE_FUNC(
+      JsonToFlexBuffer &operator=(const JsonToFlexBuffer &));
+
+  // What may come next. The "OrClose" states also accept the end of the
+  // object or array, which are the states after a ',' unless strict_json.
+  enum Expect {
+    kValue,
+    kValueOrClose,
+    kKey,
+    kKeyOrClose,
+    kColon,
+    kCommaOrClose,
+    kEnd
+  };
+
+  // What the last chunk ended in the middle of.
+  enum Lex {
+    kNone,
+    kString,
+    kToken,
+    kSlash,
+    kLineComment,
+    kBlockComment,
+    kBlockCommentStar
+  };
+
+  struct Level {
+    size_t start;  // From StartMap() or StartVector().
+    bool map;
+  };
+
+  bool Error(const std::string &msg) {
+    if (error_.empty()) {
+      auto pos = offset_ + static_cast<size_t>(cur_ - chunk_);
+      error_ = msg + " (at offset " + NumToString(pos) + ")";
+    }
+    return false;
+  }
+
+  static bool IsTokenChar(char c) {
+    return is_alnum(c) || c == '_' || c == '.' || c == '+' || c == '-';
+  }
+
+  bool Continue() {
+    switch (lex_) {
+      case kNone: return true;
+      case kString: return ContinueString();
+      case kToken: return ContinueToken();
+      default: return Comment();
+    }
+  }
+
+  // Steps over `c`, which isn't whitespace, or starts the string or token
+  // at it.
+  bool Next(char c) {
+    switch (expect_) {
+      case kValueOrClose:
+        if (c == ']' && !levels_.back().map) return Close();
+        FLATBUFFERS_FALLTHROUGH();  // fall thru
+      case kValue:
+        if (c == '{' || c == '[') return Open(c == '{');
+        if (c == '\"' || c == '\'') return StartString(false);
+        if (IsTokenChar(c)) return StartToken(false);
+        return Error("expecting a value");
+      case kKeyOrClose:
+        if (c == '}') return Close();
+        FLATBUFFERS_FALLTHROUGH();  // fall thru
+      case kKey:
+        if (c == '\"' || c == '\'') return StartString(true);
+        if (IsTokenChar(c)) return StartToken(true);
+        return Error("expecting a key");
+      case kColon:
+        if (c != ':') return Error("expecting: ':'");
+        cur_++;
+        expect_ = kValue;
+        return true;
+      case kCommaOrClose: {
+        const bool map = levels_.back().map;
+        if (c == (map ? '}' : ']')) return Close();
+        if (c != ',') {
+          return Error(map ? "expecting: ',' or '}'" : "expecting: ',' or ']'");
+        }
+        cur_++;
+        expect_ = map ? (opts_.strict_json ? kKey : kKeyOrClose)
+                      : (opts_.strict_json ? kValue : kValueOrClose);
+        return true;
+      }
+      default: return Error("unexpected text after the root value");
+    }
+  }
+
+  bool Open(bool map) {
+    if (levels_.size() >= FLATBUFFERS_MAX_PARSING_DEPTH) {
+      return Error("JSON nested too deep");
+    }
+    cur_++;
+    Level level = { map ? builder_->StartMap() : builder_->StartVector(),
+                    map };
+    levels_.push_back(level);
+    expect_ = map ? kKeyOrClose : kValueOrClose;
+    return true;
+  }
+
+  bool Close() {
+    cur_++;
+    auto level = levels_.back();
+    levels_.pop_back();
+    if (level.map) {
+      builder_->EndMap(level.start);
+      if (builder_->HasDuplicateKeys()) {
+        return Error("FlexBuffers map has duplicate keys");
+      }
+    } else {
+      builder_->EndVector(level.start, false, false);
+    }
+    EndValue();
+    return true;
+  }
+
+  void EndValue() { expect_ = levels_.empty() ? kEnd : kCommaOrClose; }
+
+  bool StartString(bool key) {
+    quote_ = *cur_++;
+    key_ = key;
+    escaped_ = escapes_ = non_ascii_ = false;
+    const auto start = cur_;
+    // Most strings end in the chunk they start in, without escapes.
+    for (; cur_ < end_; cur_++) {
+      const auto c = static_cast<unsigned char>(*cur_);
+      if (c == static_cast<unsigned char>(quote_)) {
+        cur_++;
+        return EndString(start, static_cast<size_t>(cur_ - 1 - start));
+      }
+      if (c == '\\') break;
+      if (c < ' ') return Error("illegal character in string constant");
+      if (c >= 0x80) non_ascii_ = true;
+    }
+    partial_.assign(start, cur_);
+    lex_ = kString;
+    return ContinueString();
+  }
+
+  // Collects the rest of the string in partial_, as it is in the JSON.
+  bool ContinueString() {
+    const auto start = cur_;
+    for (; cur_ < end_; cur_++) {
+      const auto c = static_cast<unsigned char>(*cur_);
+      if (escaped_) {
+        escaped_ = false;
+      } else if (c == '\\') {
+        escaped_ = escapes_ = true;
+      } else if (c == static_cast<unsigned char>(quote_)) {
+        partial_.append(start, cur_++);
+        lex_ = kNone;
+        return EndString(partial_.c_str(), partial_.size());
+      } else if (c < ' ') {
+        return Error("illegal character in string constant");
+      } else if (c >= 0x80) {
+        non_ascii_ = true;
+      }
+    }
+    partial_.append(start, cur_);
+    return true;
+  }
+
+  bool EndString(const char *str, size_t len) {
+    // Escapes are ASCII, checking before unescaping leaves \x escapes be.
+    if (non_ascii_ && !opts_.allow_non_utf8 && !IsUTF8(str, str + len)) {
+      return Error("illegal UTF-8 sequence");
+    }
+    if (escapes_) {
+      if (!Unescape(str, str + len)) return false;
+      str = str_.c_str();
+      len = str_.size();
+    }
+    if (key_) {
+      builder_->Key(str, len);
+      expect_ = kColon;
+    } else {
+      builder_->String(str, len);
+      EndValue();
+    }
+    return true;
+  }
+
+  static bool IsUTF8(const char *p, const char *end) {
+    while (p < end) {
+      const auto c = static_cast<unsigned char>(*p);
+      if (c < 0x80) {
+        p++;
+        continue;
+      }
+      // FromUTF8() doesn't know where the input ends, check that first.
+      int len = 0;
+      while (len < 5 && (c << len) & 0x80) len++;
+      if (end - p < len || FromUTF8(&p) < 0) return false;
+    }
+    return true;
+  }
+
+  bool Hex(const char **p, const char *end, int digits, uint32_t *val) {
+    *val = 0;
+    for (int i = 0; i < digits; i++, (*p)++) {
+      if (*p == end || !is_xdigit(**p)) {
+        return Error("escape code must be followed by hex digits");
+      }
+      const char c = **p;
+      *val = *val * 16 + static_cast<uint32_t>(is_digit(c) ? c - '0'
+                                               : (c & ~0x20) - 'A' + 10);
+    }
+    return true;
+  }
+
+  // Decodes the escapes of JsonReader::ReadString() into str_.
+  bool Unescape(const char *p, const char *end) {
+    str_.clear();
+    while (p < end) {
+      const auto run = p;
+      while (p < end && *p != '\\') p++;
+      str_.append(run, p);
+      if (p == end) break;
+      // A string doesn't end in a backslash, there is a character after it.
+      p++;
+      uint32_t ucc;
+      switch (*p++) {
+        case 'n': str_ += '\n'; break;
+        case 't': str_ += '\t'; break;
+        case 'r': str_ += '\r'; break;
+        case 'b': str_ += '\b'; break;
+        case 'f': str_ += '\f'; break;
+        case '\"': str_ += '\"'; break;
+        case '\'': str_ += '\''; break;
+        case '\\': str_ += '\\'; break;
+        case '/': str_ += '/'; break;
+        case 'x':
+          if (!Hex(&p, end, 2, &ucc)) return false;
+          str_ += static_cast<char>(ucc);
+          break;
+        case 'u':
+          if (!Hex(&p, end, 4, &ucc)) return false;
+          if (ucc >= 0xDC00 && ucc <= 0xDFFF) {
+            return Error("unpaired low surrogate");
+          }
+          if (ucc >= 0xD800 && ucc <= 0xDBFF) {
+            uint32_t low;
+            if (end - p < 2 || p[0] != '\\' || p[1] != 'u') {
+              return Error("expecting a low surrogate");
+            }
+            p += 2;
+            if (!Hex(&p, end, 4, &low)) return false;
+            if (low < 0xDC00 || low > 0xDFFF) {
+              return Error("expecting a low surrogate");
+            }
+            ucc = (((ucc & 0x03FF) << 10) | (low & 0x03FF)) + 0x10000;
+          }
+          ToUTF8(ucc, &str_);
+          break;
+        default: return Error("unknown escape code in string constant");
+      }
+    }
+    return true;
+  }
+
+  // An unquoted key, number, `true`, `false` or `null`. It ends at a
+  // character that can't be in it, which may be in a later chunk.
+  bool StartToken(bool key) {
+    key_ = key;
+    const auto start = cur_;
+    while (cur_ < end_ && IsTokenChar(*cur_)) cur_++;
+    if (cur_ < end_) return EndToken(start, static_cast<size_t>(cur_ - start));
+    partial_.assign(start, cur_);
+    lex_ = kToken;
+    return true;
+  }
+
+  bool ContinueToken() {
+    const auto start = cur_;
+    while (cur_ < end_ && IsTokenChar(*cur_)) cur_++;
+    partial_.append(start, cur_);
+    if (cur_ == end_) return true;
+    return EndToken(partial_.c_str(), partial_.size());
+  }
+
+  bool EndToken(const char *token, size_t len) {
+    lex_ = kNone;
+    if (key_) {
+      builder_->Key(token, len);
+      expect_ = kColon;
+      return true;
+    }
+    if (len == 4 && !memcmp(token, "true", 4)) {
+      builder_->Bool(true);
+    } else if (len == 5 && !memcmp(token, "false", 5)) {
+      builder_->Bool(false);
+    } else if (len == 4 && !memcmp(token, "null", 4)) {
+      builder_->Null();
+    } else if (!Number(token, len)) {
+      return false;
+    }
+    EndValue();
+    return true;
+  }
+
+  bool Number(const char *token, size_t len) {
+    // Decimal integers that can't overflow, without strtoll().
+    const size_t sign = *token == '-';
+    size_t k = sign;
+    uint64_t u = 0;
+    for (; k < len && is_digit(token[k]); k++) u = u * 10 + (token[k] - '0');
+    if (k == len && k > sign && k - sign <= 18) {
+      const auto i = static_cast<int64_t>(u);
+      builder_->Int(sign ? -i : i);
+      return true;
+    }
+    // StringToNumber() needs a terminated string.
+    str_.assign(token, len);
+    const bool fraction =
+        k < len && (token[k] == '.' || token[k] == 'e' || token[k] == 'E');
+    int64_t i;
+    double d;
+    if (!fraction && StringToNumber(str_.c_str(), &i)) {
+      builder_->Int(i);
+    } else if (StringToNumber(str_.c_str(), &d)) {
+      builder_->Double(d);
+    } else {
+      return Error("invalid value: " + str_);
+    }
+    return true;
+  }
+
+  bool Comment() {
+    for (; cur_ < end_; cur_++) {
+      const char c = *cur_;
+      switch (lex_) {
+        case kSlash:
+          if (c == '/') {
+            lex_ = kLineComment;
+          } else if (c == '*') {
+            lex_ = kBlockComment;
+          } else {
+            return Error("unexpected '/'");
+          }
+          break;
+        case kLineComment:
+          if (c == '\n') lex_ = kNone;
+          break;
+        case kBlockComment:
+          if (c == '*') lex_ = kBlockCommentStar;
+          break;
+        default:
+          lex_ = c == '/'   ? kNone
+                 : c == '*' ? kBlockCommentStar
+                            : kBlockComment;
+          break;
+      }
+      if (lex_ == kNone) {
+        cur_++;
+        return true;
+      }
+    }
+    return true;
+  }
+
+  const JsonOptions opts_;
+  flexbuffers::Builder *builder_;
+  std::vector<Level> levels_;
+  Expect expect_;
+  Lex lex_;
+  // Of the string or token being read.
+  bool key_;
+  char quote_;
+  bool escaped_;    // The last character was a backslash.
+  bool escapes_;    // Has escapes.
+  bool non_ascii_;  // Has bytes to check as UTF-8.
+  std::string partial_;
+  std::string str_;
+  // Of the chunk being read, which starts at offset_ in the JSON.
+  size_t offset_;
+  const char *chunk_;
+  const char *cur_;
+  const char *end_;
+  std::string error_;
+};
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_JSON_H_
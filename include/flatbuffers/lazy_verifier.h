@@ -0,0 +1,219 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_LAZY_VERIFIER_H_
+#define FLATBUFFERS_LAZY_VERIFIER_H_
+
+#include "flatbuffers/flatbuffers.h"
+
+// Verification of just the parts of an untrusted buffer that are read, for
+// readers of a few fields of large buffers that VerifyBuffer() would check
+// entirely:
+//
+//   flatbuffers::LazyVerifier verifier(buf, len);
+//   auto monster = verifier.GetRoot<Monster>(MonsterIdentifier());
+//   auto name = monster.GetString(Monster::VT_NAME);
+//   auto hp = monster.GetField<int16_t>(Monster::VT_HP, 100);
+//   if (!verifier.ok()) { /* Don't use name and hp. */ }
+//
+// A table is checked (its vtable, like Verifier::VerifyTableStart) when it is
+// reached, and a field when it is read, with the same checks the generated
+// Verify() methods do. Tables, strings and vectors are checked once, later
+// reads of them are looked up. Values read through the generated accessors
+// (CheckedTable::get()) are not checked.
+
+namespace flatbuffers {
+
+template<typename T> class CheckedTable;
+
+// Not thread safe. A failed check returns nullptr or the default value, and
+// makes ok() false from then on.
+class LazyVerifier {
+ public:
+  LazyVerifier(const uint8_t *buf, size_t buf_len,
+               uoffset_t max_tables = 1000000, bool check_alignment = true)
+      : verifier_(buf, buf_len, 64, max_tables, check_alignment),
+        buf_(buf),
+        size_(buf_len),
+        ok_(true) {}
+
+  // Checks the root offset and the root table.
+  template<typename T>
+  CheckedTable<T> GetRoot(const char *identifier = nullptr);
+
+  // Whether everything read so far passed its checks.
+  bool ok() const { return ok_; }
+
+  // The number of tables, strings and vectors checked.
+  size_t num_checked() const { return checked_.size(); }
+
+  // The checks used by CheckedTable. These return nullptr if `p` is null.
+  const Table *CheckTable(const uint8_t *p) {
+    if (!p || IsChecked(p, kTable)) return reinterpret_cast<const Table *>(p);
+    if (!Check(verifier_.VerifyTableStart(p))) return nullptr;
+    // Tables aren't nested, VerifyTableStart() counted this one as a level.
+    verifier_.EndTable();
+    SetChecked(p, kTable);
+    return reinterpret_cast<const Table *>(p);
+  }
+
+  const String *CheckString(const uint8_t *p) {
+    auto str = reinterpret_cast<const String *>(p);
+    if (!p || IsChecked(p, kString)) return str;
+    if (!Check(verifier_.VerifyString(str))) return nullptr;
+    SetChecked(p, kString);
+    return str;
+  }
+
+  // Checks the size of a vector, not what its elements point to.
+  template<typename E> const Vector<E> *CheckVector(const uint8_t *p) {
+    auto elem_size = IndirectHelper<E>::element_stride;
+    if (p && !IsChecked(p, kVector + elem_size)) {
+      if (!Check(verifier_.VerifyVectorOrString(p, elem_size))) return nullptr;
+      SetChecked(p, kVector + elem_size);
+    }
+    return reinterpret_cast<const Vector<E> *>(p);
+  }
+
+  template<typename S> bool CheckField(const Table *table, voffset_t field) {
+    return Check(table->VerifyField<S>(verifier_, field));
+  }
+
+  // Checks the offset stored in a field, returns what it points to.
+  const uint8_t *CheckOffsetField(const Table *table, voffset_t field) {
+    if (!Check(table->VerifyOffset(verifier_, field))) return nullptr;
+    return table->GetPointer<const uint8_t *>(field);
+  }
+
+  // Checks the offset stored in element `i` of a checked vector of offsets.
+  template<typename E>
+  const uint8_t *CheckOffsetElement(const Vector<Offset<E>> *vec,
+                                    uoffset_t i) {
+    if (!vec || !Check(i < vec->size())) return nullptr;
+    auto elem = vec->Data() + i * sizeof(uoffset_t);
+    auto o = verifier_.VerifyOffset(static_cast<size_t>(elem - buf_));
+    if (!Check(o != 0)) return nullptr;
+    return elem + o;
+  }
+
+  // Elements of checked vectors of tables and strings.
+  template<typename U>
+  CheckedTable<U> GetTable(const Vector<Offset<U>> *vec, uoffset_t i);
+
+  const String *GetString(const Vector<Offset<String>> *vec, uoffset_t i) {
+    return CheckString(CheckOffsetElement(vec, i));
+  }
+
+ private:
+  FLATBUFFERS_DELETE_FUNC(LazyVerifier(const LazyVerifier &));
+  FLATBUFFERS_DELETE_FUNC(LazyVerifier &operator=(const LazyVerifier &));
+
+  // What a region was checked as, vectors add their element size.
+  enum { kTable, kString, kVector };
+
+  bool Check(bool ok) {
+    ok_ = ok_ && ok;
+    return ok;
+  }
+
+  bool IsChecked(const uint8_t *p, size_t kind) const {
+    return checked_.count(std::make_pair(static_cast<size_t>(p - buf_),
+                                         kind)) != 0;
+  }
+
+  void SetChecked(const uint8_t *p, size_t kind) {
+    checked_.insert(std::make_pair(static_cast<size_t>(p - buf_), kind));
+  }
+
+  Verifier verifier_;
+  const uint8_t *buf_;
+  size_t size_;
+  bool ok_;
+  std::set<std::pair<size_t, size_t>> checked_;
+};
+
+// A table of type T that was checked by a LazyVerifier, whose fields are
+// checked as they are read through the methods below. `field` is one of the
+// VT_ constants of T. A null CheckedTable (get() returns nullptr) is the
+// result of a missing or broken table, reading from it returns defaults.
+template<typename T> class CheckedTable {
+ public:
+  CheckedTable() : verifier_(nullptr), table_(nullptr) {}
+  CheckedTable(LazyVerifier *verifier, const Table *table)
+      : verifier_(verifier), table_(table) {}
+
+  const T *get() const { return reinterpret_cast<const T *>(table_); }
+
+  template<typename S> S GetField(voffset_t field, S defaultval) const {
+    return table_ && verifier_->CheckField<S>(table_, field)
+               ? table_->GetField<S>(field, defaultval)
+               : defaultval;
+  }
+
+  template<typename S> const S *GetStruct(voffset_t field) const {
+    return table_ && verifier_->CheckField<S>(table_, field)
+               ? table_->GetStruct<const S *>(field)
+               : nullptr;
+  }
+
+  const String *GetString(voffset_t field) const {
+    return table_ ? verifier_->CheckString(
+                        verifier_->CheckOffsetField(table_, field))
+                  : nullptr;
+  }
+
+  // Elements of vectors of tables or strings are checked when read through
+  // LazyVerifier::GetTable() or LazyVerifier::GetString().
+  template<typename E> const Vector<E> *GetVector(voffset_t field) const {
+    return table_ ? verifier_->CheckVector<E>(
+                        verifier_->CheckOffsetField(table_, field))
+                  : nullptr;
+  }
+
+  // Also for unions, once their type field says what U is.
+  template<typename U> CheckedTable<U> GetTable(voffset_t field) const {
+    if (!table_) return CheckedTable<U>();
+    return CheckedTable<U>(verifier_,
+                           verifier_->CheckTable(
+                               verifier_->CheckOffsetField(table_, field)));
+  }
+
+ private:
+  LazyVerifier *verifier_;
+  const Table *table_;
+};
+
+template<typename T>
+CheckedTable<T> LazyVerifier::GetRoot(const char *identifier) {
+  if (identifier &&
+      !Check(size_ >= 2 * sizeof(uoffset_t) &&
+             BufferHasIdentifier(buf_, identifier))) {
+    return CheckedTable<T>();
+  }
+  auto o = verifier_.VerifyOffset(0);
+  if (!Check(o != 0)) return CheckedTable<T>();
+  return CheckedTable<T>(this, CheckTable(buf_ + o));
+}
+
+template<typename U>
+CheckedTable<U> LazyVerifier::GetTable(const Vector<Offset<U>> *vec,
+                                       uoffset_t i) {
+  return CheckedTable<U>(this, CheckTable(CheckOffsetElement(vec, i)));
+}
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_LAZY_VERIFIER_H_
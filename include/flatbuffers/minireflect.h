@@ -96,6 +96,26 @@ inline size_t InlineSize(ElementaryType type, const TypeTable *type_table) {
   }
 }
 
+// The alignment of an inline value, which for a struct is that of its
+// largest member. This does not know about `force_align`.
+inline size_t InlineAlignment(ElementaryType type,
+                              const TypeTable *type_table) {
+  if (type != ET_SEQUENCE || type_table->st != ST_STRUCT) {
+    return InlineSize(type, type_table);
+  }
+  size_t align = 1;
+  for (size_t i = 0; i < type_table->num_elems; i++) {
+    auto type_code = type_table->type_codes[i];
+    auto ref = type_code.sequence_ref >= 0
+                   ? type_table->type_refs[type_code.sequence_ref]()
+                   : nullptr;
+    align = (std::max)(
+        align, InlineAlignment(static_cast<ElementaryType>(type_code.base_type),
+                               ref));
+  }
+  return align;
+}
+
 inline int64_t LookupEnum(int64_t enum_val, const int64_t *values,
                           size_t num_values) {
   if (!values) return enum_val;
@@ -290,8 +310,287 @@ inline void IterateFlatBuffer(const uint8_t *buffer,
   IterateObject(GetRoot<uint8_t>(buffer), type_table, callback);
 }
 
+// Bounds-checked versions of the above, for buffers that have not been
+// verified. Every offset, vector and string is checked the way the generated
+// Verify() functions do it, right before it is visited, so verification and
+// visiting take a single pass. They return false at the first problem, after
+// which the visitor may have seen part of the buffer, but only memory inside
+// of it. The TypeTable doesn't say which fields are required or deprecated,
+// so required fields aren't checked, and deprecated fields are checked even
+// though the generated code skips them. Values of unknown union types are
+// passed to Unknown() without looking at them, like the generated code does.
+
+bool VerifyAndIterateObject(Verifier &verifier, const uint8_t *obj,
+                            const TypeTable *type_table,
+                            IterationVisitor *visitor);
+
+// The type of a union value from the type field (or vector) before it, a
+// missing type field means NONE.
+inline bool VerifyUnionType(Verifier &verifier, const uint8_t *prev_val,
+                            soffset_t vector_index, uint8_t *union_type) {
+  *union_type = prev_val ? *prev_val : 0;
+  if (vector_index < 0) return true;
+  auto type_vec = reinterpret_cast<const Vector<uint8_t> *>(prev_val);
+  if (!verifier.Check(type_vec && static_cast<uoffset_t>(vector_index) <
+                                      type_vec->size())) {
+    return false;
+  }
+  *union_type = type_vec->Get(static_cast<uoffset_t>(vector_index));
+  return true;
+}
+
+// Checks the offset of a union value, and the struct it points to if it is
+// one, before visitors see the value: they may read the struct right away
+// (BuilderVisitor copies it). Other kinds of values are checked as they are
+// iterated.
+inline bool VerifyUnionTarget(Verifier &verifier, ElementaryType type,
+                              const uint8_t *val, const TypeTable *type_table,
+                              const uint8_t *prev_val,
+                              soffset_t vector_index) {
+  if (type != ET_SEQUENCE || type_table->st != ST_UNION) return true;
+  auto o = verifier.VerifyOffset(val, 0);
+  uint8_t union_type;
+  if (!o || !VerifyUnionType(verifier, prev_val, vector_index, &union_type)) {
+    return false;
+  }
+  auto type_code_idx =
+      LookupEnum(union_type, type_table->values, type_table->num_elems);
+  if (type_code_idx < 0 ||
+      type_code_idx >= static_cast<int64_t>(type_table->num_elems)) {
+    return true;
+  }
+  auto type_code = type_table->type_codes[type_code_idx];
+  if (type_code.base_type != ET_SEQUENCE || type_code.sequence_ref < 0) {
+    return true;
+  }
+  auto ref = type_table->type_refs[type_code.sequence_ref]();
+  return ref->st != ST_STRUCT ||
+         verifier.VerifyFromPointer(val + o, InlineSize(ET_SEQUENCE, ref));
+}
+
+// `val` itself must already have been checked, only what it refers to is.
+inline bool VerifyAndIterateValue(Verifier &verifier, ElementaryType type,
+                                  const uint8_t *val,
+                                  const TypeTable *type_table,
+                                  const uint8_t *prev_val,
+                                  soffset_t vector_index,
+                                  IterationVisitor *visitor) {
+  if (type != ET_STRING && type != ET_SEQUENCE) {
+    IterateValue(type, val, type_table, prev_val, vector_index, visitor);
+    return true;
+  }
+  if (type == ET_SEQUENCE && type_table->st == ST_STRUCT) {
+    return VerifyAndIterateObject(verifier, val, type_table, visitor);
+  }
+  auto o = verifier.VerifyOffset(val, 0);
+  if (!o) return false;
+  val += o;
+  if (type == ET_STRING) {
+    auto str = reinterpret_cast<const String *>(val);
+    if (!verifier.VerifyString(str)) return false;
+    visitor->String(str);
+    return true;
+  }
+  if (type_table->st == ST_TABLE) {
+    return VerifyAndIterateObject(verifier, val, type_table, visitor);
+  }
+  FLATBUFFERS_ASSERT(type_table->st == ST_UNION);
+  uint8_t union_type;
+  if (!VerifyUnionType(verifier, prev_val, vector_index, &union_type)) {
+    return false;
+  }
+  auto type_code_idx =
+      LookupEnum(union_type, type_table->values, type_table->num_elems);
+  if (type_code_idx < 0 ||
+      type_code_idx >= static_cast<int64_t>(type_table->num_elems)) {
+    visitor->Unknown(val);
+    return true;
+  }
+  auto type_code = type_table->type_codes[type_code_idx];
+  if (type_code.base_type == ET_STRING) {
+    auto str = reinterpret_cast<const String *>(val);
+    if (!verifier.VerifyString(str)) return false;
+    visitor->String(str);
+    return true;
+  }
+  if (type_code.base_type != ET_SEQUENCE || type_code.sequence_ref < 0) {
+    visitor->Unknown(val);
+    return true;
+  }
+  auto ref = type_table->type_refs[type_code.sequence_ref]();
+  if (ref->st == ST_STRUCT &&
+      !verifier.VerifyFromPointer(val, InlineSize(ET_SEQUENCE, ref))) {
+    return false;
+  }
+  return VerifyAndIterateObject(verifier, val, ref, visitor);
+}
+
+inline bool VerifyAndIterateObject(Verifier &verifier, const uint8_t *obj,
+                                   const TypeTable *type_table,
+                                   IterationVisitor *visitor) {
+  // Structs are checked as a whole by whoever refers to them.
+  const auto is_table = type_table->st == ST_TABLE;
+  if (is_table && !verifier.VerifyTableStart(obj)) return false;
+  visitor->StartSequence();
+  const uint8_t *prev_val = nullptr;
+  size_t set_idx = 0;
+  size_t array_idx = 0;
+  for (size_t i = 0; i < type_table->num_elems; i++) {
+    auto type_code = type_table->type_codes[i];
+    auto type = static_cast<ElementaryType>(type_code.base_type);
+    auto is_repeating = type_code.is_repeating != 0;
+    auto ref_idx = type_code.sequence_ref;
+    const TypeTable *ref = nullptr;
+    if (ref_idx >= 0) { ref = type_table->type_refs[ref_idx](); }
+    auto name = type_table->names ? type_table->names[i] : nullptr;
+    const uint8_t *val = nullptr;
+    if (is_table) {
+      auto field = FieldIndexToOffset(static_cast<voffset_t>(i));
+      verifier.TrackField(field);
+      val = reinterpret_cast<const Table *>(obj)->GetAddressOf(field);
+      if (val && !verifier.VerifyFromPointer(
+                     val, is_repeating ? sizeof(uoffset_t)
+                                       : InlineSize(type, ref))) {
+        return false;
+      }
+    } else {
+      val = obj + type_table->values[i];
+    }
+    if (val && !is_repeating &&
+        !VerifyUnionTarget(verifier, type, val, ref, prev_val, -1)) {
+      return false;
+    }
+    visitor->Field(i, set_idx, type, is_repeating, ref, name, val);
+    if (val) {
+      set_idx++;
+      if (is_repeating) {
+        auto elem_ptr = val;
+        size_t size = 0;
+        const auto elem_size = InlineSize(type, ref);
+        if (is_table) {
+          auto o = verifier.VerifyOffset(val, 0);
+          if (!o) return false;
+          val += o;
+          if (!verifier.VerifyVectorOrString(val, elem_size)) return false;
+          auto vec = reinterpret_cast<const Vector<uint8_t> *>(val);
+          elem_ptr = vec->Data();
+          size = vec->size();
+        } else {
+          size = type_table->array_sizes[array_idx];
+          ++array_idx;
+        }
+        visitor->StartVector();
+        for (size_t j = 0; j < size; j++) {
+          if (!VerifyUnionTarget(verifier, type, elem_ptr, ref, prev_val,
+                                 static_cast<soffset_t>(j))) {
+            return false;
+          }
+          visitor->Element(j, type, ref, elem_ptr);
+          if (!VerifyAndIterateValue(verifier, type, elem_ptr, ref, prev_val,
+                                     static_cast<soffset_t>(j), visitor)) {
+            return false;
+          }
+          elem_ptr += elem_size;
+        }
+        visitor->EndVector();
+      } else if (!VerifyAndIterateValue(verifier, type, val, ref, prev_val, -1,
+                                        visitor)) {
+        return false;
+      }
+    }
+    prev_val = val;
+  }
+  visitor->EndSequence();
+  if (is_table) verifier.EndTable();
+  return true;
+}
+
+// `verifier` must cover `buffer`, the start of a FlatBuffer with `type_table`
+// as its root type.
+inline bool VerifyAndIterateFlatBuffer(Verifier &verifier,
+                                       const uint8_t *buffer,
+                                       const TypeTable *type_table,
+                                       IterationVisitor *visitor) {
+  auto o = verifier.VerifyOffset(buffer, 0);
+  return o && VerifyAndIterateObject(verifier, buffer + o, type_table, visitor);
+}
+
+inline bool VerifyAndIterateFlatBuffer(const uint8_t *buffer, size_t length,
+                                       const TypeTable *type_table,
+                                       IterationVisitor *visitor) {
+  Verifier verifier(buffer, length);
+  return VerifyAndIterateFlatBuffer(verifier, buffer, type_table, visitor);
+}
+
+// Verifies a buffer with just its TypeTable, without generated Verify() code.
+inline bool VerifyFlatBuffer(const uint8_t *buffer, size_t length,
+                             const TypeTable *type_table) {
+  IterationVisitor visitor;
+  return VerifyAndIterateFlatBuffer(buffer, length, type_table, &visitor);
+}
+
+// Names the fields leading to where verification of `buffer` failed, as
+// recorded in `stats` (see Verifier::SetStats), e.g. "testarrayoftables.name".
+// Returns an empty string if there was no failure or it was in the root table
+// itself. Tables in union vectors can't be told apart by the path, their
+// fields and those below them are given by id, e.g. "characters.#1".
+inline std::string VerifierFailurePath(const uint8_t *buffer, size_t length,
+                                       const TypeTable *type_table,
+                                       const VerifierStats &stats) {
+  std::string path;
+  if (!stats.failed) return path;
+  for (size_t i = 0; i < stats.failure_path.size(); i++) {
+    auto &entry = stats.failure_path[i];
+    if (entry.field < FieldIndexToOffset(0)) break;
+    auto idx = static_cast<size_t>(entry.field - FieldIndexToOffset(0)) /
+               sizeof(voffset_t);
+    if (!path.empty()) path += ".";
+    if (!type_table || type_table->st != ST_TABLE || !type_table->names ||
+        idx >= type_table->num_elems) {
+      path += "#" + NumToString(idx);
+      type_table = nullptr;
+      continue;
+    }
+    path += type_table->names[idx];
+    auto type_code = type_table->type_codes[idx];
+    auto ref = type_code.sequence_ref >= 0
+                   ? type_table->type_refs[type_code.sequence_ref]()
+                   : nullptr;
+    if (ref && ref->st == ST_UNION) {
+      // The type field comes right before the union value. The table was
+      // checked to have a vtable before the failure, but its type field
+      // need not have been checked yet.
+      const uint8_t *type = nullptr;
+      if (!type_code.is_repeating && idx &&
+          entry.table + sizeof(soffset_t) <= length) {
+        auto table = buffer + entry.table;
+        auto vtable = table - ReadScalar<soffset_t>(table);
+        auto type_field = FieldIndexToOffset(static_cast<voffset_t>(idx - 1));
+        if (type_field < ReadScalar<voffset_t>(vtable)) {
+          auto field_offset = ReadScalar<voffset_t>(vtable + type_field);
+          if (field_offset && entry.table + field_offset < length) {
+            type = table + field_offset;
+          }
+        }
+      }
+      auto member = type ? LookupEnum(*type, ref->values, ref->num_elems) : -1;
+      if (member >= 0 && member < static_cast<int64_t>(ref->num_elems) &&
+          ref->type_codes[member].base_type == ET_SEQUENCE) {
+        ref = ref->type_refs[ref->type_codes[member].sequence_ref]();
+      } else {
+        ref = nullptr;
+      }
+    }
+    type_table = ref;
+  }
+  return path;
+}
+
 // Outputting a Flatbuffer to a string. Tries to conform as close to JSON /
 // the output generated by idl_gen_text.cpp.
+// The text goes to `s`, or to a caller owned string or TextSink set with
+// WriteTo(), so a visitor can be kept around and reused without allocating
+// once its output has grown to the size of a typical buffer.
 
 struct ToStringVisitor : public IterationVisitor {
   std::string s;
@@ -300,106 +599,145 @@ struct ToStringVisitor : public IterationVisitor {
   std::string in;
   size_t indent_level;
   bool vector_delimited;
+  std::string *target;  // Appended to instead of `s` when not null.
+  TextSink *sink;       // Flushed at element boundaries when not null.
+  std::string indents;  // `in` repeated, so indenting is a single append.
   ToStringVisitor(std::string delimiter, bool quotes, std::string indent,
                   bool vdelimited = true)
       : d(delimiter),
         q(quotes),
         in(indent),
         indent_level(0),
-        vector_delimited(vdelimited) {}
+        vector_delimited(vdelimited),
+        target(nullptr),
+        sink(nullptr) {}
   ToStringVisitor(std::string delimiter)
       : d(delimiter),
         q(false),
         in(""),
         indent_level(0),
-        vector_delimited(true) {}
+        vector_delimited(true),
+        target(nullptr),
+        sink(nullptr) {}
+
+  // Appends the text of the following iterations to `*out`.
+  void WriteTo(std::string *out) {
+    target = out;
+    sink = nullptr;
+  }
+  // Appends the text of the following iterations to the buffer of `out`,
+  // handing it to the sink in chunks. The caller flushes at the end.
+  void WriteTo(TextSink *out) {
+    target = &out->buffer();
+    sink = out;
+  }
+  // Clears `s` (keeping its capacity) and writes to it again.
+  void Reset() {
+    s.clear();
+    target = nullptr;
+    sink = nullptr;
+    indent_level = 0;
+  }
+
+  std::string &text() { return target ? *target : s; }
 
   void append_indent() {
-    for (size_t i = 0; i < indent_level; i++) { s += in; }
+    auto size = indent_level * in.size();
+    while (indents.size() < size) indents += in;
+    text().append(indents, 0, size);
+  }
+  // Called after the separator between fields or elements.
+  void maybe_flush() {
+    if (sink) sink->MaybeFlush();
   }
 
   void StartSequence() {
-    s += "{";
-    s += d;
+    auto &o = text();
+    o += "{";
+    o += d;
     indent_level++;
   }
   void EndSequence() {
-    s += d;
+    text() += d;
     indent_level--;
     append_indent();
-    s += "}";
+    text() += "}";
   }
   void Field(size_t /*field_idx*/, size_t set_idx, ElementaryType /*type*/,
              bool /*is_vector*/, const TypeTable * /*type_table*/,
              const char *name, const uint8_t *val) {
     if (!val) return;
     if (set_idx) {
-      s += ",";
-      s += d;
+      text() += ",";
+      text() += d;
+      maybe_flush();
     }
     append_indent();
     if (name) {
-      if (q) s += "\"";
-      s += name;
-      if (q) s += "\"";
-      s += ": ";
+      auto &o = text();
+      if (q) o += "\"";
+      o += name;
+      if (q) o += "\"";
+      o += ": ";
     }
   }
   template<typename T> void Named(T x, const char *name) {
+    auto &o = text();
     if (name) {
-      if (q) s += "\"";
-      s += name;
-      if (q) s += "\"";
+      if (q) o += "\"";
+      o += name;
+      if (q) o += "\"";
     } else {
-      s += NumToString(x);
+      AppendNumberToString(x, &o);
     }
   }
   void UType(uint8_t x, const char *name) { Named(x, name); }
-  void Bool(bool x) { s += x ? "true" : "false"; }
+  void Bool(bool x) { text() += x ? "true" : "false"; }
   void Char(int8_t x, const char *name) { Named(x, name); }
   void UChar(uint8_t x, const char *name) { Named(x, name); }
   void Short(int16_t x, const char *name) { Named(x, name); }
   void UShort(uint16_t x, const char *name) { Named(x, name); }
   void Int(int32_t x, const char *name) { Named(x, name); }
   void UInt(uint32_t x, const char *name) { Named(x, name); }
-  void Long(int64_t x) { s += NumToString(x); }
-  void ULong(uint64_t x) { s += NumToString(x); }
-  void Float(float x) { s += NumToString(x); }
-  void Double(double x) { s += NumToString(x); }
+  void Long(int64_t x) { AppendNumberToString(x, &text()); }
+  void ULong(uint64_t x) { AppendNumberToString(x, &text()); }
+  void Float(float x) { AppendNumberToString(x, &text()); }
+  void Double(double x) { AppendNumberToString(x, &text()); }
   void String(const struct String *str) {
-    EscapeString(str->c_str(), str->size(), &s, true, false);
+    EscapeString(str->c_str(), str->size(), &text(), true, false);
   }
-  void Unknown(const uint8_t *) { s += "(?)"; }
+  void Unknown(const uint8_t *) { text() += "(?)"; }
   void StartVector() {
-    s += "[";
+    text() += "[";
     if (vector_delimited) {
-      s += d;
+      text() += d;
       indent_level++;
       append_indent();
     } else {
-      s += " ";
+      text() += " ";
     }
   }
   void EndVector() {
     if (vector_delimited) {
-      s += d;
+      text() += d;
       indent_level--;
       append_indent();
     } else {
-      s += " ";
+      text() += " ";
     }
-    s += "]";
+    text() += "]";
   }
   void Element(size_t i, ElementaryType /*type*/,
                const TypeTable * /*type_table*/, const uint8_t * /*val*/) {
     if (i) {
-      s += ",";
+      text() += ",";
       if (vector_delimited) {
-        s += d;
+        text() += d;
         append_indent();
       } else {
-        s += " ";
+        text() += " ";
       }
+      maybe_flush();
     }
   }
 };
@@ -414,6 +752,307 @@ inline std::string FlatBufferToString(const uint8_t *buffer,
   return tostring_visitor.s;
 }
 
+// As above, but appends the text to `*out`. Clearing a string and passing it
+// again for every buffer reuses its capacity.
+inline void FlatBufferToString(const uint8_t *buffer,
+                               const TypeTable *type_table, std::string *out,
+                               bool multi_line = false,
+                               bool vector_delimited = true) {
+  ToStringVisitor tostring_visitor(multi_line ? "\n" : " ", false, "",
+                                   vector_delimited);
+  tostring_visitor.WriteTo(out);
+  IterateFlatBuffer(buffer, type_table, &tostring_visitor);
+}
+
+// As above, but streams the text to `sink`, which is flushed before
+// returning. Returns false if the sink failed to write.
+inline bool FlatBufferToString(const uint8_t *buffer,
+                               const TypeTable *type_table, TextSink *sink,
+                               bool multi_line = false,
+                               bool vector_delimited = true) {
+  ToStringVisitor tostring_visitor(multi_line ? "\n" : " ", false, "",
+                                   vector_delimited);
+  tostring_visitor.WriteTo(sink);
+  IterateFlatBuffer(buffer, type_table, &tostring_visitor);
+  return sink->Flush();
+}
+
+// Writes a copy of the visited buffer into a FlatBufferBuilder, with nothing
+// but the TypeTable to go by. The copy has no unreachable or padding bytes
+// left over from how the original was built, has its vtables deduplicated and
+// its fields ordered by size, and can optionally share equal strings. The
+// TypeTable doesn't know default values, so fields that are present in the
+// original stay present.
+// Tables and vectors are written once all of their contents have been
+// visited, since the builder needs children before parents. Values of union
+// types the TypeTable doesn't know can't be copied, and make ok() false.
+class BuilderVisitor : public IterationVisitor {
+ public:
+  explicit BuilderVisitor(FlatBufferBuilder &fbb, bool share_strings = false)
+      : fbb_(fbb),
+        share_strings_(share_strings),
+        ok_(true),
+        depth_(0),
+        skip_depth_(0),
+        skip_next_(false),
+        pending_type_(ET_UTYPE),
+        pending_type_table_(nullptr),
+        pending_union_types_(nullptr),
+        root_(0) {}
+
+  bool ok() const { return ok_; }
+
+  // The root table, once the whole buffer has been visited.
+  Offset<Table> root() const { return Offset<Table>(root_); }
+
+  void StartSequence() {
+    if (skip_next_ || skip_depth_) {
+      // The contents of a struct, which was copied as a whole.
+      skip_next_ = false;
+      skip_depth_++;
+      return;
+    }
+    auto &frame = Push();
+    frame.is_vector = false;
+  }
+
+  void EndSequence() {
+    if (skip_depth_) {
+      skip_depth_--;
+      return;
+    }
+    auto &frame = frames_[--depth_];
+    // Larger values first, like the generated CreateX() functions do, so
+    // there is less padding.
+    std::stable_sort(frame.fields.begin(), frame.fields.end(),
+                     FieldValue::LargerAlignment);
+    auto start = fbb_.StartTable();
+    for (auto it = frame.fields.begin(); it != frame.fields.end(); ++it) {
+      if (it->data) {
+        fbb_.Align(it->align);
+        fbb_.PushBytes(it->data, it->size);
+        fbb_.AddStructOffset(it->field, fbb_.GetSize());
+      } else {
+        fbb_.AddOffset(it->field, Offset<void>(it->offset));
+      }
+    }
+    Complete(fbb_.EndTable(start));
+  }
+
+  void Field(size_t field_idx, size_t /*set_idx*/, ElementaryType type,
+             bool is_vector, const TypeTable *type_table,
+             const char * /*name*/, const uint8_t *val) {
+    if (skip_depth_) return;
+    auto &frame = frames_[depth_ - 1];
+    const auto prev_val = frame.prev_val;
+    frame.prev_val = val;
+    if (!val) return;
+    frame.field = FieldIndexToOffset(static_cast<voffset_t>(field_idx));
+    if (is_vector) {
+      // Picked up by StartVector(), which comes next.
+      pending_type_ = type;
+      pending_type_table_ = type_table;
+      pending_union_types_ =
+          prev_val && type == ET_SEQUENCE && type_table->st == ST_UNION
+              ? reinterpret_cast<const Vector<uint8_t> *>(
+                    prev_val + ReadScalar<uoffset_t>(prev_val))
+              : nullptr;
+    } else if (IsInline(type, type_table)) {
+      FieldValue fv;
+      fv.field = frame.field;
+      fv.data = val;
+      fv.size = InlineSize(type, type_table);
+      fv.align = InlineAlignment(type, type_table);
+      fv.offset = 0;
+      frame.fields.push_back(fv);
+      skip_next_ = type == ET_SEQUENCE;
+    } else if (type == ET_SEQUENCE && type_table->st == ST_UNION) {
+      Union(prev_val ? *prev_val : 0, type_table,
+            val + ReadScalar<uoffset_t>(val));
+    }
+  }
+
+  void StartVector() {
+    if (skip_depth_) return;
+    auto &frame = Push();
+    frame.is_vector = true;
+    frame.elem_type = pending_type_;
+    frame.elem_type_table = pending_type_table_;
+    frame.union_types = pending_union_types_;
+    frame.elems = nullptr;
+    frame.num_elems = 0;
+  }
+
+  void EndVector() {
+    if (skip_depth_) return;
+    auto &frame = frames_[--depth_];
+    if (IsInline(frame.elem_type, frame.elem_type_table)) {
+      const auto size = InlineSize(frame.elem_type, frame.elem_type_table);
+      const auto align =
+          InlineAlignment(frame.elem_type, frame.elem_type_table);
+      fbb_.StartVector(frame.num_elems * size / align, align);
+      if (frame.num_elems) fbb_.PushBytes(frame.elems, frame.num_elems * size);
+      Complete(fbb_.EndVector(frame.num_elems));
+    } else {
+      const auto num_elems = frame.offsets.size();
+      fbb_.StartVector(num_elems, sizeof(uoffset_t));
+      for (auto i = num_elems; i > 0;) {
+        fbb_.PushElement(Offset<void>(frame.offsets[--i]));
+      }
+      Complete(fbb_.EndVector(num_elems));
+    }
+  }
+
+  void Element(size_t i, ElementaryType type, const TypeTable *type_table,
+               const uint8_t *val) {
+    if (skip_depth_) return;
+    auto &frame = frames_[depth_ - 1];
+    if (IsInline(type, type_table)) {
+      // Vectors of scalars and structs are copied as a whole.
+      if (!i) frame.elems = val;
+      frame.num_elems++;
+      skip_next_ = type == ET_SEQUENCE;
+    } else if (type == ET_SEQUENCE && type_table->st == ST_UNION) {
+      const auto union_type =
+          frame.union_types && i < frame.union_types->size()
+              ? frame.union_types->Get(static_cast<uoffset_t>(i))
+              : 0;
+      Union(union_type, type_table, val + ReadScalar<uoffset_t>(val));
+    }
+  }
+
+  void String(const struct String *str) {
+    if (skip_depth_) return;
+    Complete(share_strings_ ? fbb_.CreateSharedString(str).o
+                            : fbb_.CreateString(str).o);
+  }
+
+  void Unknown(const uint8_t *) { ok_ = false; }
+
+ private:
+  struct FieldValue {
+    voffset_t field;
+    // Inline values are copied from the original buffer.
+    const uint8_t *data;
+    size_t size;
+    size_t align;
+    uoffset_t offset;
+
+    static bool LargerAlignment(const FieldValue &a, const FieldValue &b) {
+      const auto a_align = a.data ? a.align : sizeof(uoffset_t);
+      const auto b_align = b.data ? b.align : sizeof(uoffset_t);
+      return a_align > b_align;
+    }
+  };
+
+  // A table or vector that is being visited.
+  struct Frame {
+    bool is_vector;
+    // Tables:
+    std::vector<FieldValue> fields;
+    voffset_t field;
+    const uint8_t *prev_val;
+    // Vectors:
+    ElementaryType elem_type;
+    const TypeTable *elem_type_table;
+    const Vector<uint8_t> *union_types;
+    const uint8_t *elems;
+    size_t num_elems;
+    std::vector<uoffset_t> offsets;
+  };
+
+  static bool IsInline(ElementaryType type, const TypeTable *type_table) {
+    return type != ET_STRING &&
+           (type != ET_SEQUENCE || type_table->st == ST_STRUCT);
+  }
+
+  // Frames are reused, so their vectors keep their capacity.
+  Frame &Push() {
+    if (depth_ == frames_.size()) frames_.push_back(Frame());
+    auto &frame = frames_[depth_++];
+    frame.fields.clear();
+    frame.offsets.clear();
+    frame.prev_val = nullptr;
+    return frame;
+  }
+
+  // Copies a union value if it's a struct, otherwise it is visited next.
+  void Union(uint8_t union_type, const TypeTable *type_table,
+             const uint8_t *val) {
+    auto idx = LookupEnum(union_type, type_table->values,
+                          type_table->num_elems);
+    if (idx < 0 || idx >= static_cast<int64_t>(type_table->num_elems)) return;
+    auto type_code = type_table->type_codes[idx];
+    if (type_code.base_type != ET_SEQUENCE || type_code.sequence_ref < 0) {
+      return;
+    }
+    auto ref = type_table->type_refs[type_code.sequence_ref]();
+    if (ref->st != ST_STRUCT) return;
+    fbb_.Align(InlineAlignment(ET_SEQUENCE, ref));
+    fbb_.PushBytes(val, InlineSize(ET_SEQUENCE, ref));
+    Complete(fbb_.GetSize());
+    skip_next_ = true;
+  }
+
+  // Adds a finished string, table, vector or union struct to its parent.
+  void Complete(uoffset_t offset) {
+    if (!depth_) {
+      root_ = offset;
+      return;
+    }
+    auto &frame = frames_[depth_ - 1];
+    if (frame.is_vector) {
+      frame.offsets.push_back(offset);
+    } else {
+      FieldValue fv;
+      fv.field = frame.field;
+      fv.data = nullptr;
+      fv.size = sizeof(uoffset_t);
+      fv.align = sizeof(uoffset_t);
+      fv.offset = offset;
+      frame.fields.push_back(fv);
+    }
+  }
+
+  FlatBufferBuilder &fbb_;
+  bool share_strings_;
+  bool ok_;
+  std::vector<Frame> frames_;
+  size_t depth_;
+  size_t skip_depth_;
+  bool skip_next_;
+  ElementaryType pending_type_;
+  const TypeTable *pending_type_table_;
+  const Vector<uint8_t> *pending_union_types_;
+  uoffset_t root_;
+};
+
+// Copies a buffer through BuilderVisitor and finishes `fbb` with it.
+inline bool CopyFlatBuffer(const uint8_t *buffer, const TypeTable *type_table,
+                           FlatBufferBuilder &fbb,
+                           const char *file_identifier = nullptr) {
+  BuilderVisitor visitor(fbb);
+  IterateFlatBuffer(buffer, type_table, &visitor);
+  if (!visitor.ok()) return false;
+  fbb.Finish(visitor.root(), file_identifier);
+  return true;
+}
+
+// As above, but for a buffer that has not been verified, which is verified
+// while it is copied.
+inline bool VerifyAndCopyFlatBuffer(const uint8_t *buffer, size_t length,
+                                    const TypeTable *type_table,
+                                    FlatBufferBuilder &fbb,
+                                    const char *file_identifier = nullptr) {
+  BuilderVisitor visitor(fbb);
+  if (!VerifyAndIterateFlatBuffer(buffer, length, type_table, &visitor) ||
+      !visitor.ok()) {
+    return false;
+  }
+  fbb.Finish(visitor.root(), file_identifier);
+  return true;
+}
+
 }  // namespace flatbuffers
 
 #endif  // FLATBUFFERS_MINIREFLECT_H_
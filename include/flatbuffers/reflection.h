@@ -22,6 +22,7 @@
 // Should normally not be a problem since it can be generated by the
 // previous version of flatc whenever this code needs to change.
 // See reflection/generate_code.sh
+#include "flatbuffers/flexbuffers.h"
 #include "flatbuffers/reflection_generated.h"
 
 // Helper functionality for reflection.
@@ -489,6 +490,33 @@ Offset<const Table *> CopyTable(FlatBufferBuilder &fbb,
                                 const Table &table,
                                 bool use_string_pooling = false);
 
+// ------------------------- FLEXBUFFERS -------------------------
+
+// Builds a FlatBuffer with root table `root` of `schema` from a FlexBuffer
+// with the structure of its JSON: tables and structs are maps of their fields
+// by name, vectors and arrays are vectors (or blobs, for bytes), enum values
+// are numbers or names, and a union field `u` has its type in `u_type`, by
+// name or number. Fields that are null are left out.
+// This converts FlexBuffers received from elsewhere without printing them
+// as JSON and parsing that.
+// Returns false if a value doesn't fit its field, or a map has a key that
+// isn't a field (unless `skip_unknown_fields`). `error` is then set to the
+// path of the value and what is wrong, like "inventory[3]: value out of
+// range: 256".
+bool FlexBufferToFlatBuffer(const reflection::Schema &schema,
+                            const reflection::Object &root,
+                            flexbuffers::Reference flexbuffer,
+                            FlatBufferBuilder *fbb, std::string *error,
+                            bool skip_unknown_fields = false);
+
+// The reverse: builds a FlexBuffer from a FlatBuffer with root table `root`,
+// in the form above, with enum values as numbers. Fields not in the buffer
+// are left out. `flatbuffer` must have been verified.
+void FlatBufferToFlexBuffer(const reflection::Schema &schema,
+                            const reflection::Object &root,
+                            const uint8_t *flatbuffer,
+                            flexbuffers::Builder *flexbuilder);
+
 // Verifies the provided flatbuffer using reflection.
 // root should point to the root type for this flatbuffer.
 // buf should point to the start of flatbuffer data.
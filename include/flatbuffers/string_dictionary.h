@@ -0,0 +1,105 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_STRING_DICTIONARY_H_
+#define FLATBUFFERS_STRING_DICTIONARY_H_
+
+#include "flatbuffers/flatbuffers.h"
+
+#if FLATBUFFERS_HAS_THREADS
+#  include <deque>
+#  include <mutex>
+
+namespace flatbuffers {
+
+// Strings that many buffers repeat (host names, metric names, enum-like
+// values), interned once and then added to any number of builders:
+//
+//   static flatbuffers::StringDictionary dictionary;
+//   static const auto &host = dictionary.Intern("host-1.example.com");
+//
+//   fbb.SetStringDictionary(&dictionary);
+//   auto name = fbb.CreateSharedString(host);
+//
+// An interned string knows its hash and length, and its id lets a builder
+// find where it wrote the string before by indexing an array, so repeating
+// it costs much less than CreateSharedString() of its characters. Each
+// buffer still holds its own copy of the strings it uses.
+//
+// Intern() is safe to call from several threads, the strings it returns are
+// never changed or moved.
+class StringDictionary {
+ public:
+  StringDictionary() {}
+
+  const InternedString &Intern(const char *str, size_t len) {
+    auto hash = HashStringBytes(str, len);
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t id;
+    if (index_.Find(hash, len, Equals(strings_, str, len), &id)) {
+      return interned_[id];
+    }
+    id = interned_.size();
+    strings_.push_back(std::string(str, len));
+    InternedString interned = { strings_.back().c_str(), len, hash,
+                                static_cast<uint32_t>(id), this };
+    interned_.push_back(interned);
+    index_.Insert(hash, len, id);
+    return interned_.back();
+  }
+
+  const InternedString &Intern(const char *str) {
+    return Intern(str, strlen(str));
+  }
+
+  const InternedString &Intern(const std::string &str) {
+    return Intern(str.c_str(), str.size());
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return interned_.size();
+  }
+
+ private:
+  FLATBUFFERS_DELETE_FUNC(StringDictionary(const StringDictionary &));
+  FLATBUFFERS_DELETE_FUNC(
+      StringDictionary &operator=(const StringDictionary &));
+
+  struct Equals {
+    Equals(const std::deque<std::string> &strings, const char *str,
+           size_t len)
+        : strings_(&strings), str_(str), len_(len) {}
+    bool operator()(size_t id) const {
+      return memcmp((*strings_)[id].data(), str_, len_) == 0;
+    }
+    const std::deque<std::string> *strings_;
+    const char *str_;
+    size_t len_;
+  };
+
+  mutable std::mutex mutex_;  // Guards everything below.
+  // Deques, so that growing them doesn't move the strings handed out.
+  std::deque<std::string> strings_;
+  std::deque<InternedString> interned_;
+  StringOffsetPool index_;  // The ids of the strings by their hashes.
+};
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_HAS_THREADS
+
+#endif  // FLATBUFFERS_STRING_DICTIONARY_H_
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_THREAD_POOL_H_
+#define FLATBUFFERS_THREAD_POOL_H_
+
+#include "flatbuffers/flatbuffers.h"
+
+#if FLATBUFFERS_HAS_THREADS
+#  include <condition_variable>
+#  include <mutex>
+#  include <thread>
+
+namespace flatbuffers {
+
+// A fixed set of threads to run the tasks of a ParallelRunner on, kept
+// around so that a Verifier doesn't start threads for every large vector.
+// The thread calling Run() works on the tasks too. Calls to Run() from
+// different threads take turns, tasks may not call Run() themselves.
+class ThreadPool : public ParallelRunner {
+ public:
+  // Starts `threads - 1` threads.
+  explicit ThreadPool(int threads)
+      : task_(nullptr),
+        context_(nullptr),
+        count_(0),
+        next_(0),
+        pending_(0),
+        stop_(false) {
+    for (int i = 1; i < threads; i++) {
+      workers_.push_back(std::thread(&ThreadPool::Work, this));
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto it = workers_.begin(); it != workers_.end(); ++it) it->join();
+  }
+
+  virtual int Concurrency() const {
+    return static_cast<int>(workers_.size()) + 1;
+  }
+
+  virtual void Run(size_t count, void (*task)(void *context, size_t index),
+                   void *context) {
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    task_ = task;
+    context_ = context;
+    count_ = count;
+    next_ = 0;
+    pending_ = count;
+    work_cv_.notify_all();
+    RunTasks(lock);
+    done_cv_.wait(lock, [this]() { return pending_ == 0; });
+  }
+
+ private:
+  FLATBUFFERS_DELETE_FUNC(ThreadPool(const ThreadPool &));
+  FLATBUFFERS_DELETE_FUNC(ThreadPool &operator=(const ThreadPool &));
+
+  // Takes tasks until there are none left, with `lock` held in between.
+  void RunTasks(std::unique_lock<std::mutex> &lock) {
+    while (next_ < count_) {
+      auto index = next_++;
+      lock.unlock();
+      task_(context_, index);
+      lock.lock();
+      if (--pending_ == 0) done_cv_.notify_all();
+    }
+  }
+
+  void Work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      work_cv_.wait(lock, [this]() { return stop_ || next_ < count_; });
+      if (stop_) return;
+      RunTasks(lock);
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;  // Guards everything below.
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  void (*task_)(void *context, size_t index);
+  void *context_;
+  size_t count_;
+  size_t next_;
+  size_t pending_;
+  bool stop_;
+};
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_HAS_THREADS
+
+#endif  // FLATBUFFERS_THREAD_POOL_H_
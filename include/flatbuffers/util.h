@@ -18,8 +18,10 @@
 #define FLATBUFFERS_UTIL_H_
 
 #include <errno.h>
+#include <stdio.h>
 
 #include "flatbuffers/base.h"
+#include "flatbuffers/decimal_float.h"
 #include "flatbuffers/stl_emulation.h"
 
 #ifndef FLATBUFFERS_PREFER_PRINTF
@@ -195,6 +197,59 @@ template<> inline std::string NumToString<float>(float t) {
   return FloatToString(t, 6);
 }
 
+// Appends the same text as NumToString(t) to `out`, formatting into a stack
+// buffer instead of going through a stringstream and a temporary string.
+template<typename T> void AppendNumberToString(T t, std::string *out) {
+  // Signed values are sign extended, so the top bit is the sign. Negating in
+  // uint64_t also works for the most negative value.
+  auto u = static_cast<uint64_t>(t);
+  const bool negative = !flatbuffers::is_unsigned<T>::value && (u >> 63);
+  if (negative) u = 0 - u;
+  char buf[21];  // 20 digits for 2^64 - 1, or 19 digits and a sign.
+  auto end = buf + sizeof(buf);
+  auto p = end;
+  do {
+    *--p = static_cast<char>('0' + u % 10);
+    u /= 10;
+  } while (u);
+  if (negative) *--p = '-';
+  out->append(p, static_cast<size_t>(end - p));
+}
+
+inline void AppendFloatToString(double t, int precision, std::string *out) {
+  char buf[64];
+  // Non-finite and very large values are rare, leave them to FloatToString.
+  auto len = t - t == 0 ? snprintf(buf, sizeof(buf), "%.*f", precision, t)
+                        : -1;
+  if (len <= 0 || len >= static_cast<int>(sizeof(buf))) {
+    out->append(FloatToString(t, precision));
+    return;
+  }
+  // snprintf uses the decimal separator of the C locale, NumToString always
+  // uses '.'. Copy the digits, replacing whatever separates them by '.'.
+  auto end = buf;
+  auto seen_separator = false;
+  for (auto p = buf; p != buf + len; p++) {
+    if ((*p >= '0' && *p <= '9') || (*p == '-' && p == buf)) {
+      *end++ = *p;
+    } else if (!seen_separator) {
+      *end++ = '.';
+      seen_separator = true;
+    }
+  }
+  // Strip trailing zeroes as FloatToString does, keeping one after the '.'.
+  while (end - buf > 2 && end[-1] == '0' && end[-2] != '.') end--;
+  out->append(buf, static_cast<size_t>(end - buf));
+}
+
+template<> inline void AppendNumberToString<double>(double t,
+                                                    std::string *out) {
+  AppendFloatToString(t, 12, out);
+}
+template<> inline void AppendNumberToString<float>(float t, std::string *out) {
+  AppendFloatToString(t, 6, out);
+}
+
 // Convert an integer value to a hexadecimal string.
 // The returned string length is always xdigits long, prefixed by 0 digits.
 // For example, IntToStringHex(0x23, 8) returns the string "00000023".
@@ -278,6 +333,81 @@ inline void strtoval_impl(float *val, const char *str, char **endptr) {
 #undef __strtof_impl
 // clang-format on
 
+// Locale-independent parser of integers in the `[+-][0x]digits` form with
+// base 10 or 16. Returns false if the whole string isn't in that form (the
+// caller falls back to strtoll/strtoull then), otherwise the magnitude and
+// sign of the number, with `overflow` set if the magnitude doesn't fit.
+inline bool ScanInteger(const char *s, int base, uint64_t *magnitude,
+                        bool *negative, bool *overflow) {
+  FLATBUFFERS_ASSERT(base == 10 || base == 16);
+  *negative = (*s == '-');
+  if (*s == '-' || *s == '+') s++;
+  if (base == 16 && s[0] == '0' && is_alpha_char(s[1], 'X') && is_xdigit(s[2]))
+    s += 2;
+  const auto start = s;
+  uint64_t v = 0;
+  auto ovf = false;
+  if (base == 10) {
+    const uint64_t kMaxDiv10 = (flatbuffers::numeric_limits<uint64_t>::max)() /
+                               10;  // 1844674407370955161
+    for (;; s++) {
+      const auto d = static_cast<unsigned>(static_cast<unsigned char>(*s)) -
+                     static_cast<unsigned>('0');
+      if (d > 9) break;
+      ovf |= (v > kMaxDiv10) || (v == kMaxDiv10 && d > 5);
+      v = v * 10 + d;
+    }
+  } else {
+    for (;; s++) {
+      const auto c = static_cast<unsigned>(static_cast<unsigned char>(*s));
+      const auto d = c - static_cast<unsigned>('0');
+      // ASCII only: alpha to lower case => set bit 0x20.
+      const auto x = (c | 0x20) - static_cast<unsigned>('a');
+      unsigned digit;
+      if (d <= 9) {
+        digit = d;
+      } else if (x <= 5) {
+        digit = x + 10;
+      } else {
+        break;
+      }
+      ovf |= (v >> 60) != 0;
+      v = (v << 4) | digit;
+    }
+  }
+  *magnitude = v;
+  *overflow = ovf;
+  return (s != start) && (*s == '\0');
+}
+
+// Applies strtoll() rules to the magnitude and sign: out of range values are
+// clamped to MIN/MAX and reported by returning false (ERANGE).
+inline bool IntegerFromMagnitude(int64_t *val, uint64_t magnitude,
+                                 bool negative, bool overflow) {
+  const auto max = static_cast<uint64_t>(
+      (flatbuffers::numeric_limits<int64_t>::max)());
+  if (overflow || magnitude > max + (negative ? 1 : 0)) {
+    *val = negative ? flatbuffers::numeric_limits<int64_t>::lowest()
+                    : (flatbuffers::numeric_limits<int64_t>::max)();
+    return false;
+  }
+  *val = negative && magnitude ? -static_cast<int64_t>(magnitude - 1) - 1
+                               : static_cast<int64_t>(magnitude);
+  return true;
+}
+
+// Applies strtoull() rules: a negative number is negated as if by unary
+// minus in the result type, out of range values are clamped to MAX.
+inline bool IntegerFromMagnitude(uint64_t *val, uint64_t magnitude,
+                                 bool negative, bool overflow) {
+  if (overflow) {
+    *val = (flatbuffers::numeric_limits<uint64_t>::max)();
+    return false;
+  }
+  *val = negative ? 0 - magnitude : magnitude;
+  return true;
+}
+
 // Adaptor for strtoull()/strtoll().
 // Flatbuffers accepts numbers with any count of leading zeros (-009 is -9),
 // while strtoll with base=0 interprets first leading zero as octal prefix.
@@ -304,6 +434,16 @@ inline bool StringToIntegerImpl(T *val, const char *const str,
     // if a prefix not match, try base=10
     return StringToIntegerImpl(val, str, 10, check_errno);
   } else {
+    // Fast path: decimal and hexadecimal numbers without strtoll/strtoull.
+    if (base == 10 || base == 16) {
+      uint64_t magnitude;
+      bool negative, overflow;
+      if (ScanInteger(str, base, &magnitude, &negative, &overflow)) {
+        // Without the errno check an out of range result is MAX/MIN.
+        return IntegerFromMagnitude(val, magnitude, negative, overflow) ||
+               !check_errno;
+      }
+    }
     if (check_errno) errno = 0;  // clear thread-local errno
     auto endptr = str;
     strtoval_impl(val, str, const_cast<char **>(&endptr), base);
@@ -321,6 +461,8 @@ template<typename T>
 inline bool StringToFloatImpl(T *val, const char *const str) {
   // Type T must be either float or double.
   FLATBUFFERS_ASSERT(str && val);
+  // Fast path: decimal numbers, nan/inf and hex-floats go to strtod.
+  if (ParseDecimalFloat(str, val)) return true;
   auto end = str;
   strtoval_impl(val, str, const_cast<char **>(&end));
   auto done = (end != str) && (*end == '\0');
@@ -682,6 +824,95 @@ inline std::string BufferToHexText(const void *buffer, size_t buffer_size,
   return text;
 }
 
+// Output sink for generated text (JSON), used to stream large outputs instead
+// of building them in one std::string.
+// Generators append to buffer() and call MaybeFlush() at points where no
+// text already generated will be modified again. Once the buffer holds at
+// least `chunk_size` bytes it is handed to Write() and cleared (keeping its
+// capacity), so memory use is bounded by the chunk size plus the text of the
+// largest single value.
+class TextSink {
+ public:
+  explicit TextSink(size_t chunk_size = 64 * 1024)
+      : chunk_size_(chunk_size), ok_(true) {
+    buffer_.reserve(chunk_size);
+  }
+  virtual ~TextSink() {}
+
+  std::string &buffer() { return buffer_; }
+
+  // Returns false if a previous Write() failed, the rest of the text is
+  // discarded in that case.
+  bool MaybeFlush() { return buffer_.size() >= chunk_size_ ? Flush() : ok_; }
+
+  bool Flush() {
+    if (!buffer_.empty()) {
+      if (ok_) ok_ = Write(buffer_.data(), buffer_.size());
+      buffer_.clear();
+    }
+    return ok_;
+  }
+
+ protected:
+  virtual bool Write(const char *data, size_t size) = 0;
+
+ private:
+  FLATBUFFERS_DELETE_FUNC(TextSink(const TextSink &));
+  FLATBUFFERS_DELETE_FUNC(TextSink &operator=(const TextSink &));
+
+  std::string buffer_;
+  size_t chunk_size_;
+  bool ok_;
+};
+
+// Writes the text to a stdio stream, the stream is not closed.
+class FileTextSink : public TextSink {
+ public:
+  explicit FileTextSink(FILE *file, size_t chunk_size = 64 * 1024)
+      : TextSink(chunk_size), file_(file) {}
+
+ protected:
+  virtual bool Write(const char *data, size_t size) {
+    return fwrite(data, 1, size, file_) == size;
+  }
+
+ private:
+  FILE *file_;
+};
+
+// Writes the text to a file descriptor, the descriptor is not closed.
+class FdTextSink : public TextSink {
+ public:
+  explicit FdTextSink(int fd, size_t chunk_size = 64 * 1024)
+      : TextSink(chunk_size), fd_(fd) {}
+
+ protected:
+  virtual bool Write(const char *data, size_t size);  // See util.cpp.
+
+ private:
+  int fd_;
+};
+
+// Passes the text to a user callback, which returns false on failure.
+typedef bool (*TextSinkCallback)(void *context, const char *data,
+                                 size_t size);
+
+class CallbackTextSink : public TextSink {
+ public:
+  CallbackTextSink(TextSinkCallback callback, void *context,
+                   size_t chunk_size = 64 * 1024)
+      : TextSink(chunk_size), callback_(callback), context_(context) {}
+
+ protected:
+  virtual bool Write(const char *data, size_t size) {
+    return callback_(context_, data, size);
+  }
+
+ private:
+  TextSinkCallback callback_;
+  void *context_;
+};
+
 // Remove paired quotes in a string: "text"|'text' -> text.
 std::string RemoveStringQuotes(const std::string &s);
 
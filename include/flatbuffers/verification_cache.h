@@ -0,0 +1,172 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_VERIFICATION_CACHE_H_
+#define FLATBUFFERS_VERIFICATION_CACHE_H_
+
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/hash.h"
+
+#if FLATBUFFERS_HAS_THREADS
+#  include <mutex>
+#  include <random>
+#  include <unordered_map>
+
+namespace flatbuffers {
+
+// Remembers buffers that passed verification, for servers that are sent the
+// same buffers over and over (cached responses, retries, fan-out copies):
+//
+//   flatbuffers::VerificationCache cache(1024);
+//   if (!cache.Verify(buf, len, VerifyMonsterBuffer)) { /* Reject. */ }
+//
+// A buffer is known by the XXH64 hash of its bytes, its size and the verify
+// function, the generated Verify<Root>Buffer() or its size prefixed version.
+// Hashing reads the whole buffer once, which is still much cheaper than
+// verifying a buffer with many tables. The hash seed is random so that
+// senders can't work out a buffer that collides with one seen before.
+//
+// Only successes are remembered, at most `capacity` of them. When full, the
+// least recently hit entries are replaced first (the CLOCK approximation of
+// LRU, which doesn't reorder anything on a hit). Safe to share between
+// threads, verification itself runs outside the lock.
+class VerificationCache {
+ public:
+  typedef bool (*VerifyFunction)(Verifier &verifier);
+
+  // The other arguments are used for the Verifier of every buffer.
+  explicit VerificationCache(size_t capacity, uoffset_t max_depth = 64,
+                             uoffset_t max_tables = 1000000,
+                             bool check_alignment = true)
+      : capacity_(capacity),
+        max_depth_(max_depth),
+        max_tables_(max_tables),
+        check_alignment_(check_alignment),
+        hand_(0),
+        hits_(0),
+        misses_(0) {
+    std::random_device random;
+    seed_ = (static_cast<uint64_t>(random()) << 32) ^ random();
+  }
+
+  // Same result as calling `verify` on a Verifier for `buf`.
+  bool Verify(const uint8_t *buf, size_t len, VerifyFunction verify) {
+    Key key = { HashXxh64(buf, len, seed_), len, verify };
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(key);
+      if (it != index_.end()) {
+        slots_[it->second].referenced = true;
+        hits_++;
+        return true;
+      }
+      misses_++;
+    }
+    Verifier verifier(buf, len, max_depth_, max_tables_, check_alignment_);
+    if (!verify(verifier)) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    Insert(key);
+    return true;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    slots_.clear();
+    hand_ = 0;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_.size();
+  }
+
+  // Calls of Verify() that were answered from the cache, and those that had
+  // to verify the buffer.
+  size_t hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+  }
+
+  size_t misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+  }
+
+ private:
+  FLATBUFFERS_DELETE_FUNC(VerificationCache(const VerificationCache &));
+  FLATBUFFERS_DELETE_FUNC(
+      VerificationCache &operator=(const VerificationCache &));
+
+  struct Key {
+    uint64_t hash;
+    size_t size;
+    VerifyFunction verify;
+
+    bool operator==(const Key &other) const {
+      return hash == other.hash && size == other.size && verify == other.verify;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const {
+      return static_cast<size_t>(key.hash);
+    }
+  };
+
+  struct Slot {
+    Key key;
+    bool referenced;  // Hit since the clock hand last passed.
+  };
+
+  void Insert(const Key &key) {
+    // Another thread may have verified the same buffer meanwhile.
+    if (!capacity_ || index_.count(key)) return;
+    Slot slot = { key, false };
+    if (slots_.size() < capacity_) {
+      index_[key] = slots_.size();
+      slots_.push_back(slot);
+      return;
+    }
+    // Give entries hit since the last pass a second chance.
+    while (slots_[hand_].referenced) {
+      slots_[hand_].referenced = false;
+      hand_ = (hand_ + 1) % capacity_;
+    }
+    index_.erase(slots_[hand_].key);
+    index_[key] = hand_;
+    slots_[hand_] = slot;
+    hand_ = (hand_ + 1) % capacity_;
+  }
+
+  const size_t capacity_;
+  const uoffset_t max_depth_;
+  const uoffset_t max_tables_;
+  const bool check_alignment_;
+  uint64_t seed_;
+  mutable std::mutex mutex_;  // Guards everything below.
+  std::unordered_map<Key, size_t, KeyHash> index_;  // Into slots_.
+  std::vector<Slot> slots_;
+  size_t hand_;
+  size_t hits_;
+  size_t misses_;
+};
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_HAS_THREADS
+
+#endif  // FLATBUFFERS_VERIFICATION_CACHE_H_
@@ -87,6 +87,10 @@ std::string FlatCompiler::GetUsageString(const char *program_name) const {
     "                         By default, UTF-8 characters are printed as \\uXXXX escapes.\n"
     "  --defaults-json        Output fields whose value is the default when\n"
     "                         writing JSON\n"
+    "  --json-threads N       Print large vectors of tables on N threads when\n"
+    "                         writing JSON (default 1).\n"
+    "  --json-chunk-size N    Elements of a vector printed per task with\n"
+    "                         --json-threads (default 4096).\n"
     "  --unknown-json         Allow fields in JSON that are not defined in the\n"
     "                         schema. These fields will be discared when generating\n"
     "                         binaries.\n"
@@ -103,6 +107,10 @@ std::string FlatCompiler::GetUsageString(const char *program_name) const {
     "  --gen-name-strings     Generate type name functions for C++ and Rust.\n"
     "  --gen-object-api       Generate an additional object-based API.\n"
     "  --gen-compare          Generate operator== for object-based API types.\n"
+    "  --gen-json             Generate ToJson/FromJson functions for C++ that need\n"
+    "                         neither the schema nor the parser at runtime.\n"
+    "  --gen-packed-size      Generate PackedSizeUpperBound() for object API types,\n"
+    "                         to reserve the builder before Pack().\n"
     "  --gen-nullable         Add Clang _Nullable for C++ pointer. or @Nullable for Java\n"
     "  --java-checkerframe    work Add @Pure for Java.\n"
     "  --gen-generated        Add @Generated annotation for Java\n"
@@ -260,6 +268,14 @@ int FlatCompiler::Compile(int argc, const char **argv) {
         opts.go_import = argv[argi];
       } else if (arg == "--defaults-json") {
         opts.output_default_scalars_in_json = true;
+      } else if (arg == "--json-threads") {
+        if (++argi >= argc) Error("missing thread count following: " + arg);
+        opts.json_threads = static_cast<int>(
+            std::max<int64_t>(flatbuffers::StringToInt(argv[argi]), 1));
+      } else if (arg == "--json-chunk-size") {
+        if (++argi >= argc) Error("missing chunk size following: " + arg);
+        opts.json_chunk_size = static_cast<size_t>(
+            std::max<int64_t>(flatbuffers::StringToInt(argv[argi]), 1));
       } else if (arg == "--unknown-json") {
         opts.skip_unexpected_fields_in_json = true;
       } else if (arg == "--no-prefix") {
@@ -391,6 +407,10 @@ int FlatCompiler::Compile(int argc, const char **argv) {
         opts.cpp_std = arg.substr(std::string("--cpp-std=").size());
       } else if (arg == "--cpp-static-reflection") {
         opts.cpp_static_reflection = true;
+      } else if (arg == "--gen-json") {
+        opts.cpp_gen_json = true;
+      } else if (arg == "--gen-packed-size") {
+        opts.cpp_gen_packed_size = true;
       } else {
         for (size_t i = 0; i < params_.num_generators; ++i) {
           if (arg == params_.generators[i].generator_opt_long ||
@@ -345,6 +345,7 @@ class CppGenerator : public BaseGenerator {
     if (parser_.uses_flexbuffers_) {
       code_ += "#include \"flatbuffers/flexbuffers.h\"";
     }
+    if (opts_.cpp_gen_json) { code_ += "#include \"flatbuffers/json.h\""; }
     code_ += "";
 
     if (opts_.include_dependence_headers) { GenIncludeDependencies(); }
@@ -469,6 +470,9 @@ class CppGenerator : public BaseGenerator {
       }
     }
 
+    // Generate JSON serializers.
+    if (opts_.cpp_gen_json) { GenJson(); }
+
     // Generate convenient global helper functions:
     if (parser_.root_struct_def_) {
       auto &struct_def = *parser_.root_struct_def_;
@@ -596,6 +600,29 @@ class CppGenerator : public BaseGenerator {
         code_ += "}";
         code_ += "";
       }
+
+      if (opts_.cpp_gen_json) {
+        code_ += "inline bool {{STRUCT_NAME}}BufferToJson(";
+        code_ += "    const void *buf, flatbuffers::JsonWriter &writer) {";
+        code_ += "  auto ok = {{STRUCT_NAME}}ToJson(Get{{STRUCT_NAME}}(buf), "
+                 "writer);";
+        code_ += "  return writer.Finish() && ok;";
+        code_ += "}";
+        code_ += "";
+
+        code_ += "inline bool {{STRUCT_NAME}}BufferFromJson(";
+        code_ += "    flatbuffers::JsonReader &reader,";
+        code_ += "    flatbuffers::FlatBufferBuilder &fbb) {";
+        code_ += "  flatbuffers::Offset<{{CPP_NAME}}> root;";
+        code_ += "  if (!{{STRUCT_NAME}}FromJson(reader, fbb, &root) ||";
+        code_ += "      !reader.Finish()) {";
+        code_ += "    return false;";
+        code_ += "  }";
+        code_ += "  Finish{{STRUCT_NAME}}Buffer(fbb, root);";
+        code_ += "  return true;";
+        code_ += "}";
+        code_ += "";
+      }
     }
 
     if (cur_name_space_) SetNameSpace(nullptr);
@@ -950,6 +977,19 @@ class CppGenerator : public BaseGenerator {
            (inclass ? " = nullptr" : "") + ") const";
   }
 
+  std::string UnionPackedSizeSignature(const EnumDef &enum_def, bool inclass) {
+    return "size_t " + (inclass ? "" : Name(enum_def) + "Union::") +
+           "PackedSizeUpperBound() const";
+  }
+
+  std::string TablePackedSizeSignature(const StructDef &struct_def,
+                                       bool inclass, const IDLOptions &opts) {
+    return std::string(inclass ? "static " : "") + "size_t " +
+           (inclass ? "" : Name(struct_def) + "::") +
+           "PackedSizeUpperBound(const " +
+           NativeName(Name(struct_def), &struct_def, opts) + " &_o)";
+  }
+
   std::string TableCreateSignature(const StructDef &struct_def, bool predecl,
                                    const IDLOptions &opts) {
     return "flatbuffers::Offset<" + Name(struct_def) + "> Create" +
@@ -1342,6 +1382,9 @@ class CppGenerator : public BaseGenerator {
       }
       code_ += "  " + UnionUnPackSignature(enum_def, true) + ";";
       code_ += "  " + UnionPackSignature(enum_def, true) + ";";
+      if (opts_.cpp_gen_packed_size) {
+        code_ += "  " + UnionPackedSizeSignature(enum_def, true) + ";";
+      }
       code_ += "";
 
       for (auto it = enum_def.Vals().begin(); it != enum_def.Vals().end();
@@ -1543,6 +1586,8 @@ class CppGenerator : public BaseGenerator {
       code_ += "}";
       code_ += "";
 
+      if (opts_.cpp_gen_packed_size) { GenUnionPackedSize(enum_def); }
+
       // Union copy constructor
       code_ +=
           "inline {{ENUM_NAME}}Union::{{ENUM_NAME}}Union(const "
@@ -2374,6 +2419,9 @@ class CppGenerator : public BaseGenerator {
       code_ += "  " + TableUnPackSignature(struct_def, true, opts_) + ";";
       code_ += "  " + TableUnPackToSignature(struct_def, true, opts_) + ";";
       code_ += "  " + TablePackSignature(struct_def, true, opts_) + ";";
+      if (opts_.cpp_gen_packed_size) {
+        code_ += "  " + TablePackedSizeSignature(struct_def, true, opts_) + ";";
+      }
     }
 
     code_ += "};";  // End of table.
@@ -3017,6 +3065,137 @@ class CppGenerator : public BaseGenerator {
     return code;
   }
 
+  // Upper bound on what a string of `length` bytes adds to a builder: the
+  // length, the terminator and padding.
+  static std::string PackedStringSize(const std::string &length) {
+    return length + " + " + NumToString(2 * sizeof(uoffset_t));
+  }
+
+  // Upper bound on what a vector of `count` elements adds to a builder: the
+  // length, padding before it and before the elements.
+  static std::string PackedVectorSize(const std::string &count,
+                                      size_t elem_size, size_t align) {
+    return count + " * " + NumToString(elem_size) + " + " +
+           NumToString(2 * sizeof(uoffset_t) + align);
+  }
+
+  // Generates T::PackedSizeUpperBound(), which bounds what CreateT(_fbb, _o)
+  // adds to a builder including the scratch space it uses, for
+  // FlatBufferBuilder::Reserve(). Every Align() adds less than the alignment.
+  void GenTablePackedSize(const StructDef &struct_def) {
+    // The soffset to the vtable with its padding, the vtable, and the offset
+    // to it the builder keeps in scratch space for deduplicating.
+    size_t fixed = 2 * sizeof(soffset_t) - 1 +
+                   (struct_def.fields.vec.size() + 2) * sizeof(voffset_t) +
+                   sizeof(uoffset_t);
+    std::vector<std::string> lines;
+    for (auto it = struct_def.fields.vec.begin();
+         it != struct_def.fields.vec.end(); ++it) {
+      const auto &field = **it;
+      if (field.deprecated) { continue; }
+      const auto &type = field.value.type;
+      // The field with its padding, and its location in scratch space while
+      // the table is built.
+      fixed += InlineSize(type) + InlineAlignment(type) - 1 +
+               2 * sizeof(uoffset_t);
+      auto value = "_o." + Name(field);
+      switch (type.base_type) {
+        case BASE_TYPE_STRING:
+          lines.push_back("_size += " + PackedStringSize(value + ".length()") +
+                          ";");
+          break;
+        case BASE_TYPE_STRUCT:
+          if (!IsStruct(type)) {
+            lines.push_back("if (" + value + ") { _size += " +
+                            WrapInNameSpace(*type.struct_def) +
+                            "::PackedSizeUpperBound(*" + value +
+                            GenPtrGet(field) + "); }");
+          }
+          break;
+        case BASE_TYPE_UNION:
+          lines.push_back("_size += " + value + ".PackedSizeUpperBound();");
+          break;
+        case BASE_TYPE_VECTOR: {
+          const auto vector_type = type.VectorType();
+          const auto *force_align = field.attributes.Lookup("force_align");
+          auto align = InlineAlignment(vector_type);
+          if (force_align) {
+            align = (std::max)(
+                align, static_cast<size_t>(atoi(force_align->constant.c_str())));
+          }
+          if (vector_type.base_type == BASE_TYPE_UTYPE) {
+            value = StripUnionType(value);
+          }
+          lines.push_back(
+              "_size += " +
+              PackedVectorSize(value + ".size()", InlineSize(vector_type),
+                               align) +
+              ";");
+          const auto elem = value + "[_i]";
+          std::string elem_size;
+          if (vector_type.base_type == BASE_TYPE_STRING) {
+            // CreateVectorOfStrings() keeps the offsets in scratch space.
+            lines.push_back("_size += " + value + ".size() * " +
+                            NumToString(sizeof(uoffset_t)) + ";");
+            elem_size = PackedStringSize(elem + ".length()");
+          } else if (vector_type.base_type == BASE_TYPE_UNION) {
+            elem_size = elem + ".PackedSizeUpperBound()";
+          } else if (vector_type.base_type == BASE_TYPE_STRUCT &&
+                     !IsStruct(vector_type)) {
+            elem_size = WrapInNameSpace(*vector_type.struct_def) +
+                        "::PackedSizeUpperBound(*" + elem + GenPtrGet(field) +
+                        ")";
+          }
+          if (!elem_size.empty()) {
+            lines.push_back("for (size_t _i = 0; _i < " + value +
+                            ".size(); _i++) { _size += " + elem_size + "; }");
+          }
+          break;
+        }
+        default: break;
+      }
+    }
+    code_ += "inline " + TablePackedSizeSignature(struct_def, false, opts_) +
+             " {";
+    if (lines.empty()) { code_ += "  (void)_o;"; }
+    code_ += "  size_t _size = " + NumToString(fixed) + ";";
+    for (auto it = lines.begin(); it != lines.end(); ++it) {
+      code_ += "  " + *it;
+    }
+    code_ += "  return _size;";
+    code_ += "}";
+    code_ += "";
+  }
+
+  void GenUnionPackedSize(const EnumDef &enum_def) {
+    code_ += "inline " + UnionPackedSizeSignature(enum_def, false) + " {";
+    code_ += "  switch (type) {";
+    for (auto it = enum_def.Vals().begin(); it != enum_def.Vals().end();
+         ++it) {
+      const auto &ev = **it;
+      if (ev.IsZero()) { continue; }
+      code_.SetValue("LABEL", GetEnumValUse(enum_def, ev));
+      code_.SetValue("TYPE", GetUnionElement(ev, true, opts_));
+      std::string size;
+      if (IsString(ev.union_type)) {
+        size = PackedStringSize(
+            "reinterpret_cast<const {{TYPE}} *>(value)->length()");
+      } else if (IsStruct(ev.union_type)) {
+        size = NumToString(InlineSize(ev.union_type) +
+                           InlineAlignment(ev.union_type) - 1);
+      } else {
+        size = WrapInNameSpace(*ev.union_type.struct_def) +
+               "::PackedSizeUpperBound(*reinterpret_cast<const {{TYPE}} "
+               "*>(value))";
+      }
+      code_ += "    case {{LABEL}}: return " + size + ";";
+    }
+    code_ += "    default: return 0;";
+    code_ += "  }";
+    code_ += "}";
+    code_ += "";
+  }
+
   // Generate code for tables that needs to come after the regular definition.
   void GenTablePost(const StructDef &struct_def) {
     if (opts_.generate_object_based_api) { GenNativeTablePost(struct_def); }
@@ -3080,6 +3259,8 @@ class CppGenerator : public BaseGenerator {
       code_ += "}";
       code_ += "";
 
+      if (opts_.cpp_gen_packed_size) { GenTablePackedSize(struct_def); }
+
       // Generate a CreateX method that works with an unpacked C++ object.
       code_ +=
           "inline " + TableCreateSignature(struct_def, false, opts_) + " {";
@@ -3458,6 +3639,684 @@ class CppGenerator : public BaseGenerator {
     if (opts_.g_cpp_std >= cpp::CPP_STD_17) { GenTraitsStruct(struct_def); }
   }
 
+  // JSON serializers, generated with --gen-json. See flatbuffers/json.h.
+
+  std::string JsonFunction(const Definition &def, const char *suffix) {
+    return WrapInNameSpace(def.defined_namespace, Name(def) + suffix);
+  }
+
+  std::string JsonEnumTable(const EnumDef &enum_def) {
+    return JsonFunction(enum_def, "JsonEnum") + "()";
+  }
+
+  std::string JsonToSignature(const StructDef &struct_def) {
+    return "bool " + Name(struct_def) + "ToJson(const " + Name(struct_def) +
+           " *obj, flatbuffers::JsonWriter &writer)";
+  }
+
+  std::string JsonFromSignature(const StructDef &struct_def) {
+    if (struct_def.fixed) {
+      return "bool " + Name(struct_def) +
+             "FromJson(flatbuffers::JsonReader &_reader, " + Name(struct_def) +
+             " *_o)";
+    }
+    return "bool " + Name(struct_def) +
+           "FromJson(flatbuffers::JsonReader &_reader, "
+           "flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<" +
+           Name(struct_def) + "> *_o)";
+  }
+
+  std::string UnionJsonToSignature(const EnumDef &enum_def) {
+    return "bool " + Name(enum_def) + "ToJson(const void *obj, " +
+           Name(enum_def) + " type, flatbuffers::JsonWriter &writer)";
+  }
+
+  std::string UnionJsonFromSignature(const EnumDef &enum_def) {
+    return "bool " + Name(enum_def) +
+           "FromJson(flatbuffers::JsonReader &_reader, "
+           "flatbuffers::FlatBufferBuilder &_fbb, " +
+           Name(enum_def) + " type, flatbuffers::Offset<void> *_o)";
+  }
+
+  void GenJsonDecls(const StructDef *struct_def, const EnumDef *enum_def) {
+    if (struct_def) {
+      code_ += "inline " + JsonToSignature(*struct_def) + ";";
+      code_ += "inline " + JsonFromSignature(*struct_def) + ";";
+    } else if (enum_def->is_union) {
+      code_ += "inline " + UnionJsonToSignature(*enum_def) + ";";
+      code_ += "inline " + UnionJsonFromSignature(*enum_def) + ";";
+    }
+  }
+
+  void GenJsonEnum(const EnumDef &enum_def) {
+    code_.SetValue("ENUM_NAME", Name(enum_def));
+    code_.SetValue("NUM_VALUES", NumToString(enum_def.size()));
+    code_.SetValue("BIT_FLAGS", enum_def.attributes.Lookup("bit_flags")
+                                    ? "true"
+                                    : "false");
+    std::string values;
+    std::string names;
+    for (auto it = enum_def.Vals().begin(); it != enum_def.Vals().end();
+         ++it) {
+      const auto &ev = **it;
+      if (it != enum_def.Vals().begin()) {
+        values += ", ";
+        names += ",\n";
+      }
+      values +=
+          NumToStringCpp(NumToString(ev.GetAsInt64()), BASE_TYPE_LONG);
+      names += "    \"" + ev.name + "\"";
+    }
+    code_ += "inline const flatbuffers::JsonEnum *{{ENUM_NAME}}JsonEnum() {";
+    code_ += "  static const int64_t values[] = { " + values + " };";
+    code_ += "  static const char * const names[] = {";
+    code_ += names;
+    code_ += "  };";
+    code_ += "  static const flatbuffers::JsonEnum json_enum = {";
+    code_ += "    {{NUM_VALUES}}, values, names, {{BIT_FLAGS}}";
+    code_ += "  };";
+    code_ += "  return &json_enum;";
+    code_ += "}";
+    code_ += "";
+  }
+
+  // Writes a value of `type`: scalars are passed in their wire type,
+  // anything else by pointer.
+  void GenJsonWriteValue(const Type &type, const std::string &val,
+                         const std::string &indent) {
+    if (type.base_type == BASE_TYPE_BOOL) {
+      code_ += indent + "writer.Bool(" + val + " != 0);";
+    } else if (IsScalar(type.base_type) && type.enum_def) {
+      code_ += indent + "writer.Enum(" + val + ", " +
+               JsonEnumTable(*type.enum_def) + ");";
+    } else if (IsScalar(type.base_type)) {
+      code_ += indent + "writer.Number(" + val + ");";
+    } else if (IsString(type)) {
+      code_ += indent + "writer.String(" + val + ");";
+    } else {
+      FLATBUFFERS_ASSERT(type.base_type == BASE_TYPE_STRUCT);
+      code_ += indent + "if (!" + JsonFunction(*type.struct_def, "ToJson") +
+               "(" + val + ", writer)) return false;";
+    }
+  }
+
+  void GenJsonWriteArray(const Type &type, const std::string &size,
+                         const std::string &elem, const std::string &indent) {
+    code_ += indent + "writer.StartArray();";
+    code_ += indent + "for (flatbuffers::uoffset_t i = 0; i < " + size +
+             "; i++) {";
+    code_ += indent + "  writer.Element();";
+    GenJsonWriteValue(type, elem, indent + "  ");
+    code_ += indent + "}";
+    code_ += indent + "writer.EndArray();";
+  }
+
+  void GenStructToJson(const StructDef &struct_def) {
+    code_ += "inline " + JsonToSignature(struct_def) + " {";
+    code_ += "  auto p = reinterpret_cast<const uint8_t *>(obj);";
+    code_ += "  writer.StartObject();";
+    for (auto it = struct_def.fields.vec.begin();
+         it != struct_def.fields.vec.end(); ++it) {
+      const auto &field = **it;
+      const auto &type = field.value.type;
+      const auto offset = NumToString(field.value.offset);
+      code_ += "  writer.Key(\"" + field.name + "\");";
+      if (IsArray(type)) {
+        const auto vtype = type.VectorType();
+        const auto elem_size = NumToString(InlineSize(vtype));
+        const auto elem_ptr = "p + " + offset + " + i * " + elem_size;
+        GenJsonWriteArray(vtype, NumToString(type.fixed_length),
+                          JsonStructElement(vtype, elem_ptr), "  ");
+      } else {
+        GenJsonWriteValue(type, JsonStructElement(type, "p + " + offset),
+                          "  ");
+      }
+    }
+    code_ += "  writer.EndObject();";
+    code_ += "  return writer.ok();";
+    code_ += "}";
+    code_ += "";
+  }
+
+  // The value of a struct field, or array element, at `ptr`.
+  std::string JsonStructElement(const Type &type, const std::string &ptr) {
+    if (IsStruct(type)) {
+      return "reinterpret_cast<const " + WrapInNameSpace(*type.struct_def) +
+             " *>(" + ptr + ")";
+    }
+    return "flatbuffers::ReadScalar<" + GenTypeBasic(type, false) + ">(" +
+           ptr + ")";
+  }
+
+  void GenTableToJson(const StructDef &struct_def) {
+    code_ += "inline " + JsonToSignature(struct_def) + " {";
+    bool has_fields = false;
+    for (auto it = struct_def.fields.vec.begin();
+         it != struct_def.fields.vec.end(); ++it) {
+      has_fields = has_fields || !(*it)->deprecated;
+    }
+    if (has_fields) {
+      code_ += "  auto table = "
+               "reinterpret_cast<const flatbuffers::Table *>(obj);";
+    } else {
+      code_ += "  (void)obj;";
+    }
+    code_ += "  writer.StartObject();";
+    for (auto it = struct_def.fields.vec.begin();
+         it != struct_def.fields.vec.end(); ++it) {
+      const auto &field = **it;
+      if (field.deprecated) continue;
+      const auto &type = field.value.type;
+      const auto vt = Name(struct_def) + "::" + GenFieldOffsetName(field);
+      if (!IsScalar(type.base_type)) {
+        code_ += "  if (table->CheckField(" + vt + ")) {";
+      } else if (field.key) {
+        code_ += "  {";
+      } else if (field.IsScalarOptional()) {
+        // Unset optional scalars are null, which is the same as absent.
+        code_ += "  if (table->CheckField(" + vt + ")) {";
+      } else {
+        code_ += "  if (table->CheckField(" + vt + ") ||";
+        code_ += "      writer.options().output_default_scalars_in_json) {";
+      }
+      code_ += "    writer.Key(\"" + field.name + "\");";
+      if (IsScalar(type.base_type)) {
+        const auto default_value =
+            field.IsScalarOptional() ? "0" : GenDefaultConstant(field);
+        GenJsonWriteValue(type,
+                          "table->GetField<" + GenTypeBasic(type, false) +
+                              ">(" + vt + ", " + default_value + ")",
+                          "    ");
+      } else if (IsStruct(type)) {
+        GenJsonWriteValue(type,
+                          "table->GetStruct<const " +
+                              WrapInNameSpace(*type.struct_def) + " *>(" + vt +
+                              ")",
+                          "    ");
+      } else if (type.base_type == BASE_TYPE_UNION) {
+        const auto type_field = JsonUnionTypeField(struct_def, field);
+        code_ += "    if (!" + JsonFunction(*type.enum_def, "ToJson") +
+                 "(table->GetPointer<const void *>(" + vt + "),";
+        code_ += "        static_cast<" + WrapInNameSpace(*type.enum_def) +
+                 ">(table->GetField<uint8_t>(" + type_field + ", 0)),";
+        code_ += "        writer)) {";
+        code_ += "      return false;";
+        code_ += "    }";
+      } else if (IsVector(type)) {
+        const auto vtype = type.VectorType();
+        code_ += "    auto vec = table->GetPointer<const " +
+                 GenTypePointer(type) + " *>(" + vt + ");";
+        if (field.flexbuffer) {
+          code_ += "    writer.FlexBuffer(vec);";
+        } else if (field.nested_flatbuffer) {
+          const auto &nested = *field.nested_flatbuffer;
+          code_ += "    if (!" + JsonFunction(nested, "ToJson") +
+                   "(flatbuffers::GetRoot<" + WrapInNameSpace(nested) +
+                   ">(vec->data()), writer)) {";
+          code_ += "      return false;";
+          code_ += "    }";
+        } else if (vtype.base_type == BASE_TYPE_UNION) {
+          const auto type_field = JsonUnionTypeField(struct_def, field);
+          code_ += "    auto types = table->GetPointer<const "
+                   "flatbuffers::Vector<uint8_t> *>(" +
+                   type_field + ");";
+          code_ += "    if (!types || types->size() != vec->size()) "
+                   "return false;";
+          code_ += "    writer.StartArray();";
+          code_ += "    for (flatbuffers::uoffset_t i = 0; i < vec->size(); "
+                   "i++) {";
+          code_ += "      writer.Element();";
+          code_ += "      if (!" + JsonFunction(*vtype.enum_def, "ToJson") +
+                   "(vec->Get(i),";
+          code_ += "          static_cast<" + WrapInNameSpace(*vtype.enum_def) +
+                   ">(types->Get(i)), writer)) {";
+          code_ += "        return false;";
+          code_ += "      }";
+          code_ += "    }";
+          code_ += "    writer.EndArray();";
+        } else {
+          auto elem = std::string("vec->Get(i)");
+          if (IsScalar(vtype.base_type) && VectorElementUserFacing(vtype)) {
+            elem = "static_cast<" + GenTypeBasic(vtype, false) + ">(" + elem +
+                   ")";
+          }
+          GenJsonWriteArray(vtype, "vec->size()", elem, "    ");
+        }
+      } else {
+        GenJsonWriteValue(type,
+                          "table->GetPointer<const " + GenTypePointer(type) +
+                              " *>(" + vt + ")",
+                          "    ");
+      }
+      code_ += "  }";
+    }
+    code_ += "  writer.EndObject();";
+    code_ += "  return writer.ok();";
+    code_ += "}";
+    code_ += "";
+  }
+
+  // The vtable offset of the `_type` field that goes with a union field.
+  std::string JsonUnionTypeField(const StructDef &struct_def,
+                                 const FieldDef &field) {
+    auto type_field =
+        struct_def.fields.Lookup(field.name + UnionTypeFieldSuffix());
+    FLATBUFFERS_ASSERT(type_field);
+    return Name(struct_def) + "::" + GenFieldOffsetName(*type_field);
+  }
+
+  void GenUnionToJson(const EnumDef &enum_def) {
+    code_ += "inline " + UnionJsonToSignature(enum_def) + " {";
+    code_ += "  switch (type) {";
+    for (auto it = enum_def.Vals().begin(); it != enum_def.Vals().end();
+         ++it) {
+      const auto &ev = **it;
+      if (ev.IsZero()) continue;
+      code_.SetValue("LABEL", GetEnumValUse(enum_def, ev));
+      code_.SetValue("TYPE", GetUnionElement(ev, false, opts_));
+      code_ += "    case {{LABEL}}: {";
+      code_ += "      auto ptr = reinterpret_cast<const {{TYPE}} *>(obj);";
+      if (IsString(ev.union_type)) {
+        code_ += "      writer.String(ptr);";
+        code_ += "      return writer.ok();";
+      } else {
+        code_ += "      return " +
+                 JsonFunction(*ev.union_type.struct_def, "ToJson") +
+                 "(ptr, writer);";
+      }
+      code_ += "    }";
+    }
+    code_ += "    default: return false;";
+    code_ += "  }";
+    code_ += "}";
+    code_ += "";
+  }
+
+  // Reads a scalar of `type` into a new variable `val` of its wire type.
+  void GenJsonReadScalar(const FieldDef &field, const Type &type,
+                         const std::string &indent) {
+    code_ += indent + GenTypeBasic(type, false) + " _val;";
+    std::string read;
+    const auto hash = field.attributes.Lookup("hash");
+    if (hash) {
+      const auto hash_type =
+          "uint" + NumToString(SizeOf(type.base_type) * 8) + "_t";
+      const auto hash_fn = hash->constant.find("fnv1a") == 0
+                               ? "flatbuffers::HashFnv1a<"
+                               : "flatbuffers::HashFnv1<";
+      read = std::string("_reader.Hashed(") + hash_fn + hash_type +
+             ">, &_val)";
+    } else if (type.enum_def) {
+      read = "_reader.Enum(" + JsonEnumTable(*type.enum_def) + ", &_val)";
+    } else {
+      read = "_reader.Scalar(&_val)";
+    }
+    code_ += indent + "if (!" + read + ") return false;";
+  }
+
+  // Reads a vector field into `{{FIELD_NAME}}`, except unions.
+  void GenJsonReadVector(const FieldDef &field, const std::string &indent) {
+    const auto vtype = field.value.type.VectorType();
+    const auto has_key = TypeHasKey(vtype);
+    const auto elem_type = IsStruct(vtype)
+                               ? WrapInNameSpace(*vtype.struct_def)
+                               : GenTypeWire(vtype, "",
+                                             VectorElementUserFacing(vtype));
+    code_ += indent + "std::vector<" + elem_type + "> _elems;";
+    code_ += indent + "if (!_reader.StartArray()) return false;";
+    code_ += indent + "while (_reader.NextElement()) {";
+    const auto in = indent + "  ";
+    if (IsScalar(vtype.base_type)) {
+      GenJsonReadScalar(field, vtype, in);
+      if (VectorElementUserFacing(vtype)) {
+        code_ += in + "_elems.push_back(static_cast<" + elem_type +
+                 ">(_val));";
+      } else {
+        code_ += in + "_elems.push_back(_val);";
+      }
+    } else if (IsString(vtype)) {
+      code_ += in + "flatbuffers::Offset<flatbuffers::String> _val;";
+      code_ += in + "if (!_reader.String(_fbb, &_val" +
+               (field.shared ? ", true" : "") + ")) return false;";
+      code_ += in + "_elems.push_back(_val);";
+    } else if (IsStruct(vtype)) {
+      code_ += in + elem_type + " _val;";
+      code_ += in + "if (!" + JsonFunction(*vtype.struct_def, "FromJson") +
+               "(_reader, &_val)) return false;";
+      code_ += in + "_elems.push_back(_val);";
+    } else {
+      code_ += in + elem_type + " _val;";
+      code_ += in + "if (!" + JsonFunction(*vtype.struct_def, "FromJson") +
+               "(_reader, _fbb, &_val)) return false;";
+      code_ += in + "_elems.push_back(_val);";
+    }
+    code_ += indent + "}";
+    code_ += indent + "if (!_reader.ok()) return false;";
+    const auto force_align = GenVectorForceAlign(field, "_elems.size()");
+    if (!force_align.empty()) code_ += indent + force_align;
+    if (IsStruct(vtype)) {
+      code_ += indent + "{{FIELD_NAME}} = _fbb.CreateVectorOf" +
+               (has_key ? "SortedStructs(&_elems);" : "Structs(_elems);");
+    } else if (has_key) {
+      code_ += indent + "{{FIELD_NAME}} = _fbb.CreateVectorOfSortedTables(" +
+               "&_elems);";
+    } else {
+      code_ += indent + "{{FIELD_NAME}} = _fbb.CreateVector(_elems);";
+    }
+  }
+
+  void GenStructFromJson(const StructDef &struct_def) {
+    code_.SetValue("STRUCT_NAME", Name(struct_def));
+    code_ += "inline " + JsonFromSignature(struct_def) + " {";
+    code_ += "  auto p = reinterpret_cast<uint8_t *>(_o);";
+    code_ += "  memset(p, 0, sizeof({{STRUCT_NAME}}));";
+    code_ += "  if (!_reader.StartObject()) return false;";
+    code_ += "  while (_reader.NextField()) {";
+    for (auto it = struct_def.fields.vec.begin();
+         it != struct_def.fields.vec.end(); ++it) {
+      const auto &field = **it;
+      const auto &type = field.value.type;
+      const auto offset = NumToString(field.value.offset);
+      const auto branch =
+          it == struct_def.fields.vec.begin() ? "    if" : "    } else if";
+      code_ += std::string(branch) + " (_reader.KeyIs(\"" + field.name +
+               "\")) {";
+      if (IsArray(type)) {
+        const auto vtype = type.VectorType();
+        const auto elem_size = NumToString(InlineSize(vtype));
+        code_ += "      if (!_reader.StartArray()) return false;";
+        code_ += "      for (size_t i = 0; _reader.NextElement(); i++) {";
+        code_ += "        if (i == " + NumToString(type.fixed_length) +
+                 ") return _reader.Error(\"too many elements: " + field.name +
+                 "\");";
+        GenJsonReadStructValue(field, vtype,
+                               "p + " + offset + " + i * " + elem_size,
+                               "        ");
+        code_ += "      }";
+        code_ += "      if (!_reader.ok()) return false;";
+      } else {
+        GenJsonReadStructValue(field, type, "p + " + offset, "      ");
+      }
+    }
+    code_ += "    } else if (!_reader.UnknownField()) {";
+    code_ += "      return false;";
+    code_ += "    }";
+    code_ += "  }";
+    code_ += "  return _reader.ok();";
+    code_ += "}";
+    code_ += "";
+  }
+
+  void GenJsonReadStructValue(const FieldDef &field, const Type &type,
+                              const std::string &ptr,
+                              const std::string &indent) {
+    if (IsStruct(type)) {
+      code_ += indent + "if (!" + JsonFunction(*type.struct_def, "FromJson") +
+               "(_reader, reinterpret_cast<" +
+               WrapInNameSpace(*type.struct_def) + " *>(" + ptr +
+               "))) return false;";
+    } else {
+      GenJsonReadScalar(field, type, indent);
+      code_ += indent + "flatbuffers::WriteScalar(" + ptr + ", _val);";
+    }
+  }
+
+  void GenTableFromJson(const StructDef &struct_def) {
+    code_.SetValue("STRUCT_NAME", Name(struct_def));
+    code_ += "inline " + JsonFromSignature(struct_def) + " {";
+    // Locals with the same types and defaults as the CreateX() parameters.
+    bool has_unions = false;
+    for (auto it = struct_def.fields.vec.begin();
+         it != struct_def.fields.vec.end(); ++it) {
+      const auto &field = **it;
+      if (field.deprecated) continue;
+      const auto &type = field.value.type;
+      GenParam(field, false, "  ");
+      code_ += ";";
+      code_.SetValue("FIELD_NAME", Name(field));
+      if (IsStruct(type)) {
+        code_ += "  " + WrapInNameSpace(*type.struct_def) +
+                 " {{FIELD_NAME}}__;";
+      } else if (type.base_type == BASE_TYPE_UNION ||
+                 type.VectorType().base_type == BASE_TYPE_UNION) {
+        // Union values are read last, once their type is known.
+        code_ += "  size_t {{FIELD_NAME}}__ = 0;";
+        has_unions = true;
+      } else if (IsVector(type) && type.VectorType().base_type ==
+                                       BASE_TYPE_UTYPE) {
+        code_ += "  std::vector<uint8_t> {{FIELD_NAME}}__;";
+      }
+    }
+    code_ += "  if (!_reader.StartObject()) return false;";
+    code_ += "  while (_reader.NextField()) {";
+    bool first = true;
+    for (auto it = struct_def.fields.vec.begin();
+         it != struct_def.fields.vec.end(); ++it) {
+      const auto &field = **it;
+      const auto &type = field.value.type;
+      code_.SetValue("FIELD_NAME", Name(field));
+      code_ += std::string(first ? "    if" : "    } else if") +
+               " (_reader.KeyIs(\"" + field.name + "\")) {";
+      first = false;
+      if (field.deprecated) {
+        code_ += "      if (!_reader.SkipValue()) return false;";
+      } else if (IsScalar(type.base_type)) {
+        GenJsonReadScalar(field, type, "      ");
+        code_ += "      {{FIELD_NAME}} = " +
+                 GenUnderlyingCast(field, true, "_val") + ";";
+      } else if (IsStruct(type)) {
+        code_ += "      if (!" + JsonFunction(*type.struct_def, "FromJson") +
+                 "(_reader, &{{FIELD_NAME}}__)) return false;";
+        code_ += "      {{FIELD_NAME}} = &{{FIELD_NAME}}__;";
+      } else if (type.base_type == BASE_TYPE_STRUCT) {
+        code_ += "      if (!" + JsonFunction(*type.struct_def, "FromJson") +
+                 "(_reader, _fbb, &{{FIELD_NAME}})) return false;";
+      } else if (IsString(type)) {
+        code_ += "      if (!_reader.String(_fbb, &{{FIELD_NAME}}" +
+                 std::string(field.shared ? ", true" : "") +
+                 ")) return false;";
+      } else if (type.base_type == BASE_TYPE_UNION ||
+                 type.VectorType().base_type == BASE_TYPE_UNION) {
+        code_ += "      {{FIELD_NAME}}__ = _reader.Position();";
+        code_ += "      if (!_reader.SkipValue()) return false;";
+      } else if (field.flexbuffer) {
+        code_ += "      if (!_reader.FlexBuffer(_fbb, &{{FIELD_NAME}})) "
+                 "return false;";
+      } else if (type.VectorType().base_type == BASE_TYPE_UTYPE) {
+        GenJsonReadVector(field, "      ");
+        code_ += "      {{FIELD_NAME}}__ = _elems;";
+      } else if (field.nested_flatbuffer) {
+        const auto &nested = *field.nested_flatbuffer;
+        code_ += "      if (_reader.Peek('[')) {";
+        GenJsonReadVector(field, "        ");
+        code_ += "      } else {";
+        code_ += "        flatbuffers::FlatBufferBuilder _nested;";
+        code_ += "        flatbuffers::Offset<" + WrapInNameSpace(nested) +
+                 "> _root;";
+        code_ += "        if (!" + JsonFunction(nested, "FromJson") +
+                 "(_reader, _nested, &_root)) return false;";
+        code_ += "        _nested.Finish(_root);";
+        code_ += "        _fbb.ForceVectorAlignment(_nested.GetSize(), "
+                 "sizeof(uint8_t),";
+        code_ += "                                  "
+                 "_nested.GetBufferMinAlignment());";
+        code_ += "        {{FIELD_NAME}} = _fbb.CreateVector("
+                 "_nested.GetBufferPointer(),";
+        code_ += "                                           "
+                 "_nested.GetSize());";
+        code_ += "      }";
+      } else {
+        GenJsonReadVector(field, "      ");
+      }
+    }
+    if (first) {
+      code_ += "    if (!_reader.UnknownField()) {";
+    } else {
+      code_ += "    } else if (!_reader.UnknownField()) {";
+    }
+    code_ += "      return false;";
+    code_ += "    }";
+    code_ += "  }";
+    code_ += "  if (!_reader.ok()) return false;";
+    if (has_unions) {
+      code_ += "  const auto _end = _reader.Position();";
+      for (auto it = struct_def.fields.vec.begin();
+           it != struct_def.fields.vec.end(); ++it) {
+        const auto &field = **it;
+        const auto &type = field.value.type;
+        if (field.deprecated) continue;
+        code_.SetValue("FIELD_NAME", Name(field));
+        code_.SetValue("TYPE_NAME", Name(field) + UnionTypeFieldSuffix());
+        if (type.base_type == BASE_TYPE_UNION) {
+          code_ += "  if ({{FIELD_NAME}}__) {";
+          code_ += "    _reader.Seek({{FIELD_NAME}}__);";
+          code_ += "    if (!" + JsonFunction(*type.enum_def, "FromJson") +
+                   "(_reader, _fbb, {{TYPE_NAME}}, &{{FIELD_NAME}})) {";
+          code_ += "      return false;";
+          code_ += "    }";
+          code_ += "  }";
+        } else if (type.VectorType().base_type == BASE_TYPE_UNION) {
+          const auto &enum_def = *type.VectorType().enum_def;
+          code_ += "  if ({{FIELD_NAME}}__) {";
+          code_ += "    _reader.Seek({{FIELD_NAME}}__);";
+          code_ += "    std::vector<flatbuffers::Offset<void>> _elems;";
+          code_ += "    if (!_reader.StartArray()) return false;";
+          code_ += "    while (_reader.NextElement()) {";
+          code_ += "      if (_elems.size() == {{TYPE_NAME}}__.size()) {";
+          code_ += "        return _reader.Error(\"missing union type: " +
+                   field.name + "\");";
+          code_ += "      }";
+          code_ += "      flatbuffers::Offset<void> _val;";
+          code_ += "      if (!" + JsonFunction(enum_def, "FromJson") +
+                   "(_reader, _fbb,";
+          code_ += "              static_cast<" + WrapInNameSpace(enum_def) +
+                   ">({{TYPE_NAME}}__[_elems.size()]), &_val)) {";
+          code_ += "        return false;";
+          code_ += "      }";
+          code_ += "      _elems.push_back(_val);";
+          code_ += "    }";
+          code_ += "    if (!_reader.ok()) return false;";
+          code_ += "    {{FIELD_NAME}} = _fbb.CreateVector(_elems);";
+          code_ += "  }";
+        }
+      }
+      code_ += "  _reader.Seek(_end);";
+    }
+    for (auto it = struct_def.fields.vec.begin();
+         it != struct_def.fields.vec.end(); ++it) {
+      const auto &field = **it;
+      if (field.deprecated || !field.IsRequired()) continue;
+      code_.SetValue("FIELD_NAME", Name(field));
+      code_ += std::string("  if (") +
+               (IsStruct(field.value.type) ? "!{{FIELD_NAME}}"
+                                           : "{{FIELD_NAME}}.IsNull()") +
+               ") {";
+      code_ += "    return _reader.Error(\"required field is missing: " +
+               field.name + "\");";
+      code_ += "  }";
+    }
+    code_ += "  *_o = Create{{STRUCT_NAME}}(";
+    code_ += "      _fbb\\";
+    for (auto it = struct_def.fields.vec.begin();
+         it != struct_def.fields.vec.end(); ++it) {
+      const auto &field = **it;
+      if (field.deprecated) continue;
+      code_.SetValue("FIELD_NAME", Name(field));
+      code_ += ",\n      {{FIELD_NAME}}\\";
+    }
+    code_ += ");";
+    code_ += "  return true;";
+    code_ += "}";
+    code_ += "";
+  }
+
+  void GenUnionFromJson(const EnumDef &enum_def) {
+    code_ += "inline " + UnionJsonFromSignature(enum_def) + " {";
+    code_ += "  switch (type) {";
+    for (auto it = enum_def.Vals().begin(); it != enum_def.Vals().end();
+         ++it) {
+      const auto &ev = **it;
+      if (ev.IsZero()) continue;
+      code_.SetValue("LABEL", GetEnumValUse(enum_def, ev));
+      code_.SetValue("TYPE", GetUnionElement(ev, false, opts_));
+      code_ += "    case {{LABEL}}: {";
+      if (IsString(ev.union_type)) {
+        code_ += "      flatbuffers::Offset<flatbuffers::String> ptr;";
+        code_ += "      if (!_reader.String(_fbb, &ptr)) return false;";
+        code_ += "      *_o = ptr.Union();";
+      } else if (ev.union_type.struct_def->fixed) {
+        code_ += "      {{TYPE}} _val;";
+        code_ += "      if (!" +
+                 JsonFunction(*ev.union_type.struct_def, "FromJson") +
+                 "(_reader, &_val)) return false;";
+        code_ += "      *_o = _fbb.CreateStruct(_val).Union();";
+      } else {
+        code_ += "      flatbuffers::Offset<{{TYPE}}> ptr;";
+        code_ += "      if (!" +
+                 JsonFunction(*ev.union_type.struct_def, "FromJson") +
+                 "(_reader, _fbb, &ptr)) return false;";
+        code_ += "      *_o = ptr.Union();";
+      }
+      code_ += "      return true;";
+      code_ += "    }";
+    }
+    code_ += "    default: return _reader.Error(\"unknown union type\");";
+    code_ += "  }";
+    code_ += "}";
+    code_ += "";
+  }
+
+  void GenJson() {
+    // Declare everything first, since types may refer to each other.
+    for (auto it = parser_.structs_.vec.begin();
+         it != parser_.structs_.vec.end(); ++it) {
+      const auto &struct_def = **it;
+      if (!struct_def.generated) {
+        SetNameSpace(struct_def.defined_namespace);
+        GenJsonDecls(&struct_def, nullptr);
+      }
+    }
+    for (auto it = parser_.enums_.vec.begin(); it != parser_.enums_.vec.end();
+         ++it) {
+      const auto &enum_def = **it;
+      if (!enum_def.generated) {
+        SetNameSpace(enum_def.defined_namespace);
+        GenJsonDecls(nullptr, &enum_def);
+      }
+    }
+    code_ += "";
+    for (auto it = parser_.enums_.vec.begin(); it != parser_.enums_.vec.end();
+         ++it) {
+      const auto &enum_def = **it;
+      if (!enum_def.generated) {
+        SetNameSpace(enum_def.defined_namespace);
+        GenJsonEnum(enum_def);
+      }
+    }
+    for (auto it = parser_.structs_.vec.begin();
+         it != parser_.structs_.vec.end(); ++it) {
+      const auto &struct_def = **it;
+      if (struct_def.generated) continue;
+      SetNameSpace(struct_def.defined_namespace);
+      if (struct_def.fixed) {
+        GenStructToJson(struct_def);
+        GenStructFromJson(struct_def);
+      } else {
+        GenTableToJson(struct_def);
+        GenTableFromJson(struct_def);
+      }
+    }
+    for (auto it = parser_.enums_.vec.begin(); it != parser_.enums_.vec.end();
+         ++it) {
+      const auto &enum_def = **it;
+      if (enum_def.is_union && !enum_def.generated) {
+        SetNameSpace(enum_def.defined_namespace);
+        GenUnionToJson(enum_def);
+        GenUnionFromJson(enum_def);
+      }
+    }
+  }
+
   // Set up the correct namespace. Only open a namespace if the existing one is
   // different (closing/opening only what is necessary).
   //
@@ -21,6 +21,11 @@
 #include "flatbuffers/idl.h"
 #include "flatbuffers/util.h"
 
+#if FLATBUFFERS_HAS_THREADS
+#  include <atomic>
+#  include <thread>
+#endif
+
 namespace flatbuffers {
 
 struct PrintScalarTag {};
@@ -39,6 +44,11 @@ struct JsonPrinter {
 
   int Indent() const { return std::max(opts.indent_step, 0); }
 
+  // Hands the text generated so far to the sink, if there is one and enough
+  // text is buffered. Only called between values: text before this point is
+  // never modified again.
+  bool MaybeFlush() { return !sink || sink->MaybeFlush(); }
+
   // Output an identifier with or without quotes depending on strictness.
   void OutputIdentifier(const std::string &name) {
     if (opts.strict_json) text += '\"';
@@ -107,6 +117,7 @@ struct JsonPrinter {
       if (i) {
         AddComma();
         AddNewLine();
+        if (!MaybeFlush()) { return false; }
       }
       AddIndent(elem_indent);
       if (!PrintScalar(c[i], type, elem_indent)) { return false; }
@@ -117,19 +128,18 @@ struct JsonPrinter {
     return true;
   }
 
-  // Print a vector or an array of JSON values, comma seperated, wrapped in
-  // "[]".
+  // Print the elements [begin, end) of a vector or an array of non-scalar
+  // values, comma seperated.
   template<typename Container>
-  bool PrintContainer(PrintPointerTag, const Container &c, size_t size,
-                      const Type &type, int indent, const uint8_t *prev_val) {
+  bool PrintElements(const Container &c, size_t begin, size_t end,
+                     const Type &type, int elem_indent,
+                     const uint8_t *prev_val) {
     const auto is_struct = IsStruct(type);
-    const auto elem_indent = indent + Indent();
-    text += '[';
-    AddNewLine();
-    for (uoffset_t i = 0; i < size; i++) {
+    for (auto i = static_cast<uoffset_t>(begin); i < end; i++) {
       if (i) {
         AddComma();
         AddNewLine();
+        if (!MaybeFlush()) { return false; }
       }
       AddIndent(elem_indent);
       auto ptr = is_struct ? reinterpret_cast<const void *>(
@@ -140,6 +150,77 @@ struct JsonPrinter {
         return false;
       }
     }
+    return true;
+  }
+
+  // clang-format off
+  #if FLATBUFFERS_HAS_THREADS
+  // Print the elements of a large vector of tables in chunks of
+  // `json_chunk_size` on up to `json_threads` threads. Each chunk goes to its
+  // own buffer, the buffers are appended in order. This runs in waves of a
+  // few chunks per thread, so memory use stays bounded for huge vectors.
+  template<typename Container>
+  bool PrintTablesParallel(const Container &c, size_t size, const Type &type,
+                           int elem_indent) {
+    const auto chunk_size = opts.json_chunk_size;
+    const auto num_chunks = (size + chunk_size - 1) / chunk_size;
+    const auto wave_size = static_cast<size_t>(threads) * 2;
+    std::vector<std::string> chunks(wave_size);
+    std::vector<uint8_t> done(wave_size);
+    for (size_t first = 0; first < num_chunks; first += wave_size) {
+      const auto count = std::min(wave_size, num_chunks - first);
+      std::atomic<size_t> next_chunk(0);
+      auto work = [&]() {
+        for (auto k = next_chunk++; k < count; k = next_chunk++) {
+          const auto begin = (first + k) * chunk_size;
+          const auto end = std::min(begin + chunk_size, size);
+          chunks[k].clear();
+          JsonPrinter printer(opts, chunks[k], 1);
+          done[k] = printer.PrintElements(c, begin, end, type, elem_indent,
+                                          nullptr);
+        }
+      };
+      std::vector<std::thread> workers;
+      for (size_t t = 1; t < static_cast<size_t>(threads) && t < count; t++) {
+        workers.push_back(std::thread(work));
+      }
+      work();
+      for (auto it = workers.begin(); it != workers.end(); ++it) it->join();
+      for (size_t k = 0; k < count; k++) {
+        if (!done[k]) return false;
+        text += chunks[k];
+        if (!MaybeFlush()) return false;
+      }
+    }
+    return true;
+  }
+  #endif
+  // clang-format on
+
+  // Print a vector or an array of JSON values, comma seperated, wrapped in
+  // "[]".
+  template<typename Container>
+  bool PrintContainer(PrintPointerTag, const Container &c, size_t size,
+                      const Type &type, int indent, const uint8_t *prev_val) {
+    const auto elem_indent = indent + Indent();
+    text += '[';
+    AddNewLine();
+    // clang-format off
+    #if FLATBUFFERS_HAS_THREADS
+      // Tables are independent of each other, unlike union values.
+      // A chunk size of 0 doesn't split vectors.
+      const auto parallel = threads > 1 && opts.json_chunk_size > 0 &&
+                            type.base_type == BASE_TYPE_STRUCT &&
+                            !type.struct_def->fixed &&
+                            size > opts.json_chunk_size;
+      if (parallel) {
+        if (!PrintTablesParallel(c, size, type, elem_indent)) return false;
+      } else
+    #endif
+    // clang-format on
+    if (!PrintElements(c, 0, size, type, elem_indent, prev_val)) {
+      return false;
+    }
     AddNewLine();
     AddIndent(indent);
     text += ']';
@@ -240,18 +321,51 @@ struct JsonPrinter {
     T val;
     auto check = StringToNumber(fd.value.constant.c_str(), &val);
     (void)check;
-    FLATBUFFERS_ASSERT(check);
+    // Optional scalars have a `null` default, they are printed only if set.
+    FLATBUFFERS_ASSERT(check || fd.IsScalarOptional());
     return val;
   }
 
+  // Default values of the scalar fields of a struct or table, in the order of
+  // `fields.vec`, each stored in the low bytes of a 64-bit slot.
+  typedef std::vector<uint64_t> FieldDefaults;
+
+  // Parses the defaults of a table once per printer, instead of once for
+  // every printed field.
+  const FieldDefaults &GetFieldDefaults(const StructDef &struct_def) {
+    auto it = defaults_cache.find(&struct_def);
+    if (it != defaults_cache.end()) return it->second;
+    auto &defaults = defaults_cache[&struct_def];
+    defaults.resize(struct_def.fields.vec.size(), 0);
+    for (size_t i = 0; i < struct_def.fields.vec.size(); i++) {
+      const auto &fd = *struct_def.fields.vec[i];
+      // clang-format off
+      switch (fd.value.type.base_type) {
+      #define FLATBUFFERS_TD(ENUM, IDLTYPE, CTYPE, ...) \
+        case BASE_TYPE_ ## ENUM: { \
+          const auto val = GetFieldDefault<CTYPE>(fd); \
+          memcpy(&defaults[i], &val, sizeof(val)); \
+          break; \
+        }
+          FLATBUFFERS_GEN_TYPES_SCALAR(FLATBUFFERS_TD)
+      #undef FLATBUFFERS_TD
+        default: break;
+      }
+      // clang-format on
+    }
+    return defaults;
+  }
+
   // Generate text for a scalar field.
   template<typename T>
-  bool GenField(const FieldDef &fd, const Table *table, bool fixed,
-                int indent) {
+  bool GenField(const FieldDef &fd, const Table *table, bool fixed, int indent,
+                uint64_t default_bits) {
+    T default_val;
+    memcpy(&default_val, &default_bits, sizeof(default_val));
     return PrintScalar(
         fixed ? reinterpret_cast<const Struct *>(table)->GetField<T>(
                     fd.value.offset)
-              : table->GetField<T>(fd.value.offset, GetFieldDefault<T>(fd)),
+              : table->GetField<T>(fd.value.offset, default_val),
         fd.value.type, indent);
   }
 
@@ -267,8 +381,8 @@ struct JsonPrinter {
     } else if (fd.flexbuffer) {
       auto vec = table->GetPointer<const Vector<uint8_t> *>(fd.value.offset);
       auto root = flexbuffers::GetRoot(vec->data(), vec->size());
-      root.ToString(true, opts.strict_json, text);
-      return true;
+      root.ToString(true, opts.strict_json, text, sink);
+      return MaybeFlush();
     } else if (fd.nested_flatbuffer) {
       auto vec = table->GetPointer<const Vector<uint8_t> *>(fd.value.offset);
       auto root = GetRoot<Table>(vec->data());
@@ -288,6 +402,7 @@ struct JsonPrinter {
     int fieldout = 0;
     const uint8_t *prev_val = nullptr;
     const auto elem_indent = indent + Indent();
+    const auto &defaults = GetFieldDefaults(struct_def);
     for (auto it = struct_def.fields.vec.begin();
          it != struct_def.fields.vec.end(); ++it) {
       FieldDef &fd = **it;
@@ -295,7 +410,10 @@ struct JsonPrinter {
       auto output_anyway = (opts.output_default_scalars_in_json || fd.key) &&
                            IsScalar(fd.value.type.base_type) && !fd.deprecated;
       if (is_present || output_anyway) {
-        if (fieldout++) { AddComma(); }
+        if (fieldout++) {
+          AddComma();
+          if (!MaybeFlush()) { return false; }
+        }
         AddNewLine();
         AddIndent(elem_indent);
         OutputIdentifier(fd.name);
@@ -308,7 +426,8 @@ struct JsonPrinter {
         switch (fd.value.type.base_type) {
         #define FLATBUFFERS_TD(ENUM, IDLTYPE, CTYPE, ...) \
           case BASE_TYPE_ ## ENUM: \
-            if (!GenField<CTYPE>(fd, table, struct_def.fixed, elem_indent)) { \
+            if (!GenField<CTYPE>(fd, table, struct_def.fixed, elem_indent, \
+                  defaults[it - struct_def.fields.vec.begin()])) { \
               return false; \
             } \
             break;
@@ -340,23 +459,43 @@ struct JsonPrinter {
     return true;
   }
 
-  JsonPrinter(const Parser &parser, std::string &dest)
-      : opts(parser.opts), text(dest) {
+  // If `sink` is given, `dest` must be its buffer.
+  JsonPrinter(const Parser &parser, std::string &dest,
+              TextSink *sink_ = nullptr)
+      : opts(parser.opts),
+        text(dest),
+        sink(sink_),
+        threads(parser.opts.json_threads) {
     text.reserve(1024);  // Reduce amount of inevitable reallocs.
   }
 
+  JsonPrinter(const IDLOptions &opts_, std::string &dest, int threads_)
+      : opts(opts_), text(dest), sink(nullptr), threads(threads_) {}
+
   const IDLOptions &opts;
   std::string &text;
+  TextSink *sink;
+  int threads;
+  std::map<const StructDef *, FieldDefaults> defaults_cache;
 };
 
 static bool GenerateTextImpl(const Parser &parser, const Table *table,
-                             const StructDef &struct_def, std::string *_text) {
-  JsonPrinter printer(parser, *_text);
+                             const StructDef &struct_def, std::string *_text,
+                             TextSink *sink = nullptr) {
+  JsonPrinter printer(parser, *_text, sink);
   if (!printer.GenStruct(struct_def, table, 0)) { return false; }
   printer.AddNewLine();
   return true;
 }
 
+static bool GenerateTextImpl(const Parser &parser, const Table *table,
+                             const StructDef &struct_def, TextSink *sink) {
+  auto done =
+      GenerateTextImpl(parser, table, struct_def, &sink->buffer(), sink);
+  // Flush what is left even on failure, like the partial std::string output.
+  return sink->Flush() && done;
+}
+
 // Generate a text representation of a flatbuffer in JSON format.
 bool GenerateTextFromTable(const Parser &parser, const void *table,
                            const std::string &table_name, std::string *_text) {
@@ -366,13 +505,31 @@ bool GenerateTextFromTable(const Parser &parser, const void *table,
   return GenerateTextImpl(parser, root, *struct_def, _text);
 }
 
+bool GenerateTextFromTable(const Parser &parser, const void *table,
+                           const std::string &table_name, TextSink *sink) {
+  auto struct_def = parser.LookupStruct(table_name);
+  if (struct_def == nullptr) { return false; }
+  auto root = static_cast<const Table *>(table);
+  return GenerateTextImpl(parser, root, *struct_def, sink);
+}
+
+static const Table *GetTextRoot(const Parser &parser, const void *flatbuffer) {
+  FLATBUFFERS_ASSERT(parser.root_struct_def_);  // call SetRootType()
+  return parser.opts.size_prefixed ? GetSizePrefixedRoot<Table>(flatbuffer)
+                                   : GetRoot<Table>(flatbuffer);
+}
+
 // Generate a text representation of a flatbuffer in JSON format.
 bool GenerateText(const Parser &parser, const void *flatbuffer,
                   std::string *_text) {
-  FLATBUFFERS_ASSERT(parser.root_struct_def_);  // call SetRootType()
-  auto root = parser.opts.size_prefixed ? GetSizePrefixedRoot<Table>(flatbuffer)
-                                        : GetRoot<Table>(flatbuffer);
-  return GenerateTextImpl(parser, root, *parser.root_struct_def_, _text);
+  return GenerateTextImpl(parser, GetTextRoot(parser, flatbuffer),
+                          *parser.root_struct_def_, _text);
+}
+
+bool GenerateText(const Parser &parser, const void *flatbuffer,
+                  TextSink *sink) {
+  return GenerateTextImpl(parser, GetTextRoot(parser, flatbuffer),
+                          *parser.root_struct_def_, sink);
 }
 
 static std::string TextFileName(const std::string &path,
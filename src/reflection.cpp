@@ -497,6 +497,709 @@ Offset<const Table *> CopyTable(FlatBufferBuilder &fbb,
   }
 }
 
+namespace {
+
+// The number of elements of any kind of FlexBuffers vector, and one of them.
+size_t FlexSize(flexbuffers::Reference vec) {
+  if (vec.IsFixedTypedVector()) return vec.AsFixedTypedVector().size();
+  if (vec.IsTypedVector()) return vec.AsTypedVector().size();
+  return vec.AsVector().size();
+}
+
+flexbuffers::Reference FlexElement(flexbuffers::Reference vec, size_t i) {
+  if (vec.IsFixedTypedVector()) return vec.AsFixedTypedVector()[i];
+  if (vec.IsTypedVector()) return vec.AsTypedVector()[i];
+  return vec.AsVector()[i];
+}
+
+bool IntegerFits(reflection::BaseType type, int64_t i) {
+  switch (type) {
+    case reflection::Bool: return i >= 0 && i <= 1;
+    case reflection::Byte: return i >= -128 && i <= 127;
+    case reflection::UType:
+    case reflection::UByte: return i >= 0 && i <= 0xFF;
+    case reflection::Short: return i >= -0x8000 && i <= 0x7FFF;
+    case reflection::UShort: return i >= 0 && i <= 0xFFFF;
+    case reflection::Int: return i >= -0x7FFFFFFFLL - 1 && i <= 0x7FFFFFFF;
+    case reflection::UInt: return i >= 0 && i <= 0xFFFFFFFFLL;
+    case reflection::ULong: return i >= 0;
+    default: return true;
+  }
+}
+
+bool IsFlexBufferField(const reflection::Field &field) {
+  return field.type()->element() == reflection::UByte && field.attributes() &&
+         field.attributes()->LookupByKey("flexbuffer");
+}
+
+// The root table of a nested_flatbuffer field of `object`, if it is one.
+const reflection::Object *NestedFlatBufferRoot(
+    const reflection::Schema &schema, const reflection::Object &object,
+    const reflection::Field &field) {
+  auto attr = field.attributes()
+                  ? field.attributes()->LookupByKey("nested_flatbuffer")
+                  : nullptr;
+  if (field.type()->element() != reflection::UByte || !attr || !attr->value()) {
+    return nullptr;
+  }
+  // The name may be relative to the namespace of `object`.
+  auto name = attr->value()->str();
+  auto root = schema.objects()->LookupByKey(name.c_str());
+  auto dot = object.name()->str().rfind('.');
+  if (!root && dot != std::string::npos) {
+    name = object.name()->str().substr(0, dot + 1) + name;
+    root = schema.objects()->LookupByKey(name.c_str());
+  }
+  return root;
+}
+
+void FinishWithIdentifier(const reflection::Schema &schema, uoffset_t root,
+                          FlatBufferBuilder &fbb) {
+  auto ident = schema.file_ident();
+  auto has_ident =
+      ident && ident->size() == FlatBufferBuilder::kFileIdentifierLength;
+  fbb.Finish(Offset<const Table *>(root), has_ident ? ident->c_str() : nullptr);
+}
+
+// Builds the tables of FlexBufferToFlatBuffer() bottom up, like CopyTable().
+class FlexBufferTranscoder {
+ public:
+  FlexBufferTranscoder(const reflection::Schema &schema,
+                       FlatBufferBuilder &fbb, bool skip_unknown_fields)
+      : schema_(schema), fbb_(fbb), skip_unknown_fields_(skip_unknown_fields) {}
+
+  bool Table(const reflection::Object &object, flexbuffers::Reference ref,
+             uoffset_t *offset) {
+    if (!ref.IsMap()) {
+      return Error("expecting a map for " + object.name()->str());
+    }
+    auto map = ref.AsMap();
+    if (!CheckKeys(object, map)) return false;
+    // Strings, vectors and tables go before the table, collect their
+    // offsets by field.
+    auto fields = object.fields();
+    std::vector<uoffset_t> offsets(fields->size(), 0);
+    for (uoffset_t i = 0; i < fields->size(); i++) {
+      auto &field = *fields->Get(i);
+      auto value = map[field.name()->c_str()];
+      if (value.IsNull()) {
+        if (field.required()) {
+          return Error("missing required field: " + field.name()->str());
+        }
+        continue;
+      }
+      if (field.deprecated()) continue;
+      auto path_size = Enter(field.name()->c_str());
+      if (!OutOfLine(object, field, map, value, &offsets[i])) return false;
+      path_.resize(path_size);
+    }
+    auto start = fbb_.StartTable();
+    for (uoffset_t i = 0; i < fields->size(); i++) {
+      auto &field = *fields->Get(i);
+      if (offsets[i]) {
+        fbb_.AddOffset(field.offset(), flatbuffers::Offset<void>(offsets[i]));
+        continue;
+      }
+      auto value = map[field.name()->c_str()];
+      if (value.IsNull() || field.deprecated()) continue;
+      auto type = field.type()->base_type();
+      if (type == reflection::Obj) {
+        auto &sub = *schema_.objects()->Get(field.type()->index());
+        if (!sub.is_struct()) continue;  // An empty table.
+        std::vector<uint8_t> bytes(static_cast<size_t>(sub.bytesize()));
+        auto path_size = Enter(field.name()->c_str());
+        if (!Struct(sub, value, bytes.data())) return false;
+        path_.resize(path_size);
+        AddInline(field, bytes.data(), bytes.size(),
+                  static_cast<size_t>(sub.minalign()));
+      } else if (IsScalar(type)) {
+        uint8_t bytes[sizeof(largest_scalar_t)];
+        auto path_size = Enter(field.name()->c_str());
+        if (!Scalar(type, field.type()->index(), value, bytes)) return false;
+        path_.resize(path_size);
+        if (!field.optional() && IsDefault(field, bytes)) continue;
+        auto size = GetTypeSize(type);
+        AddInline(field, bytes, size, size);
+      }
+    }
+    *offset = fbb_.EndTable(start);
+    return true;
+  }
+
+  const std::string &error() const { return error_; }
+
+ private:
+  bool Error(const std::string &msg) {
+    error_ = (path_.empty() ? std::string("root") : path_) + ": " + msg;
+    return false;
+  }
+
+  // Adds a field or index to the path, returns its old size.
+  size_t Enter(const char *name) {
+    auto size = path_.size();
+    if (size) path_ += '.';
+    path_ += name;
+    return size;
+  }
+
+  size_t Enter(size_t index) {
+    auto size = path_.size();
+    path_ += "[" + NumToString(index) + "]";
+    return size;
+  }
+
+  bool CheckKeys(const reflection::Object &object,
+                 const flexbuffers::Map &map) {
+    if (skip_unknown_fields_) return true;
+    auto keys = map.Keys();
+    for (size_t i = 0; i < keys.size(); i++) {
+      auto key = keys[i].AsKey();
+      if (!object.fields()->LookupByKey(key)) {
+        return Error("unknown field: " + std::string(key));
+      }
+    }
+    return true;
+  }
+
+  void AddInline(const reflection::Field &field, const uint8_t *bytes,
+                 size_t size, size_t align) {
+    fbb_.Align(align);
+    fbb_.PushBytes(bytes, size);
+    fbb_.TrackField(field.offset(), fbb_.GetSize());
+  }
+
+  bool IsDefault(const reflection::Field &field, const uint8_t *bytes) {
+    auto type = field.type()->base_type();
+    if (IsFloat(type)) {
+      return GetAnyValueF(type, bytes) == field.default_real();
+    }
+    return GetAnyValueI(type, bytes) == field.default_integer();
+  }
+
+  // The value of a field that is stored by offset, if it is one.
+  bool OutOfLine(const reflection::Object &object,
+                 const reflection::Field &field,
+              const flexbuffers::Map &map, flexbuffers::Reference value,
+              uoffset_t *offset) {
+    auto type = field.type();
+    switch (type->base_type()) {
+      case reflection::String: return String(value, offset);
+      case reflection::Obj: {
+        auto &sub = *schema_.objects()->Get(type->index());
+        return sub.is_struct() || Table(sub, value, offset);
+      }
+      case reflection::Union: {
+        auto type_name = field.name()->str() + UnionTypeFieldSuffix();
+        auto &type_field = *object.fields()->LookupByKey(type_name.c_str());
+        return Union(type_field, map[type_name.c_str()], value, offset);
+      }
+      case reflection::Vector: {
+        if (IsFlexBufferField(field)) {
+          flexbuffers::Builder builder(1024,
+                                       flexbuffers::BUILDER_FLAG_SHARE_ALL);
+          builder.Add(value);
+          builder.Finish();
+          fbb_.ForceVectorAlignment(builder.GetSize(), sizeof(uint8_t),
+                                    sizeof(largest_scalar_t));
+          *offset = fbb_.CreateVector(builder.GetBuffer()).o;
+          return true;
+        }
+        auto nested = NestedFlatBufferRoot(schema_, object, field);
+        if (nested && value.IsMap()) return Nested(*nested, value, offset);
+        if (type->element() == reflection::Union) {
+          auto type_name = field.name()->str() + UnionTypeFieldSuffix();
+          return UnionVector(*object.fields()->LookupByKey(type_name.c_str()),
+                             map[type_name.c_str()], value, offset);
+        }
+        return Vector(*type, value, offset);
+      }
+      default: return true;
+    }
+  }
+
+  // A FlatBuffer in a vector of bytes.
+  bool Nested(const reflection::Object &root, flexbuffers::Reference value,
+              uoffset_t *offset) {
+    FlatBufferBuilder nested_fbb;
+    FlexBufferTranscoder nested(schema_, nested_fbb, skip_unknown_fields_);
+    nested.path_ = path_;
+    uoffset_t nested_root;
+    if (!nested.Table(root, value, &nested_root)) {
+      error_ = nested.error_;
+      return false;
+    }
+    FinishWithIdentifier(schema_, nested_root, nested_fbb);
+    fbb_.ForceVectorAlignment(nested_fbb.GetSize(), sizeof(uint8_t),
+                              nested_fbb.GetBufferMinAlignment());
+    *offset =
+        fbb_.CreateVector(nested_fbb.GetBufferPointer(), nested_fbb.GetSize())
+            .o;
+    return true;
+  }
+
+  bool String(flexbuffers::Reference value, uoffset_t *offset) {
+    if (!value.IsString() && !value.IsKey()) {
+      return Error("expecting a string");
+    }
+    auto str = value.AsString();
+    *offset = fbb_.CreateString(str.c_str(), str.length()).o;
+    return true;
+  }
+
+  // The table of a union, of the type its type field has.
+  bool Union(const reflection::Field &type_field,
+             flexbuffers::Reference type_value, flexbuffers::Reference value,
+             uoffset_t *offset) {
+    uint8_t type;
+    if (type_value.IsNull()) {
+      return Error("missing union type: " + type_field.name()->str());
+    }
+    if (!Scalar(reflection::UType, type_field.type()->index(), type_value,
+                &type)) {
+      return false;
+    }
+    auto &enum_def = *schema_.enums()->Get(type_field.type()->index());
+    auto enum_val = enum_def.values()->LookupByKey(type);
+    if (!type || !enum_val) return Error("invalid union type");
+    auto union_type = enum_val->union_type();
+    if (union_type->base_type() == reflection::String) {
+      return String(value, offset);
+    }
+    auto &sub = *schema_.objects()->Get(union_type->index());
+    if (sub.is_struct()) {
+      // Structs in unions are stored out of line, like a table.
+      std::vector<uint8_t> bytes(static_cast<size_t>(sub.bytesize()));
+      if (!Struct(sub, value, bytes.data())) return false;
+      fbb_.Align(static_cast<size_t>(sub.minalign()));
+      fbb_.PushBytes(bytes.data(), bytes.size());
+      *offset = fbb_.GetSize();
+      return true;
+    }
+    return Table(sub, value, offset);
+  }
+
+  bool UnionVector(const reflection::Field &type_field,
+                   flexbuffers::Reference types, flexbuffers::Reference values,
+                   uoffset_t *offset) {
+    if (!values.IsAnyVector() || values.IsMap()) {
+      return Error("expecting a vector");
+    }
+    auto len = FlexSize(values);
+    if (!types.IsAnyVector() || types.IsMap() || FlexSize(types) != len) {
+      return Error("expecting a vector of " + NumToString(len) +
+                   " union types: " + type_field.name()->str());
+    }
+    std::vector<flatbuffers::Offset<void>> elements(len);
+    for (size_t i = 0; i < len; i++) {
+      auto path_size = Enter(i);
+      if (!Union(type_field, FlexElement(types, i), FlexElement(values, i),
+                 &elements[i].o)) {
+        return false;
+      }
+      path_.resize(path_size);
+    }
+    *offset = fbb_.CreateVector(elements).o;
+    return true;
+  }
+
+  bool Vector(const reflection::Type &type, flexbuffers::Reference value,
+              uoffset_t *offset) {
+    auto element = type.element();
+    auto index = type.index();
+    if (value.IsBlob() &&
+        (element == reflection::UByte || element == reflection::Byte)) {
+      auto blob = value.AsBlob();
+      *offset = fbb_.CreateVector(blob.data(), blob.size()).o;
+      return true;
+    }
+    if (!value.IsAnyVector() || value.IsMap()) {
+      return Error("expecting a vector");
+    }
+    auto len = FlexSize(value);
+    auto sub = element == reflection::Obj ? schema_.objects()->Get(index)
+                                          : nullptr;
+    if (element == reflection::String || (sub && !sub->is_struct())) {
+      auto order = sub ? SortedByKey(*sub, value, len) : Identity(len);
+      std::vector<flatbuffers::Offset<void>> elements(len);
+      for (size_t i = 0; i < len; i++) {
+        auto path_size = Enter(order[i]);
+        auto elem = FlexElement(value, order[i]);
+        if (!(sub ? Table(*sub, elem, &elements[i].o)
+                  : String(elem, &elements[i].o))) {
+          return false;
+        }
+        path_.resize(path_size);
+      }
+      *offset = fbb_.CreateVector(elements).o;
+      return true;
+    }
+    // Scalars and structs, written to a buffer first.
+    auto size = GetTypeSizeInline(element, index, schema_);
+    std::vector<uint8_t> bytes(len * size);
+    if (!Inline(element, index, value, len, bytes.data())) return false;
+    auto align = sub ? static_cast<size_t>(sub->minalign()) : size;
+    fbb_.ForceVectorAlignment(len, size, align);
+    fbb_.StartVector(len * size, 1);
+    fbb_.PushBytes(bytes.data(), bytes.size());
+    *offset = fbb_.EndVector(len);
+    return true;
+  }
+
+  static std::vector<size_t> Identity(size_t len) {
+    std::vector<size_t> order(len);
+    for (size_t i = 0; i < len; i++) order[i] = i;
+    return order;
+  }
+
+  // Tables with a key are sorted by it, for LookupByKey().
+  std::vector<size_t> SortedByKey(const reflection::Object &object,
+                                  flexbuffers::Reference vec, size_t len) {
+    auto order = Identity(len);
+    const reflection::Field *key = nullptr;
+    for (auto it = object.fields()->begin(); it != object.fields()->end();
+         ++it) {
+      if (it->key()) key = *it;
+    }
+    if (!key) return order;
+    auto name = key->name()->c_str();
+    auto type = key->type()->base_type();
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      auto ka = FlexElement(vec, a).AsMap()[name];
+      auto kb = FlexElement(vec, b).AsMap()[name];
+      if (type == reflection::String) {
+        return strcmp(ka.AsString().c_str(), kb.AsString().c_str()) < 0;
+      } else if (IsFloat(type)) {
+        return ka.AsDouble() < kb.AsDouble();
+      } else if (type == reflection::ULong) {
+        return ka.AsUInt64() < kb.AsUInt64();
+      } else {
+        return ka.AsInt64() < kb.AsInt64();
+      }
+    });
+    return order;
+  }
+
+  // `len` scalars or structs, the elements of a vector or array.
+  bool Inline(reflection::BaseType element, int index,
+              flexbuffers::Reference vec, size_t len, uint8_t *dest) {
+    auto size = GetTypeSizeInline(element, index, schema_);
+    for (size_t i = 0; i < len; i++) {
+      auto path_size = Enter(i);
+      auto elem = FlexElement(vec, i);
+      if (!(element == reflection::Obj
+                ? Struct(*schema_.objects()->Get(index), elem, dest + i * size)
+                : Scalar(element, index, elem, dest + i * size))) {
+        return false;
+      }
+      path_.resize(path_size);
+    }
+    return true;
+  }
+
+  bool Struct(const reflection::Object &object, flexbuffers::Reference ref,
+              uint8_t *dest) {
+    if (!ref.IsMap()) {
+      return Error("expecting a map for " + object.name()->str());
+    }
+    auto map = ref.AsMap();
+    if (!CheckKeys(object, map)) return false;
+    for (auto it = object.fields()->begin(); it != object.fields()->end();
+         ++it) {
+      auto &field = **it;
+      auto type = field.type();
+      auto value = map[field.name()->c_str()];
+      auto path_size = Enter(field.name()->c_str());
+      if (value.IsNull()) return Error("missing struct field");
+      auto field_dest = dest + field.offset();
+      if (type->base_type() == reflection::Obj) {
+        auto &sub = *schema_.objects()->Get(type->index());
+        if (!Struct(sub, value, field_dest)) return false;
+      } else if (type->base_type() == reflection::Array) {
+        if (!value.IsAnyVector() || value.IsMap() ||
+            FlexSize(value) != type->fixed_length()) {
+          return Error("expecting a vector of " +
+                       NumToString(type->fixed_length()) + " elements");
+        }
+        if (!Inline(type->element(), type->index(), value,
+                    type->fixed_length(), field_dest)) {
+          return false;
+        }
+      } else if (!Scalar(type->base_type(), type->index(), value,
+                         field_dest)) {
+        return false;
+      }
+      path_.resize(path_size);
+    }
+    return true;
+  }
+
+  // Writes a scalar of `type`, which has enum `index` if it isn't -1.
+  bool Scalar(reflection::BaseType type, int index,
+              flexbuffers::Reference value, uint8_t *dest) {
+    if (IsFloat(type)) {
+      if (!value.IsNumeric()) return Error("expecting a number");
+      SetAnyValueF(type, dest, value.AsDouble());
+      return true;
+    }
+    int64_t i;
+    if (value.IsBool()) {
+      i = value.AsBool();
+    } else if (value.IsUInt() && value.AsUInt64() > 0x7FFFFFFFFFFFFFFFULL) {
+      if (type != reflection::ULong) {
+        return Error("value out of range: " + NumToString(value.AsUInt64()));
+      }
+      WriteScalar(dest, value.AsUInt64());
+      return true;
+    } else if (value.IsIntOrUint()) {
+      i = value.AsInt64();
+    } else if ((value.IsString() || value.IsKey()) && index >= 0) {
+      if (!EnumValue(*schema_.enums()->Get(index), value.AsString().c_str(),
+                     &i)) {
+        return false;
+      }
+    } else {
+      return Error("expecting an integer");
+    }
+    if (!IntegerFits(type, i)) {
+      return Error("value out of range: " + NumToString(i));
+    }
+    SetAnyValueI(type, dest, i);
+    return true;
+  }
+
+  // Names of enum values, separated by spaces to combine bit flags, and
+  // optionally qualified (`Color.Red`), as the parser reads them.
+  bool EnumValue(const reflection::Enum &enum_def, const char *str,
+                 int64_t *value) {
+    *value = 0;
+    for (auto p = str; *p;) {
+      if (*p == ' ') {
+        p++;
+        continue;
+      }
+      auto end = p;
+      while (*end && *end != ' ') end++;
+      auto name = std::string(p, end);
+      auto enum_val = LookupEnumVal(enum_def, name);
+      if (!enum_val) {
+        auto dot = name.rfind('.');
+        if (dot != std::string::npos) {
+          enum_val = LookupEnumVal(enum_def, name.substr(dot + 1));
+        }
+      }
+      if (!enum_val) return Error("unknown enum value: " + name);
+      *value |= enum_val->value();
+      p = end;
+    }
+    return true;
+  }
+
+  static const reflection::EnumVal *LookupEnumVal(
+      const reflection::Enum &enum_def, const std::string &name) {
+    auto values = enum_def.values();
+    for (auto it = values->begin(); it != values->end(); ++it) {
+      if (it->name()->str() == name) return *it;
+    }
+    return nullptr;
+  }
+
+  const reflection::Schema &schema_;
+  FlatBufferBuilder &fbb_;
+  bool skip_unknown_fields_;
+  std::string path_;
+  std::string error_;
+};
+
+// Writes the fields of FlatBufferToFlexBuffer().
+class FlatBufferTranscoder {
+ public:
+  FlatBufferTranscoder(const reflection::Schema &schema,
+                       flexbuffers::Builder &builder)
+      : schema_(schema), builder_(builder) {}
+
+  void Table(const reflection::Object &object,
+             const flatbuffers::Table &table) {
+    auto start = builder_.StartMap();
+    auto fields = object.fields();
+    for (auto it = fields->begin(); it != fields->end(); ++it) {
+      auto &field = **it;
+      if (field.deprecated() || !table.CheckField(field.offset())) continue;
+      builder_.Key(field.name()->c_str(), field.name()->size());
+      auto type = field.type();
+      switch (type->base_type()) {
+        case reflection::String: String(GetFieldS(table, field)); break;
+        case reflection::Obj: {
+          auto &sub = *schema_.objects()->Get(type->index());
+          if (sub.is_struct()) {
+            Struct(sub, table.GetStruct<const uint8_t *>(field.offset()));
+          } else {
+            Table(sub, *GetFieldT(table, field));
+          }
+          break;
+        }
+        case reflection::Union: {
+          auto type_name = field.name()->str() + UnionTypeFieldSuffix();
+          auto type_field = fields->LookupByKey(type_name.c_str());
+          Union(*type_field, GetFieldI<uint8_t>(table, *type_field),
+                table.GetPointer<const uint8_t *>(field.offset()));
+          break;
+        }
+        case reflection::Vector: {
+          auto nested = NestedFlatBufferRoot(schema_, object, field);
+          if (IsFlexBufferField(field)) {
+            auto bytes = GetFieldV<uint8_t>(table, field);
+            builder_.Add(flexbuffers::GetRoot(bytes->data(), bytes->size()));
+          } else if (nested && GetFieldV<uint8_t>(table, field)->size()) {
+            auto bytes = GetFieldV<uint8_t>(table, field);
+            Table(*nested, *GetAnyRoot(bytes->data()));
+          } else if (type->element() == reflection::Union) {
+            auto type_name = field.name()->str() + UnionTypeFieldSuffix();
+            auto type_field = fields->LookupByKey(type_name.c_str());
+            auto types = GetFieldV<uint8_t>(table, *type_field);
+            auto values = GetFieldV<flatbuffers::Offset<void>>(table, field);
+            auto vec = builder_.StartVector();
+            for (uoffset_t i = 0; i < values->size(); i++) {
+              Union(*type_field, types ? types->Get(i) : 0,
+                    reinterpret_cast<const uint8_t *>(values->Get(i)));
+            }
+            builder_.EndVector(vec, false, false);
+          } else {
+            Vector(*type, GetFieldAnyV(table, field));
+          }
+          break;
+        }
+        default: Scalar(type->base_type(), table.GetAddressOf(field.offset()));
+      }
+    }
+    builder_.EndMap(start);
+  }
+
+ private:
+  void String(const flatbuffers::String *str) {
+    builder_.String(str->c_str(), str->size());
+  }
+
+  void Union(const reflection::Field &type_field, uint8_t type,
+             const uint8_t *value) {
+    auto &enum_def = *schema_.enums()->Get(type_field.type()->index());
+    auto enum_val = enum_def.values()->LookupByKey(type);
+    if (!type || !enum_val || !value) {
+      builder_.Null();
+      return;
+    }
+    auto union_type = enum_val->union_type();
+    if (union_type->base_type() == reflection::String) {
+      String(reinterpret_cast<const flatbuffers::String *>(value));
+      return;
+    }
+    auto &sub = *schema_.objects()->Get(union_type->index());
+    if (sub.is_struct()) {
+      Struct(sub, value);
+    } else {
+      Table(sub, *reinterpret_cast<const flatbuffers::Table *>(value));
+    }
+  }
+
+  void Vector(const reflection::Type &type, const VectorOfAny *vec) {
+    auto element = type.element();
+    auto start = builder_.StartVector();
+    auto sub = element == reflection::Obj
+                   ? schema_.objects()->Get(type.index())
+                   : nullptr;
+    for (uoffset_t i = 0; i < vec->size(); i++) {
+      if (element == reflection::String) {
+        String(GetAnyVectorElemPointer<const flatbuffers::String>(vec, i));
+      } else if (sub && !sub->is_struct()) {
+        Table(*sub, *GetAnyVectorElemPointer<const flatbuffers::Table>(vec, i));
+      } else if (sub) {
+        Struct(*sub, GetAnyVectorElemAddressOf<const uint8_t>(
+                         vec, i, static_cast<size_t>(sub->bytesize())));
+      } else {
+        Scalar(element, GetAnyVectorElemAddressOf<const uint8_t>(
+                            vec, i, GetTypeSize(element)));
+      }
+    }
+    // Scalars make a typed vector.
+    builder_.EndVector(start, IsScalar(element), false);
+  }
+
+  void Struct(const reflection::Object &object, const uint8_t *data) {
+    auto start = builder_.StartMap();
+    for (auto it = object.fields()->begin(); it != object.fields()->end();
+         ++it) {
+      auto &field = **it;
+      auto type = field.type();
+      auto field_data = data + field.offset();
+      builder_.Key(field.name()->c_str(), field.name()->size());
+      if (type->base_type() == reflection::Obj) {
+        Struct(*schema_.objects()->Get(type->index()), field_data);
+      } else if (type->base_type() == reflection::Array) {
+        auto size = GetTypeSizeInline(type->element(), type->index(), schema_);
+        auto vec = builder_.StartVector();
+        for (size_t i = 0; i < type->fixed_length(); i++) {
+          if (type->element() == reflection::Obj) {
+            Struct(*schema_.objects()->Get(type->index()),
+                   field_data + i * size);
+          } else {
+            Scalar(type->element(), field_data + i * size);
+          }
+        }
+        builder_.EndVector(vec, type->element() != reflection::Obj, false);
+      } else {
+        Scalar(type->base_type(), field_data);
+      }
+    }
+    builder_.EndMap(start);
+  }
+
+  void Scalar(reflection::BaseType type, const uint8_t *data) {
+    switch (type) {
+      case reflection::Bool:
+        builder_.Bool(ReadScalar<uint8_t>(data) != 0);
+        break;
+      case reflection::Float: builder_.Float(ReadScalar<float>(data)); break;
+      case reflection::Double: builder_.Double(ReadScalar<double>(data)); break;
+      case reflection::ULong: builder_.UInt(ReadScalar<uint64_t>(data)); break;
+      case reflection::UType:
+      case reflection::UByte:
+      case reflection::UShort:
+      case reflection::UInt:
+        builder_.UInt(static_cast<uint64_t>(GetAnyValueI(type, data)));
+        break;
+      default: builder_.Int(GetAnyValueI(type, data)); break;
+    }
+  }
+
+  const reflection::Schema &schema_;
+  flexbuffers::Builder &builder_;
+};
+
+}  // namespace
+
+bool FlexBufferToFlatBuffer(const reflection::Schema &schema,
+                            const reflection::Object &root,
+                            flexbuffers::Reference flexbuffer,
+                            FlatBufferBuilder *fbb, std::string *error,
+                            bool skip_unknown_fields) {
+  FlexBufferTranscoder transcoder(schema, *fbb, skip_unknown_fields);
+  uoffset_t offset;
+  if (!transcoder.Table(root, flexbuffer, &offset)) {
+    *error = transcoder.error();
+    return false;
+  }
+  FinishWithIdentifier(schema, offset, *fbb);
+  return true;
+}
+
+void FlatBufferToFlexBuffer(const reflection::Schema &schema,
+                            const reflection::Object &root,
+                            const uint8_t *flatbuffer,
+                            flexbuffers::Builder *flexbuilder) {
+  FlatBufferTranscoder transcoder(schema, *flexbuilder);
+  transcoder.Table(root, *GetAnyRoot(flatbuffer));
+  flexbuilder->Finish();
+}
+
 bool VerifyStruct(flatbuffers::Verifier &v,
                   const flatbuffers::Table &parent_table,
                   voffset_t field_offset, const reflection::Object &obj,
@@ -35,8 +35,11 @@
 #  endif
 #  include <windows.h>  // Must be included before <direct.h>
 #  include <direct.h>
+#  include <io.h>
 #  include <winbase.h>
 #  undef interface  // This is also important because of reasons
+#else
+#  include <unistd.h>
 #endif
 // clang-format on
 
@@ -44,8 +47,10 @@
 
 #include <sys/stat.h>
 
+#include <cfloat>
 #include <clocale>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 
 #include "flatbuffers/base.h"
@@ -271,6 +276,25 @@ ClassicLocale ClassicLocale::instance_;
 
 #endif  // !FLATBUFFERS_LOCALE_INDEPENDENT
 
+bool FdTextSink::Write(const char *data, size_t size) {
+  while (size) {
+    // clang-format off
+    #ifdef _WIN32
+      const auto written = _write(fd_, data, static_cast<unsigned int>(size));
+    #else
+      const auto written = write(fd_, data, size);
+    #endif
+    // clang-format on
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
 std::string RemoveStringQuotes(const std::string &s) {
   auto ch = *s.c_str();
   return ((s.size() >= 2) && (ch == '\"' || ch == '\'') &&
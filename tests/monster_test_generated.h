@@ -6,6 +6,7 @@
 
 #include "flatbuffers/flatbuffers.h"
 #include "flatbuffers/flexbuffers.h"
+#include "flatbuffers/json.h"
 
 namespace MyGame {
 
@@ -273,6 +274,7 @@ struct AnyUnion {
 
   static void *UnPack(const void *obj, Any type, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
+  size_t PackedSizeUpperBound() const;
 
   MyGame::Example::MonsterT *AsMonster() {
     return type == Any_Monster ?
@@ -415,6 +417,7 @@ struct AnyUniqueAliasesUnion {
 
   static void *UnPack(const void *obj, AnyUniqueAliases type, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
+  size_t PackedSizeUpperBound() const;
 
   MyGame::Example::MonsterT *AsM() {
     return type == AnyUniqueAliases_M ?
@@ -529,6 +532,7 @@ struct AnyAmbiguousAliasesUnion {
 
   static void *UnPack(const void *obj, AnyAmbiguousAliases type, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
+  size_t PackedSizeUpperBound() const;
 
   MyGame::Example::MonsterT *AsM1() {
     return type == AnyAmbiguousAliases_M1 ?
@@ -855,6 +859,7 @@ struct InParentNamespace FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   InParentNamespaceT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   void UnPackTo(InParentNamespaceT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   static flatbuffers::Offset<InParentNamespace> Pack(flatbuffers::FlatBufferBuilder &_fbb, const InParentNamespaceT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+  static size_t PackedSizeUpperBound(const InParentNamespaceT &_o);
 };
 
 struct InParentNamespaceBuilder {
@@ -899,6 +904,7 @@ struct Monster FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   MonsterT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   void UnPackTo(MonsterT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   static flatbuffers::Offset<Monster> Pack(flatbuffers::FlatBufferBuilder &_fbb, const MonsterT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+  static size_t PackedSizeUpperBound(const MonsterT &_o);
 };
 
 struct MonsterBuilder {
@@ -956,6 +962,7 @@ struct TestSimpleTableWithEnum FLATBUFFERS_FINAL_CLASS : private flatbuffers::Ta
   TestSimpleTableWithEnumT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   void UnPackTo(TestSimpleTableWithEnumT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   static flatbuffers::Offset<TestSimpleTableWithEnum> Pack(flatbuffers::FlatBufferBuilder &_fbb, const TestSimpleTableWithEnumT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+  static size_t PackedSizeUpperBound(const TestSimpleTableWithEnumT &_o);
 };
 
 struct TestSimpleTableWithEnumBuilder {
@@ -1039,6 +1046,7 @@ struct Stat FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   StatT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   void UnPackTo(StatT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   static flatbuffers::Offset<Stat> Pack(flatbuffers::FlatBufferBuilder &_fbb, const StatT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+  static size_t PackedSizeUpperBound(const StatT &_o);
 };
 
 struct StatBuilder {
@@ -1126,6 +1134,7 @@ struct Referrable FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   ReferrableT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   void UnPackTo(ReferrableT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   static flatbuffers::Offset<Referrable> Pack(flatbuffers::FlatBufferBuilder &_fbb, const ReferrableT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+  static size_t PackedSizeUpperBound(const ReferrableT &_o);
 };
 
 struct ReferrableBuilder {
@@ -1693,6 +1702,7 @@ struct Monster FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   MonsterT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   void UnPackTo(MonsterT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   static flatbuffers::Offset<Monster> Pack(flatbuffers::FlatBufferBuilder &_fbb, const MonsterT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+  static size_t PackedSizeUpperBound(const MonsterT &_o);
 };
 
 template<> inline const MyGame::Example::Monster *Monster::test_as<MyGame::Example::Monster>() const {
@@ -2249,6 +2259,7 @@ struct TypeAliases FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   TypeAliasesT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   void UnPackTo(TypeAliasesT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
   static flatbuffers::Offset<TypeAliases> Pack(flatbuffers::FlatBufferBuilder &_fbb, const TypeAliasesT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+  static size_t PackedSizeUpperBound(const TypeAliasesT &_o);
 };
 
 struct TypeAliasesBuilder {
@@ -2393,6 +2404,12 @@ inline flatbuffers::Offset<InParentNamespace> InParentNamespace::Pack(flatbuffer
   return CreateInParentNamespace(_fbb, _o, _rehasher);
 }
 
+inline size_t InParentNamespace::PackedSizeUpperBound(const InParentNamespaceT &_o) {
+  (void)_o;
+  size_t _size = 15;
+  return _size;
+}
+
 inline flatbuffers::Offset<InParentNamespace> CreateInParentNamespace(flatbuffers::FlatBufferBuilder &_fbb, const InParentNamespaceT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
   (void)_rehasher;
   (void)_o;
@@ -2428,6 +2445,12 @@ inline flatbuffers::Offset<Monster> Monster::Pack(flatbuffers::FlatBufferBuilder
   return CreateMonster(_fbb, _o, _rehasher);
 }
 
+inline size_t Monster::PackedSizeUpperBound(const MonsterT &_o) {
+  (void)_o;
+  size_t _size = 15;
+  return _size;
+}
+
 inline flatbuffers::Offset<Monster> CreateMonster(flatbuffers::FlatBufferBuilder &_fbb, const MonsterT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
   (void)_rehasher;
   (void)_o;
@@ -2467,6 +2490,12 @@ inline flatbuffers::Offset<TestSimpleTableWithEnum> TestSimpleTableWithEnum::Pac
   return CreateTestSimpleTableWithEnum(_fbb, _o, _rehasher);
 }
 
+inline size_t TestSimpleTableWithEnum::PackedSizeUpperBound(const TestSimpleTableWithEnumT &_o) {
+  (void)_o;
+  size_t _size = 26;
+  return _size;
+}
+
 inline flatbuffers::Offset<TestSimpleTableWithEnum> CreateTestSimpleTableWithEnum(flatbuffers::FlatBufferBuilder &_fbb, const TestSimpleTableWithEnumT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
   (void)_rehasher;
   (void)_o;
@@ -2508,6 +2537,12 @@ inline flatbuffers::Offset<Stat> Stat::Pack(flatbuffers::FlatBufferBuilder &_fbb
   return CreateStat(_fbb, _o, _rehasher);
 }
 
+inline size_t Stat::PackedSizeUpperBound(const StatT &_o) {
+  size_t _size = 70;
+  _size += _o.id.length() + 8;
+  return _size;
+}
+
 inline flatbuffers::Offset<Stat> CreateStat(flatbuffers::FlatBufferBuilder &_fbb, const StatT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
   (void)_rehasher;
   (void)_o;
@@ -2549,6 +2584,12 @@ inline flatbuffers::Offset<Referrable> Referrable::Pack(flatbuffers::FlatBufferB
   return CreateReferrable(_fbb, _o, _rehasher);
 }
 
+inline size_t Referrable::PackedSizeUpperBound(const ReferrableT &_o) {
+  (void)_o;
+  size_t _size = 40;
+  return _size;
+}
+
 inline flatbuffers::Offset<Referrable> CreateReferrable(flatbuffers::FlatBufferBuilder &_fbb, const ReferrableT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
   (void)_rehasher;
   (void)_o;
@@ -2688,6 +2729,46 @@ inline flatbuffers::Offset<Monster> Monster::Pack(flatbuffers::FlatBufferBuilder
   return CreateMonster(_fbb, _o, _rehasher);
 }
 
+inline size_t Monster::PackedSizeUpperBound(const MonsterT &_o) {
+  size_t _size = 911;
+  _size += _o.name.length() + 8;
+  _size += _o.inventory.size() * 1 + 9;
+  _size += _o.test.PackedSizeUpperBound();
+  _size += _o.test4.size() * 4 + 10;
+  _size += _o.testarrayofstring.size() * 4 + 12;
+  _size += _o.testarrayofstring.size() * 4;
+  for (size_t _i = 0; _i < _o.testarrayofstring.size(); _i++) { _size += _o.testarrayofstring[_i].length() + 8; }
+  _size += _o.testarrayoftables.size() * 4 + 12;
+  for (size_t _i = 0; _i < _o.testarrayoftables.size(); _i++) { _size += MyGame::Example::Monster::PackedSizeUpperBound(*_o.testarrayoftables[_i].get()); }
+  if (_o.enemy) { _size += MyGame::Example::Monster::PackedSizeUpperBound(*_o.enemy.get()); }
+  _size += _o.testnestedflatbuffer.size() * 1 + 9;
+  if (_o.testempty) { _size += MyGame::Example::Stat::PackedSizeUpperBound(*_o.testempty.get()); }
+  _size += _o.testarrayofbools.size() * 1 + 9;
+  _size += _o.testarrayofstring2.size() * 4 + 12;
+  _size += _o.testarrayofstring2.size() * 4;
+  for (size_t _i = 0; _i < _o.testarrayofstring2.size(); _i++) { _size += _o.testarrayofstring2[_i].length() + 8; }
+  _size += _o.testarrayofsortedstruct.size() * 8 + 12;
+  _size += _o.flex.size() * 1 + 9;
+  _size += _o.test5.size() * 4 + 10;
+  _size += _o.vector_of_longs.size() * 8 + 16;
+  _size += _o.vector_of_doubles.size() * 8 + 16;
+  if (_o.parent_namespace_test) { _size += MyGame::InParentNamespace::PackedSizeUpperBound(*_o.parent_namespace_test.get()); }
+  _size += _o.vector_of_referrables.size() * 4 + 12;
+  for (size_t _i = 0; _i < _o.vector_of_referrables.size(); _i++) { _size += MyGame::Example::Referrable::PackedSizeUpperBound(*_o.vector_of_referrables[_i].get()); }
+  _size += _o.vector_of_weak_references.size() * 8 + 16;
+  _size += _o.vector_of_strong_referrables.size() * 4 + 12;
+  for (size_t _i = 0; _i < _o.vector_of_strong_referrables.size(); _i++) { _size += MyGame::Example::Referrable::PackedSizeUpperBound(*_o.vector_of_strong_referrables[_i].get()); }
+  _size += _o.vector_of_co_owning_references.size() * 8 + 16;
+  _size += _o.vector_of_non_owning_references.size() * 8 + 16;
+  _size += _o.any_unique.PackedSizeUpperBound();
+  _size += _o.any_ambiguous.PackedSizeUpperBound();
+  _size += _o.vector_of_enums.size() * 1 + 9;
+  _size += _o.testrequirednestedflatbuffer.size() * 1 + 9;
+  _size += _o.scalar_key_sorted_tables.size() * 4 + 12;
+  for (size_t _i = 0; _i < _o.scalar_key_sorted_tables.size(); _i++) { _size += MyGame::Example::Stat::PackedSizeUpperBound(*_o.scalar_key_sorted_tables[_i].get()); }
+  return _size;
+}
+
 inline flatbuffers::Offset<Monster> CreateMonster(flatbuffers::FlatBufferBuilder &_fbb, const MonsterT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
   (void)_rehasher;
   (void)_o;
@@ -2845,6 +2926,13 @@ inline flatbuffers::Offset<TypeAliases> TypeAliases::Pack(flatbuffers::FlatBuffe
   return CreateTypeAliases(_fbb, _o, _rehasher);
 }
 
+inline size_t TypeAliases::PackedSizeUpperBound(const TypeAliasesT &_o) {
+  size_t _size = 223;
+  _size += _o.v8.size() * 1 + 9;
+  _size += _o.vf64.size() * 8 + 16;
+  return _size;
+}
+
 inline flatbuffers::Offset<TypeAliases> CreateTypeAliases(flatbuffers::FlatBufferBuilder &_fbb, const TypeAliasesT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
   (void)_rehasher;
   (void)_o;
@@ -2946,6 +3034,15 @@ inline flatbuffers::Offset<void> AnyUnion::Pack(flatbuffers::FlatBufferBuilder &
   }
 }
 
+inline size_t AnyUnion::PackedSizeUpperBound() const {
+  switch (type) {
+    case Any_Monster: return MyGame::Example::Monster::PackedSizeUpperBound(*reinterpret_cast<const MyGame::Example::MonsterT *>(value));
+    case Any_TestSimpleTableWithEnum: return MyGame::Example::TestSimpleTableWithEnum::PackedSizeUpperBound(*reinterpret_cast<const MyGame::Example::TestSimpleTableWithEnumT *>(value));
+    case Any_MyGame_Example2_Monster: return MyGame::Example2::Monster::PackedSizeUpperBound(*reinterpret_cast<const MyGame::Example2::MonsterT *>(value));
+    default: return 0;
+  }
+}
+
 inline AnyUnion::AnyUnion(const AnyUnion &u) : type(u.type), value(nullptr) {
   switch (type) {
     case Any_Monster: {
@@ -3057,6 +3154,15 @@ inline flatbuffers::Offset<void> AnyUniqueAliasesUnion::Pack(flatbuffers::FlatBu
   }
 }
 
+inline size_t AnyUniqueAliasesUnion::PackedSizeUpperBound() const {
+  switch (type) {
+    case AnyUniqueAliases_M: return MyGame::Example::Monster::PackedSizeUpperBound(*reinterpret_cast<const MyGame::Example::MonsterT *>(value));
+    case AnyUniqueAliases_TS: return MyGame::Example::TestSimpleTableWithEnum::PackedSizeUpperBound(*reinterpret_cast<const MyGame::Example::TestSimpleTableWithEnumT *>(value));
+    case AnyUniqueAliases_M2: return MyGame::Example2::Monster::PackedSizeUpperBound(*reinterpret_cast<const MyGame::Example2::MonsterT *>(value));
+    default: return 0;
+  }
+}
+
 inline AnyUniqueAliasesUnion::AnyUniqueAliasesUnion(const AnyUniqueAliasesUnion &u) : type(u.type), value(nullptr) {
   switch (type) {
     case AnyUniqueAliases_M: {
@@ -3168,6 +3274,15 @@ inline flatbuffers::Offset<void> AnyAmbiguousAliasesUnion::Pack(flatbuffers::Fla
   }
 }
 
+inline size_t AnyAmbiguousAliasesUnion::PackedSizeUpperBound() const {
+  switch (type) {
+    case AnyAmbiguousAliases_M1: return MyGame::Example::Monster::PackedSizeUpperBound(*reinterpret_cast<const MyGame::Example::MonsterT *>(value));
+    case AnyAmbiguousAliases_M2: return MyGame::Example::Monster::PackedSizeUpperBound(*reinterpret_cast<const MyGame::Example::MonsterT *>(value));
+    case AnyAmbiguousAliases_M3: return MyGame::Example::Monster::PackedSizeUpperBound(*reinterpret_cast<const MyGame::Example::MonsterT *>(value));
+    default: return 0;
+  }
+}
+
 inline AnyAmbiguousAliasesUnion::AnyAmbiguousAliasesUnion(const AnyAmbiguousAliasesUnion &u) : type(u.type), value(nullptr) {
   switch (type) {
     case AnyAmbiguousAliases_M1: {
@@ -3636,6 +3751,1530 @@ inline const flatbuffers::TypeTable *TypeAliasesTypeTable() {
   return &tt;
 }
 
+}  // namespace Example
+
+inline bool InParentNamespaceToJson(const InParentNamespace *obj, flatbuffers::JsonWriter &writer);
+inline bool InParentNamespaceFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<InParentNamespace> *_o);
+namespace Example2 {
+
+inline bool MonsterToJson(const Monster *obj, flatbuffers::JsonWriter &writer);
+inline bool MonsterFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<Monster> *_o);
+}  // namespace Example2
+
+namespace Example {
+
+inline bool TestToJson(const Test *obj, flatbuffers::JsonWriter &writer);
+inline bool TestFromJson(flatbuffers::JsonReader &_reader, Test *_o);
+inline bool TestSimpleTableWithEnumToJson(const TestSimpleTableWithEnum *obj, flatbuffers::JsonWriter &writer);
+inline bool TestSimpleTableWithEnumFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<TestSimpleTableWithEnum> *_o);
+inline bool Vec3ToJson(const Vec3 *obj, flatbuffers::JsonWriter &writer);
+inline bool Vec3FromJson(flatbuffers::JsonReader &_reader, Vec3 *_o);
+inline bool AbilityToJson(const Ability *obj, flatbuffers::JsonWriter &writer);
+inline bool AbilityFromJson(flatbuffers::JsonReader &_reader, Ability *_o);
+inline bool StructOfStructsToJson(const StructOfStructs *obj, flatbuffers::JsonWriter &writer);
+inline bool StructOfStructsFromJson(flatbuffers::JsonReader &_reader, StructOfStructs *_o);
+inline bool StatToJson(const Stat *obj, flatbuffers::JsonWriter &writer);
+inline bool StatFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<Stat> *_o);
+inline bool ReferrableToJson(const Referrable *obj, flatbuffers::JsonWriter &writer);
+inline bool ReferrableFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<Referrable> *_o);
+inline bool MonsterToJson(const Monster *obj, flatbuffers::JsonWriter &writer);
+inline bool MonsterFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<Monster> *_o);
+inline bool TypeAliasesToJson(const TypeAliases *obj, flatbuffers::JsonWriter &writer);
+inline bool TypeAliasesFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<TypeAliases> *_o);
+inline bool AnyToJson(const void *obj, Any type, flatbuffers::JsonWriter &writer);
+inline bool AnyFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, Any type, flatbuffers::Offset<void> *_o);
+inline bool AnyUniqueAliasesToJson(const void *obj, AnyUniqueAliases type, flatbuffers::JsonWriter &writer);
+inline bool AnyUniqueAliasesFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, AnyUniqueAliases type, flatbuffers::Offset<void> *_o);
+inline bool AnyAmbiguousAliasesToJson(const void *obj, AnyAmbiguousAliases type, flatbuffers::JsonWriter &writer);
+inline bool AnyAmbiguousAliasesFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, AnyAmbiguousAliases type, flatbuffers::Offset<void> *_o);
+
+inline const flatbuffers::JsonEnum *ColorJsonEnum() {
+  static const int64_t values[] = { 1LL, 2LL, 8LL };
+  static const char * const names[] = {
+    "Red",
+    "Green",
+    "Blue"
+  };
+  static const flatbuffers::JsonEnum json_enum = {
+    3, values, names, true
+  };
+  return &json_enum;
+}
+
+inline const flatbuffers::JsonEnum *RaceJsonEnum() {
+  static const int64_t values[] = { -1LL, 0, 1LL, 2LL };
+  static const char * const names[] = {
+    "None",
+    "Human",
+    "Dwarf",
+    "Elf"
+  };
+  static const flatbuffers::JsonEnum json_enum = {
+    4, values, names, false
+  };
+  return &json_enum;
+}
+
+inline const flatbuffers::JsonEnum *AnyJsonEnum() {
+  static const int64_t values[] = { 0, 1LL, 2LL, 3LL };
+  static const char * const names[] = {
+    "NONE",
+    "Monster",
+    "TestSimpleTableWithEnum",
+    "MyGame_Example2_Monster"
+  };
+  static const flatbuffers::JsonEnum json_enum = {
+    4, values, names, false
+  };
+  return &json_enum;
+}
+
+inline const flatbuffers::JsonEnum *AnyUniqueAliasesJsonEnum() {
+  static const int64_t values[] = { 0, 1LL, 2LL, 3LL };
+  static const char * const names[] = {
+    "NONE",
+    "M",
+    "TS",
+    "M2"
+  };
+  static const flatbuffers::JsonEnum json_enum = {
+    4, values, names, false
+  };
+  return &json_enum;
+}
+
+inline const flatbuffers::JsonEnum *AnyAmbiguousAliasesJsonEnum() {
+  static const int64_t values[] = { 0, 1LL, 2LL, 3LL };
+  static const char * const names[] = {
+    "NONE",
+    "M1",
+    "M2",
+    "M3"
+  };
+  static const flatbuffers::JsonEnum json_enum = {
+    4, values, names, false
+  };
+  return &json_enum;
+}
+
+}  // namespace Example
+
+inline bool InParentNamespaceToJson(const InParentNamespace *obj, flatbuffers::JsonWriter &writer) {
+  (void)obj;
+  writer.StartObject();
+  writer.EndObject();
+  return writer.ok();
+}
+
+inline bool InParentNamespaceFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<InParentNamespace> *_o) {
+  if (!_reader.StartObject()) return false;
+  while (_reader.NextField()) {
+    if (!_reader.UnknownField()) {
+      return false;
+    }
+  }
+  if (!_reader.ok()) return false;
+  *_o = CreateInParentNamespace(
+      _fbb);
+  return true;
+}
+
+namespace Example2 {
+
+inline bool MonsterToJson(const Monster *obj, flatbuffers::JsonWriter &writer) {
+  (void)obj;
+  writer.StartObject();
+  writer.EndObject();
+  return writer.ok();
+}
+
+inline bool MonsterFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<Monster> *_o) {
+  if (!_reader.StartObject()) return false;
+  while (_reader.NextField()) {
+    if (!_reader.UnknownField()) {
+      return false;
+    }
+  }
+  if (!_reader.ok()) return false;
+  *_o = CreateMonster(
+      _fbb);
+  return true;
+}
+
+}  // namespace Example2
+
+namespace Example {
+
+inline bool TestToJson(const Test *obj, flatbuffers::JsonWriter &writer) {
+  auto p = reinterpret_cast<const uint8_t *>(obj);
+  writer.StartObject();
+  writer.Key("a");
+  writer.Number(flatbuffers::ReadScalar<int16_t>(p + 0));
+  writer.Key("b");
+  writer.Number(flatbuffers::ReadScalar<int8_t>(p + 2));
+  writer.EndObject();
+  return writer.ok();
+}
+
+inline bool TestFromJson(flatbuffers::JsonReader &_reader, Test *_o) {
+  auto p = reinterpret_cast<uint8_t *>(_o);
+  memset(p, 0, sizeof(Test));
+  if (!_reader.StartObject()) return false;
+  while (_reader.NextField()) {
+    if (_reader.KeyIs("a")) {
+      int16_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      flatbuffers::WriteScalar(p + 0, _val);
+    } else if (_reader.KeyIs("b")) {
+      int8_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      flatbuffers::WriteScalar(p + 2, _val);
+    } else if (!_reader.UnknownField()) {
+      return false;
+    }
+  }
+  return _reader.ok();
+}
+
+inline bool TestSimpleTableWithEnumToJson(const TestSimpleTableWithEnum *obj, flatbuffers::JsonWriter &writer) {
+  auto table = reinterpret_cast<const flatbuffers::Table *>(obj);
+  writer.StartObject();
+  if (table->CheckField(TestSimpleTableWithEnum::VT_COLOR) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("color");
+    writer.Enum(table->GetField<uint8_t>(TestSimpleTableWithEnum::VT_COLOR, 2), MyGame::Example::ColorJsonEnum());
+  }
+  writer.EndObject();
+  return writer.ok();
+}
+
+inline bool TestSimpleTableWithEnumFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<TestSimpleTableWithEnum> *_o) {
+  MyGame::Example::Color color = MyGame::Example::Color_Green;
+  if (!_reader.StartObject()) return false;
+  while (_reader.NextField()) {
+    if (_reader.KeyIs("color")) {
+      uint8_t _val;
+      if (!_reader.Enum(MyGame::Example::ColorJsonEnum(), &_val)) return false;
+      color = static_cast<MyGame::Example::Color>(_val);
+    } else if (!_reader.UnknownField()) {
+      return false;
+    }
+  }
+  if (!_reader.ok()) return false;
+  *_o = CreateTestSimpleTableWithEnum(
+      _fbb,
+      color);
+  return true;
+}
+
+inline bool Vec3ToJson(const Vec3 *obj, flatbuffers::JsonWriter &writer) {
+  auto p = reinterpret_cast<const uint8_t *>(obj);
+  writer.StartObject();
+  writer.Key("x");
+  writer.Number(flatbuffers::ReadScalar<float>(p + 0));
+  writer.Key("y");
+  writer.Number(flatbuffers::ReadScalar<float>(p + 4));
+  writer.Key("z");
+  writer.Number(flatbuffers::ReadScalar<float>(p + 8));
+  writer.Key("test1");
+  writer.Number(flatbuffers::ReadScalar<double>(p + 16));
+  writer.Key("test2");
+  writer.Enum(flatbuffers::ReadScalar<uint8_t>(p + 24), MyGame::Example::ColorJsonEnum());
+  writer.Key("test3");
+  if (!MyGame::Example::TestToJson(reinterpret_cast<const MyGame::Example::Test *>(p + 26), writer)) return false;
+  writer.EndObject();
+  return writer.ok();
+}
+
+inline bool Vec3FromJson(flatbuffers::JsonReader &_reader, Vec3 *_o) {
+  auto p = reinterpret_cast<uint8_t *>(_o);
+  memset(p, 0, sizeof(Vec3));
+  if (!_reader.StartObject()) return false;
+  while (_reader.NextField()) {
+    if (_reader.KeyIs("x")) {
+      float _val;
+      if (!_reader.Scalar(&_val)) return false;
+      flatbuffers::WriteScalar(p + 0, _val);
+    } else if (_reader.KeyIs("y")) {
+      float _val;
+      if (!_reader.Scalar(&_val)) return false;
+      flatbuffers::WriteScalar(p + 4, _val);
+    } else if (_reader.KeyIs("z")) {
+      float _val;
+      if (!_reader.Scalar(&_val)) return false;
+      flatbuffers::WriteScalar(p + 8, _val);
+    } else if (_reader.KeyIs("test1")) {
+      double _val;
+      if (!_reader.Scalar(&_val)) return false;
+      flatbuffers::WriteScalar(p + 16, _val);
+    } else if (_reader.KeyIs("test2")) {
+      uint8_t _val;
+      if (!_reader.Enum(MyGame::Example::ColorJsonEnum(), &_val)) return false;
+      flatbuffers::WriteScalar(p + 24, _val);
+    } else if (_reader.KeyIs("test3")) {
+      if (!MyGame::Example::TestFromJson(_reader, reinterpret_cast<MyGame::Example::Test *>(p + 26))) return false;
+    } else if (!_reader.UnknownField()) {
+      return false;
+    }
+  }
+  return _reader.ok();
+}
+
+inline bool AbilityToJson(const Ability *obj, flatbuffers::JsonWriter &writer) {
+  auto p = reinterpret_cast<const uint8_t *>(obj);
+  writer.StartObject();
+  writer.Key("id");
+  writer.Number(flatbuffers::ReadScalar<uint32_t>(p + 0));
+  writer.Key("distance");
+  writer.Number(flatbuffers::ReadScalar<uint32_t>(p + 4));
+  writer.EndObject();
+  return writer.ok();
+}
+
+inline bool AbilityFromJson(flatbuffers::JsonReader &_reader, Ability *_o) {
+  auto p = reinterpret_cast<uint8_t *>(_o);
+  memset(p, 0, sizeof(Ability));
+  if (!_reader.StartObject()) return false;
+  while (_reader.NextField()) {
+    if (_reader.KeyIs("id")) {
+      uint32_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      flatbuffers::WriteScalar(p + 0, _val);
+    } else if (_reader.KeyIs("distance")) {
+      uint32_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      flatbuffers::WriteScalar(p + 4, _val);
+    } else if (!_reader.UnknownField()) {
+      return false;
+    }
+  }
+  return _reader.ok();
+}
+
+inline bool StructOfStructsToJson(const StructOfStructs *obj, flatbuffers::JsonWriter &writer) {
+  auto p = reinterpret_cast<const uint8_t *>(obj);
+  writer.StartObject();
+  writer.Key("a");
+  if (!MyGame::Example::AbilityToJson(reinterpret_cast<const MyGame::Example::Ability *>(p + 0), writer)) return false;
+  writer.Key("b");
+  if (!MyGame::Example::TestToJson(reinterpret_cast<const MyGame::Example::Test *>(p + 8), writer)) return false;
+  writer.Key("c");
+  if (!MyGame::Example::AbilityToJson(reinterpret_cast<const MyGame::Example::Ability *>(p + 12), writer)) return false;
+  writer.EndObject();
+  return writer.ok();
+}
+
+inline bool StructOfStructsFromJson(flatbuffers::JsonReader &_reader, StructOfStructs *_o) {
+  auto p = reinterpret_cast<uint8_t *>(_o);
+  memset(p, 0, sizeof(StructOfStructs));
+  if (!_reader.StartObject()) return false;
+  while (_reader.NextField()) {
+    if (_reader.KeyIs("a")) {
+      if (!MyGame::Example::AbilityFromJson(_reader, reinterpret_cast<MyGame::Example::Ability *>(p + 0))) return false;
+    } else if (_reader.KeyIs("b")) {
+      if (!MyGame::Example::TestFromJson(_reader, reinterpret_cast<MyGame::Example::Test *>(p + 8))) return false;
+    } else if (_reader.KeyIs("c")) {
+      if (!MyGame::Example::AbilityFromJson(_reader, reinterpret_cast<MyGame::Example::Ability *>(p + 12))) return false;
+    } else if (!_reader.UnknownField()) {
+      return false;
+    }
+  }
+  return _reader.ok();
+}
+
+inline bool StatToJson(const Stat *obj, flatbuffers::JsonWriter &writer) {
+  auto table = reinterpret_cast<const flatbuffers::Table *>(obj);
+  writer.StartObject();
+  if (table->CheckField(Stat::VT_ID)) {
+    writer.Key("id");
+    writer.String(table->GetPointer<const flatbuffers::String *>(Stat::VT_ID));
+  }
+  if (table->CheckField(Stat::VT_VAL) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("val");
+    writer.Number(table->GetField<int64_t>(Stat::VT_VAL, 0));
+  }
+  {
+    writer.Key("count");
+    writer.Number(table->GetField<uint16_t>(Stat::VT_COUNT, 0));
+  }
+  writer.EndObject();
+  return writer.ok();
+}
+
+inline bool StatFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<Stat> *_o) {
+  flatbuffers::Offset<flatbuffers::String> id = 0;
+  int64_t val = 0;
+  uint16_t count = 0;
+  if (!_reader.StartObject()) return false;
+  while (_reader.NextField()) {
+    if (_reader.KeyIs("id")) {
+      if (!_reader.String(_fbb, &id)) return false;
+    } else if (_reader.KeyIs("val")) {
+      int64_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      val = _val;
+    } else if (_reader.KeyIs("count")) {
+      uint16_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      count = _val;
+    } else if (!_reader.UnknownField()) {
+      return false;
+    }
+  }
+  if (!_reader.ok()) return false;
+  *_o = CreateStat(
+      _fbb,
+      id,
+      val,
+      count);
+  return true;
+}
+
+inline bool ReferrableToJson(const Referrable *obj, flatbuffers::JsonWriter &writer) {
+  auto table = reinterpret_cast<const flatbuffers::Table *>(obj);
+  writer.StartObject();
+  {
+    writer.Key("id");
+    writer.Number(table->GetField<uint64_t>(Referrable::VT_ID, 0));
+  }
+  writer.EndObject();
+  return writer.ok();
+}
+
+inline bool ReferrableFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<Referrable> *_o) {
+  uint64_t id = 0;
+  if (!_reader.StartObject()) return false;
+  while (_reader.NextField()) {
+    if (_reader.KeyIs("id")) {
+      uint64_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1a<uint64_t>, &_val)) return false;
+      id = _val;
+    } else if (!_reader.UnknownField()) {
+      return false;
+    }
+  }
+  if (!_reader.ok()) return false;
+  *_o = CreateReferrable(
+      _fbb,
+      id);
+  return true;
+}
+
+inline bool MonsterToJson(const Monster *obj, flatbuffers::JsonWriter &writer) {
+  auto table = reinterpret_cast<const flatbuffers::Table *>(obj);
+  writer.StartObject();
+  if (table->CheckField(Monster::VT_POS)) {
+    writer.Key("pos");
+    if (!MyGame::Example::Vec3ToJson(table->GetStruct<const MyGame::Example::Vec3 *>(Monster::VT_POS), writer)) return false;
+  }
+  if (table->CheckField(Monster::VT_MANA) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("mana");
+    writer.Number(table->GetField<int16_t>(Monster::VT_MANA, 150));
+  }
+  if (table->CheckField(Monster::VT_HP) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("hp");
+    writer.Number(table->GetField<int16_t>(Monster::VT_HP, 100));
+  }
+  if (table->CheckField(Monster::VT_NAME)) {
+    writer.Key("name");
+    writer.String(table->GetPointer<const flatbuffers::String *>(Monster::VT_NAME));
+  }
+  if (table->CheckField(Monster::VT_INVENTORY)) {
+    writer.Key("inventory");
+    auto vec = table->GetPointer<const flatbuffers::Vector<uint8_t> *>(Monster::VT_INVENTORY);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.Number(vec->Get(i));
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_COLOR) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("color");
+    writer.Enum(table->GetField<uint8_t>(Monster::VT_COLOR, 8), MyGame::Example::ColorJsonEnum());
+  }
+  if (table->CheckField(Monster::VT_TEST_TYPE) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("test_type");
+    writer.Enum(table->GetField<uint8_t>(Monster::VT_TEST_TYPE, 0), MyGame::Example::AnyJsonEnum());
+  }
+  if (table->CheckField(Monster::VT_TEST)) {
+    writer.Key("test");
+    if (!MyGame::Example::AnyToJson(table->GetPointer<const void *>(Monster::VT_TEST),
+        static_cast<MyGame::Example::Any>(table->GetField<uint8_t>(Monster::VT_TEST_TYPE, 0)),
+        writer)) {
+      return false;
+    }
+  }
+  if (table->CheckField(Monster::VT_TEST4)) {
+    writer.Key("test4");
+    auto vec = table->GetPointer<const flatbuffers::Vector<const MyGame::Example::Test *> *>(Monster::VT_TEST4);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      if (!MyGame::Example::TestToJson(vec->Get(i), writer)) return false;
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_TESTARRAYOFSTRING)) {
+    writer.Key("testarrayofstring");
+    auto vec = table->GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(Monster::VT_TESTARRAYOFSTRING);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.String(vec->Get(i));
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_TESTARRAYOFTABLES)) {
+    writer.Key("testarrayoftables");
+    auto vec = table->GetPointer<const flatbuffers::Vector<flatbuffers::Offset<MyGame::Example::Monster>> *>(Monster::VT_TESTARRAYOFTABLES);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      if (!MyGame::Example::MonsterToJson(vec->Get(i), writer)) return false;
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_ENEMY)) {
+    writer.Key("enemy");
+    if (!MyGame::Example::MonsterToJson(table->GetPointer<const MyGame::Example::Monster *>(Monster::VT_ENEMY), writer)) return false;
+  }
+  if (table->CheckField(Monster::VT_TESTNESTEDFLATBUFFER)) {
+    writer.Key("testnestedflatbuffer");
+    auto vec = table->GetPointer<const flatbuffers::Vector<uint8_t> *>(Monster::VT_TESTNESTEDFLATBUFFER);
+    if (!MyGame::Example::MonsterToJson(flatbuffers::GetRoot<MyGame::Example::Monster>(vec->data()), writer)) {
+      return false;
+    }
+  }
+  if (table->CheckField(Monster::VT_TESTEMPTY)) {
+    writer.Key("testempty");
+    if (!MyGame::Example::StatToJson(table->GetPointer<const MyGame::Example::Stat *>(Monster::VT_TESTEMPTY), writer)) return false;
+  }
+  if (table->CheckField(Monster::VT_TESTBOOL) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testbool");
+    writer.Bool(table->GetField<uint8_t>(Monster::VT_TESTBOOL, 0) != 0);
+  }
+  if (table->CheckField(Monster::VT_TESTHASHS32_FNV1) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testhashs32_fnv1");
+    writer.Number(table->GetField<int32_t>(Monster::VT_TESTHASHS32_FNV1, 0));
+  }
+  if (table->CheckField(Monster::VT_TESTHASHU32_FNV1) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testhashu32_fnv1");
+    writer.Number(table->GetField<uint32_t>(Monster::VT_TESTHASHU32_FNV1, 0));
+  }
+  if (table->CheckField(Monster::VT_TESTHASHS64_FNV1) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testhashs64_fnv1");
+    writer.Number(table->GetField<int64_t>(Monster::VT_TESTHASHS64_FNV1, 0));
+  }
+  if (table->CheckField(Monster::VT_TESTHASHU64_FNV1) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testhashu64_fnv1");
+    writer.Number(table->GetField<uint64_t>(Monster::VT_TESTHASHU64_FNV1, 0));
+  }
+  if (table->CheckField(Monster::VT_TESTHASHS32_FNV1A) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testhashs32_fnv1a");
+    writer.Number(table->GetField<int32_t>(Monster::VT_TESTHASHS32_FNV1A, 0));
+  }
+  if (table->CheckField(Monster::VT_TESTHASHU32_FNV1A) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testhashu32_fnv1a");
+    writer.Number(table->GetField<uint32_t>(Monster::VT_TESTHASHU32_FNV1A, 0));
+  }
+  if (table->CheckField(Monster::VT_TESTHASHS64_FNV1A) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testhashs64_fnv1a");
+    writer.Number(table->GetField<int64_t>(Monster::VT_TESTHASHS64_FNV1A, 0));
+  }
+  if (table->CheckField(Monster::VT_TESTHASHU64_FNV1A) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testhashu64_fnv1a");
+    writer.Number(table->GetField<uint64_t>(Monster::VT_TESTHASHU64_FNV1A, 0));
+  }
+  if (table->CheckField(Monster::VT_TESTARRAYOFBOOLS)) {
+    writer.Key("testarrayofbools");
+    auto vec = table->GetPointer<const flatbuffers::Vector<uint8_t> *>(Monster::VT_TESTARRAYOFBOOLS);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.Bool(vec->Get(i) != 0);
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_TESTF) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testf");
+    writer.Number(table->GetField<float>(Monster::VT_TESTF, 3.14159f));
+  }
+  if (table->CheckField(Monster::VT_TESTF2) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testf2");
+    writer.Number(table->GetField<float>(Monster::VT_TESTF2, 3.0f));
+  }
+  if (table->CheckField(Monster::VT_TESTF3) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("testf3");
+    writer.Number(table->GetField<float>(Monster::VT_TESTF3, 0.0f));
+  }
+  if (table->CheckField(Monster::VT_TESTARRAYOFSTRING2)) {
+    writer.Key("testarrayofstring2");
+    auto vec = table->GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(Monster::VT_TESTARRAYOFSTRING2);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.String(vec->Get(i));
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_TESTARRAYOFSORTEDSTRUCT)) {
+    writer.Key("testarrayofsortedstruct");
+    auto vec = table->GetPointer<const flatbuffers::Vector<const MyGame::Example::Ability *> *>(Monster::VT_TESTARRAYOFSORTEDSTRUCT);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      if (!MyGame::Example::AbilityToJson(vec->Get(i), writer)) return false;
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_FLEX)) {
+    writer.Key("flex");
+    auto vec = table->GetPointer<const flatbuffers::Vector<uint8_t> *>(Monster::VT_FLEX);
+    writer.FlexBuffer(vec);
+  }
+  if (table->CheckField(Monster::VT_TEST5)) {
+    writer.Key("test5");
+    auto vec = table->GetPointer<const flatbuffers::Vector<const MyGame::Example::Test *> *>(Monster::VT_TEST5);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      if (!MyGame::Example::TestToJson(vec->Get(i), writer)) return false;
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_VECTOR_OF_LONGS)) {
+    writer.Key("vector_of_longs");
+    auto vec = table->GetPointer<const flatbuffers::Vector<int64_t> *>(Monster::VT_VECTOR_OF_LONGS);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.Number(vec->Get(i));
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_VECTOR_OF_DOUBLES)) {
+    writer.Key("vector_of_doubles");
+    auto vec = table->GetPointer<const flatbuffers::Vector<double> *>(Monster::VT_VECTOR_OF_DOUBLES);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.Number(vec->Get(i));
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_PARENT_NAMESPACE_TEST)) {
+    writer.Key("parent_namespace_test");
+    if (!MyGame::InParentNamespaceToJson(table->GetPointer<const MyGame::InParentNamespace *>(Monster::VT_PARENT_NAMESPACE_TEST), writer)) return false;
+  }
+  if (table->CheckField(Monster::VT_VECTOR_OF_REFERRABLES)) {
+    writer.Key("vector_of_referrables");
+    auto vec = table->GetPointer<const flatbuffers::Vector<flatbuffers::Offset<MyGame::Example::Referrable>> *>(Monster::VT_VECTOR_OF_REFERRABLES);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      if (!MyGame::Example::ReferrableToJson(vec->Get(i), writer)) return false;
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_SINGLE_WEAK_REFERENCE) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("single_weak_reference");
+    writer.Number(table->GetField<uint64_t>(Monster::VT_SINGLE_WEAK_REFERENCE, 0));
+  }
+  if (table->CheckField(Monster::VT_VECTOR_OF_WEAK_REFERENCES)) {
+    writer.Key("vector_of_weak_references");
+    auto vec = table->GetPointer<const flatbuffers::Vector<uint64_t> *>(Monster::VT_VECTOR_OF_WEAK_REFERENCES);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.Number(vec->Get(i));
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_VECTOR_OF_STRONG_REFERRABLES)) {
+    writer.Key("vector_of_strong_referrables");
+    auto vec = table->GetPointer<const flatbuffers::Vector<flatbuffers::Offset<MyGame::Example::Referrable>> *>(Monster::VT_VECTOR_OF_STRONG_REFERRABLES);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      if (!MyGame::Example::ReferrableToJson(vec->Get(i), writer)) return false;
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_CO_OWNING_REFERENCE) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("co_owning_reference");
+    writer.Number(table->GetField<uint64_t>(Monster::VT_CO_OWNING_REFERENCE, 0));
+  }
+  if (table->CheckField(Monster::VT_VECTOR_OF_CO_OWNING_REFERENCES)) {
+    writer.Key("vector_of_co_owning_references");
+    auto vec = table->GetPointer<const flatbuffers::Vector<uint64_t> *>(Monster::VT_VECTOR_OF_CO_OWNING_REFERENCES);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.Number(vec->Get(i));
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_NON_OWNING_REFERENCE) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("non_owning_reference");
+    writer.Number(table->GetField<uint64_t>(Monster::VT_NON_OWNING_REFERENCE, 0));
+  }
+  if (table->CheckField(Monster::VT_VECTOR_OF_NON_OWNING_REFERENCES)) {
+    writer.Key("vector_of_non_owning_references");
+    auto vec = table->GetPointer<const flatbuffers::Vector<uint64_t> *>(Monster::VT_VECTOR_OF_NON_OWNING_REFERENCES);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.Number(vec->Get(i));
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_ANY_UNIQUE_TYPE) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("any_unique_type");
+    writer.Enum(table->GetField<uint8_t>(Monster::VT_ANY_UNIQUE_TYPE, 0), MyGame::Example::AnyUniqueAliasesJsonEnum());
+  }
+  if (table->CheckField(Monster::VT_ANY_UNIQUE)) {
+    writer.Key("any_unique");
+    if (!MyGame::Example::AnyUniqueAliasesToJson(table->GetPointer<const void *>(Monster::VT_ANY_UNIQUE),
+        static_cast<MyGame::Example::AnyUniqueAliases>(table->GetField<uint8_t>(Monster::VT_ANY_UNIQUE_TYPE, 0)),
+        writer)) {
+      return false;
+    }
+  }
+  if (table->CheckField(Monster::VT_ANY_AMBIGUOUS_TYPE) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("any_ambiguous_type");
+    writer.Enum(table->GetField<uint8_t>(Monster::VT_ANY_AMBIGUOUS_TYPE, 0), MyGame::Example::AnyAmbiguousAliasesJsonEnum());
+  }
+  if (table->CheckField(Monster::VT_ANY_AMBIGUOUS)) {
+    writer.Key("any_ambiguous");
+    if (!MyGame::Example::AnyAmbiguousAliasesToJson(table->GetPointer<const void *>(Monster::VT_ANY_AMBIGUOUS),
+        static_cast<MyGame::Example::AnyAmbiguousAliases>(table->GetField<uint8_t>(Monster::VT_ANY_AMBIGUOUS_TYPE, 0)),
+        writer)) {
+      return false;
+    }
+  }
+  if (table->CheckField(Monster::VT_VECTOR_OF_ENUMS)) {
+    writer.Key("vector_of_enums");
+    auto vec = table->GetPointer<const flatbuffers::Vector<uint8_t> *>(Monster::VT_VECTOR_OF_ENUMS);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.Enum(vec->Get(i), MyGame::Example::ColorJsonEnum());
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(Monster::VT_SIGNED_ENUM) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("signed_enum");
+    writer.Enum(table->GetField<int8_t>(Monster::VT_SIGNED_ENUM, -1), MyGame::Example::RaceJsonEnum());
+  }
+  if (table->CheckField(Monster::VT_TESTREQUIREDNESTEDFLATBUFFER)) {
+    writer.Key("testrequirednestedflatbuffer");
+    auto vec = table->GetPointer<const flatbuffers::Vector<uint8_t> *>(Monster::VT_TESTREQUIREDNESTEDFLATBUFFER);
+    if (!MyGame::Example::MonsterToJson(flatbuffers::GetRoot<MyGame::Example::Monster>(vec->data()), writer)) {
+      return false;
+    }
+  }
+  if (table->CheckField(Monster::VT_SCALAR_KEY_SORTED_TABLES)) {
+    writer.Key("scalar_key_sorted_tables");
+    auto vec = table->GetPointer<const flatbuffers::Vector<flatbuffers::Offset<MyGame::Example::Stat>> *>(Monster::VT_SCALAR_KEY_SORTED_TABLES);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      if (!MyGame::Example::StatToJson(vec->Get(i), writer)) return false;
+    }
+    writer.EndArray();
+  }
+  writer.EndObject();
+  return writer.ok();
+}
+
+inline bool MonsterFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<Monster> *_o) {
+  const MyGame::Example::Vec3 *pos = 0;
+  MyGame::Example::Vec3 pos__;
+  int16_t mana = 150;
+  int16_t hp = 100;
+  flatbuffers::Offset<flatbuffers::String> name = 0;
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> inventory = 0;
+  MyGame::Example::Color color = MyGame::Example::Color_Blue;
+  MyGame::Example::Any test_type = MyGame::Example::Any_NONE;
+  flatbuffers::Offset<void> test = 0;
+  size_t test__ = 0;
+  flatbuffers::Offset<flatbuffers::Vector<const MyGame::Example::Test *>> test4 = 0;
+  flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> testarrayofstring = 0;
+  flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<MyGame::Example::Monster>>> testarrayoftables = 0;
+  flatbuffers::Offset<MyGame::Example::Monster> enemy = 0;
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> testnestedflatbuffer = 0;
+  flatbuffers::Offset<MyGame::Example::Stat> testempty = 0;
+  bool testbool = false;
+  int32_t testhashs32_fnv1 = 0;
+  uint32_t testhashu32_fnv1 = 0;
+  int64_t testhashs64_fnv1 = 0;
+  uint64_t testhashu64_fnv1 = 0;
+  int32_t testhashs32_fnv1a = 0;
+  uint32_t testhashu32_fnv1a = 0;
+  int64_t testhashs64_fnv1a = 0;
+  uint64_t testhashu64_fnv1a = 0;
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> testarrayofbools = 0;
+  float testf = 3.14159f;
+  float testf2 = 3.0f;
+  float testf3 = 0.0f;
+  flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> testarrayofstring2 = 0;
+  flatbuffers::Offset<flatbuffers::Vector<const MyGame::Example::Ability *>> testarrayofsortedstruct = 0;
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> flex = 0;
+  flatbuffers::Offset<flatbuffers::Vector<const MyGame::Example::Test *>> test5 = 0;
+  flatbuffers::Offset<flatbuffers::Vector<int64_t>> vector_of_longs = 0;
+  flatbuffers::Offset<flatbuffers::Vector<double>> vector_of_doubles = 0;
+  flatbuffers::Offset<MyGame::InParentNamespace> parent_namespace_test = 0;
+  flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<MyGame::Example::Referrable>>> vector_of_referrables = 0;
+  uint64_t single_weak_reference = 0;
+  flatbuffers::Offset<flatbuffers::Vector<uint64_t>> vector_of_weak_references = 0;
+  flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<MyGame::Example::Referrable>>> vector_of_strong_referrables = 0;
+  uint64_t co_owning_reference = 0;
+  flatbuffers::Offset<flatbuffers::Vector<uint64_t>> vector_of_co_owning_references = 0;
+  uint64_t non_owning_reference = 0;
+  flatbuffers::Offset<flatbuffers::Vector<uint64_t>> vector_of_non_owning_references = 0;
+  MyGame::Example::AnyUniqueAliases any_unique_type = MyGame::Example::AnyUniqueAliases_NONE;
+  flatbuffers::Offset<void> any_unique = 0;
+  size_t any_unique__ = 0;
+  MyGame::Example::AnyAmbiguousAliases any_ambiguous_type = MyGame::Example::AnyAmbiguousAliases_NONE;
+  flatbuffers::Offset<void> any_ambiguous = 0;
+  size_t any_ambiguous__ = 0;
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> vector_of_enums = 0;
+  MyGame::Example::Race signed_enum = MyGame::Example::Race_None;
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> testrequirednestedflatbuffer = 0;
+  flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<MyGame::Example::Stat>>> scalar_key_sorted_tables = 0;
+  if (!_reader.StartObject()) return false;
+  while (_reader.NextField()) {
+    if (_reader.KeyIs("pos")) {
+      if (!MyGame::Example::Vec3FromJson(_reader, &pos__)) return false;
+      pos = &pos__;
+    } else if (_reader.KeyIs("mana")) {
+      int16_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      mana = _val;
+    } else if (_reader.KeyIs("hp")) {
+      int16_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      hp = _val;
+    } else if (_reader.KeyIs("name")) {
+      if (!_reader.String(_fbb, &name)) return false;
+    } else if (_reader.KeyIs("friendly")) {
+      if (!_reader.SkipValue()) return false;
+    } else if (_reader.KeyIs("inventory")) {
+      std::vector<uint8_t> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        uint8_t _val;
+        if (!_reader.Scalar(&_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      inventory = _fbb.CreateVector(_elems);
+    } else if (_reader.KeyIs("color")) {
+      uint8_t _val;
+      if (!_reader.Enum(MyGame::Example::ColorJsonEnum(), &_val)) return false;
+      color = static_cast<MyGame::Example::Color>(_val);
+    } else if (_reader.KeyIs("test_type")) {
+      uint8_t _val;
+      if (!_reader.Enum(MyGame::Example::AnyJsonEnum(), &_val)) return false;
+      test_type = static_cast<MyGame::Example::Any>(_val);
+    } else if (_reader.KeyIs("test")) {
+      test__ = _reader.Position();
+      if (!_reader.SkipValue()) return false;
+    } else if (_reader.KeyIs("test4")) {
+      std::vector<MyGame::Example::Test> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        MyGame::Example::Test _val;
+        if (!MyGame::Example::TestFromJson(_reader, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      test4 = _fbb.CreateVectorOfStructs(_elems);
+    } else if (_reader.KeyIs("testarrayofstring")) {
+      std::vector<flatbuffers::Offset<flatbuffers::String>> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        flatbuffers::Offset<flatbuffers::String> _val;
+        if (!_reader.String(_fbb, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      testarrayofstring = _fbb.CreateVector(_elems);
+    } else if (_reader.KeyIs("testarrayoftables")) {
+      std::vector<flatbuffers::Offset<MyGame::Example::Monster>> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        flatbuffers::Offset<MyGame::Example::Monster> _val;
+        if (!MyGame::Example::MonsterFromJson(_reader, _fbb, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      testarrayoftables = _fbb.CreateVectorOfSortedTables(&_elems);
+    } else if (_reader.KeyIs("enemy")) {
+      if (!MyGame::Example::MonsterFromJson(_reader, _fbb, &enemy)) return false;
+    } else if (_reader.KeyIs("testnestedflatbuffer")) {
+      if (_reader.Peek('[')) {
+        std::vector<uint8_t> _elems;
+        if (!_reader.StartArray()) return false;
+        while (_reader.NextElement()) {
+          uint8_t _val;
+          if (!_reader.Scalar(&_val)) return false;
+          _elems.push_back(_val);
+        }
+        if (!_reader.ok()) return false;
+        testnestedflatbuffer = _fbb.CreateVector(_elems);
+      } else {
+        flatbuffers::FlatBufferBuilder _nested;
+        flatbuffers::Offset<MyGame::Example::Monster> _root;
+        if (!MyGame::Example::MonsterFromJson(_reader, _nested, &_root)) return false;
+        _nested.Finish(_root);
+        _fbb.ForceVectorAlignment(_nested.GetSize(), sizeof(uint8_t),
+                                  _nested.GetBufferMinAlignment());
+        testnestedflatbuffer = _fbb.CreateVector(_nested.GetBufferPointer(),
+                                           _nested.GetSize());
+      }
+    } else if (_reader.KeyIs("testempty")) {
+      if (!MyGame::Example::StatFromJson(_reader, _fbb, &testempty)) return false;
+    } else if (_reader.KeyIs("testbool")) {
+      uint8_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      testbool = _val != 0;
+    } else if (_reader.KeyIs("testhashs32_fnv1")) {
+      int32_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1<uint32_t>, &_val)) return false;
+      testhashs32_fnv1 = _val;
+    } else if (_reader.KeyIs("testhashu32_fnv1")) {
+      uint32_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1<uint32_t>, &_val)) return false;
+      testhashu32_fnv1 = _val;
+    } else if (_reader.KeyIs("testhashs64_fnv1")) {
+      int64_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1<uint64_t>, &_val)) return false;
+      testhashs64_fnv1 = _val;
+    } else if (_reader.KeyIs("testhashu64_fnv1")) {
+      uint64_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1<uint64_t>, &_val)) return false;
+      testhashu64_fnv1 = _val;
+    } else if (_reader.KeyIs("testhashs32_fnv1a")) {
+      int32_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1a<uint32_t>, &_val)) return false;
+      testhashs32_fnv1a = _val;
+    } else if (_reader.KeyIs("testhashu32_fnv1a")) {
+      uint32_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1a<uint32_t>, &_val)) return false;
+      testhashu32_fnv1a = _val;
+    } else if (_reader.KeyIs("testhashs64_fnv1a")) {
+      int64_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1a<uint64_t>, &_val)) return false;
+      testhashs64_fnv1a = _val;
+    } else if (_reader.KeyIs("testhashu64_fnv1a")) {
+      uint64_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1a<uint64_t>, &_val)) return false;
+      testhashu64_fnv1a = _val;
+    } else if (_reader.KeyIs("testarrayofbools")) {
+      std::vector<uint8_t> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        uint8_t _val;
+        if (!_reader.Scalar(&_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      testarrayofbools = _fbb.CreateVector(_elems);
+    } else if (_reader.KeyIs("testf")) {
+      float _val;
+      if (!_reader.Scalar(&_val)) return false;
+      testf = _val;
+    } else if (_reader.KeyIs("testf2")) {
+      float _val;
+      if (!_reader.Scalar(&_val)) return false;
+      testf2 = _val;
+    } else if (_reader.KeyIs("testf3")) {
+      float _val;
+      if (!_reader.Scalar(&_val)) return false;
+      testf3 = _val;
+    } else if (_reader.KeyIs("testarrayofstring2")) {
+      std::vector<flatbuffers::Offset<flatbuffers::String>> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        flatbuffers::Offset<flatbuffers::String> _val;
+        if (!_reader.String(_fbb, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      testarrayofstring2 = _fbb.CreateVector(_elems);
+    } else if (_reader.KeyIs("testarrayofsortedstruct")) {
+      std::vector<MyGame::Example::Ability> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        MyGame::Example::Ability _val;
+        if (!MyGame::Example::AbilityFromJson(_reader, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      testarrayofsortedstruct = _fbb.CreateVectorOfSortedStructs(&_elems);
+    } else if (_reader.KeyIs("flex")) {
+      if (!_reader.FlexBuffer(_fbb, &flex)) return false;
+    } else if (_reader.KeyIs("test5")) {
+      std::vector<MyGame::Example::Test> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        MyGame::Example::Test _val;
+        if (!MyGame::Example::TestFromJson(_reader, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      test5 = _fbb.CreateVectorOfStructs(_elems);
+    } else if (_reader.KeyIs("vector_of_longs")) {
+      std::vector<int64_t> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        int64_t _val;
+        if (!_reader.Scalar(&_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      vector_of_longs = _fbb.CreateVector(_elems);
+    } else if (_reader.KeyIs("vector_of_doubles")) {
+      std::vector<double> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        double _val;
+        if (!_reader.Scalar(&_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      vector_of_doubles = _fbb.CreateVector(_elems);
+    } else if (_reader.KeyIs("parent_namespace_test")) {
+      if (!MyGame::InParentNamespaceFromJson(_reader, _fbb, &parent_namespace_test)) return false;
+    } else if (_reader.KeyIs("vector_of_referrables")) {
+      std::vector<flatbuffers::Offset<MyGame::Example::Referrable>> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        flatbuffers::Offset<MyGame::Example::Referrable> _val;
+        if (!MyGame::Example::ReferrableFromJson(_reader, _fbb, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      vector_of_referrables = _fbb.CreateVectorOfSortedTables(&_elems);
+    } else if (_reader.KeyIs("single_weak_reference")) {
+      uint64_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1a<uint64_t>, &_val)) return false;
+      single_weak_reference = _val;
+    } else if (_reader.KeyIs("vector_of_weak_references")) {
+      std::vector<uint64_t> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        uint64_t _val;
+        if (!_reader.Hashed(flatbuffers::HashFnv1a<uint64_t>, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      vector_of_weak_references = _fbb.CreateVector(_elems);
+    } else if (_reader.KeyIs("vector_of_strong_referrables")) {
+      std::vector<flatbuffers::Offset<MyGame::Example::Referrable>> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        flatbuffers::Offset<MyGame::Example::Referrable> _val;
+        if (!MyGame::Example::ReferrableFromJson(_reader, _fbb, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      vector_of_strong_referrables = _fbb.CreateVectorOfSortedTables(&_elems);
+    } else if (_reader.KeyIs("co_owning_reference")) {
+      uint64_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1a<uint64_t>, &_val)) return false;
+      co_owning_reference = _val;
+    } else if (_reader.KeyIs("vector_of_co_owning_references")) {
+      std::vector<uint64_t> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        uint64_t _val;
+        if (!_reader.Hashed(flatbuffers::HashFnv1a<uint64_t>, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      vector_of_co_owning_references = _fbb.CreateVector(_elems);
+    } else if (_reader.KeyIs("non_owning_reference")) {
+      uint64_t _val;
+      if (!_reader.Hashed(flatbuffers::HashFnv1a<uint64_t>, &_val)) return false;
+      non_owning_reference = _val;
+    } else if (_reader.KeyIs("vector_of_non_owning_references")) {
+      std::vector<uint64_t> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        uint64_t _val;
+        if (!_reader.Hashed(flatbuffers::HashFnv1a<uint64_t>, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      vector_of_non_owning_references = _fbb.CreateVector(_elems);
+    } else if (_reader.KeyIs("any_unique_type")) {
+      uint8_t _val;
+      if (!_reader.Enum(MyGame::Example::AnyUniqueAliasesJsonEnum(), &_val)) return false;
+      any_unique_type = static_cast<MyGame::Example::AnyUniqueAliases>(_val);
+    } else if (_reader.KeyIs("any_unique")) {
+      any_unique__ = _reader.Position();
+      if (!_reader.SkipValue()) return false;
+    } else if (_reader.KeyIs("any_ambiguous_type")) {
+      uint8_t _val;
+      if (!_reader.Enum(MyGame::Example::AnyAmbiguousAliasesJsonEnum(), &_val)) return false;
+      any_ambiguous_type = static_cast<MyGame::Example::AnyAmbiguousAliases>(_val);
+    } else if (_reader.KeyIs("any_ambiguous")) {
+      any_ambiguous__ = _reader.Position();
+      if (!_reader.SkipValue()) return false;
+    } else if (_reader.KeyIs("vector_of_enums")) {
+      std::vector<uint8_t> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        uint8_t _val;
+        if (!_reader.Enum(MyGame::Example::ColorJsonEnum(), &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      vector_of_enums = _fbb.CreateVector(_elems);
+    } else if (_reader.KeyIs("signed_enum")) {
+      int8_t _val;
+      if (!_reader.Enum(MyGame::Example::RaceJsonEnum(), &_val)) return false;
+      signed_enum = static_cast<MyGame::Example::Race>(_val);
+    } else if (_reader.KeyIs("testrequirednestedflatbuffer")) {
+      if (_reader.Peek('[')) {
+        std::vector<uint8_t> _elems;
+        if (!_reader.StartArray()) return false;
+        while (_reader.NextElement()) {
+          uint8_t _val;
+          if (!_reader.Scalar(&_val)) return false;
+          _elems.push_back(_val);
+        }
+        if (!_reader.ok()) return false;
+        testrequirednestedflatbuffer = _fbb.CreateVector(_elems);
+      } else {
+        flatbuffers::FlatBufferBuilder _nested;
+        flatbuffers::Offset<MyGame::Example::Monster> _root;
+        if (!MyGame::Example::MonsterFromJson(_reader, _nested, &_root)) return false;
+        _nested.Finish(_root);
+        _fbb.ForceVectorAlignment(_nested.GetSize(), sizeof(uint8_t),
+                                  _nested.GetBufferMinAlignment());
+        testrequirednestedflatbuffer = _fbb.CreateVector(_nested.GetBufferPointer(),
+                                           _nested.GetSize());
+      }
+    } else if (_reader.KeyIs("scalar_key_sorted_tables")) {
+      std::vector<flatbuffers::Offset<MyGame::Example::Stat>> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        flatbuffers::Offset<MyGame::Example::Stat> _val;
+        if (!MyGame::Example::StatFromJson(_reader, _fbb, &_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      scalar_key_sorted_tables = _fbb.CreateVectorOfSortedTables(&_elems);
+    } else if (!_reader.UnknownField()) {
+      return false;
+    }
+  }
+  if (!_reader.ok()) return false;
+  const auto _end = _reader.Position();
+  if (test__) {
+    _reader.Seek(test__);
+    if (!MyGame::Example::AnyFromJson(_reader, _fbb, test_type, &test)) {
+      return false;
+    }
+  }
+  if (any_unique__) {
+    _reader.Seek(any_unique__);
+    if (!MyGame::Example::AnyUniqueAliasesFromJson(_reader, _fbb, any_unique_type, &any_unique)) {
+      return false;
+    }
+  }
+  if (any_ambiguous__) {
+    _reader.Seek(any_ambiguous__);
+    if (!MyGame::Example::AnyAmbiguousAliasesFromJson(_reader, _fbb, any_ambiguous_type, &any_ambiguous)) {
+      return false;
+    }
+  }
+  _reader.Seek(_end);
+  if (name.IsNull()) {
+    return _reader.Error("required field is missing: name");
+  }
+  *_o = CreateMonster(
+      _fbb,
+      pos,
+      mana,
+      hp,
+      name,
+      inventory,
+      color,
+      test_type,
+      test,
+      test4,
+      testarrayofstring,
+      testarrayoftables,
+      enemy,
+      testnestedflatbuffer,
+      testempty,
+      testbool,
+      testhashs32_fnv1,
+      testhashu32_fnv1,
+      testhashs64_fnv1,
+      testhashu64_fnv1,
+      testhashs32_fnv1a,
+      testhashu32_fnv1a,
+      testhashs64_fnv1a,
+      testhashu64_fnv1a,
+      testarrayofbools,
+      testf,
+      testf2,
+      testf3,
+      testarrayofstring2,
+      testarrayofsortedstruct,
+      flex,
+      test5,
+      vector_of_longs,
+      vector_of_doubles,
+      parent_namespace_test,
+      vector_of_referrables,
+      single_weak_reference,
+      vector_of_weak_references,
+      vector_of_strong_referrables,
+      co_owning_reference,
+      vector_of_co_owning_references,
+      non_owning_reference,
+      vector_of_non_owning_references,
+      any_unique_type,
+      any_unique,
+      any_ambiguous_type,
+      any_ambiguous,
+      vector_of_enums,
+      signed_enum,
+      testrequirednestedflatbuffer,
+      scalar_key_sorted_tables);
+  return true;
+}
+
+inline bool TypeAliasesToJson(const TypeAliases *obj, flatbuffers::JsonWriter &writer) {
+  auto table = reinterpret_cast<const flatbuffers::Table *>(obj);
+  writer.StartObject();
+  if (table->CheckField(TypeAliases::VT_I8) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("i8");
+    writer.Number(table->GetField<int8_t>(TypeAliases::VT_I8, 0));
+  }
+  if (table->CheckField(TypeAliases::VT_U8) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("u8");
+    writer.Number(table->GetField<uint8_t>(TypeAliases::VT_U8, 0));
+  }
+  if (table->CheckField(TypeAliases::VT_I16) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("i16");
+    writer.Number(table->GetField<int16_t>(TypeAliases::VT_I16, 0));
+  }
+  if (table->CheckField(TypeAliases::VT_U16) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("u16");
+    writer.Number(table->GetField<uint16_t>(TypeAliases::VT_U16, 0));
+  }
+  if (table->CheckField(TypeAliases::VT_I32) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("i32");
+    writer.Number(table->GetField<int32_t>(TypeAliases::VT_I32, 0));
+  }
+  if (table->CheckField(TypeAliases::VT_U32) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("u32");
+    writer.Number(table->GetField<uint32_t>(TypeAliases::VT_U32, 0));
+  }
+  if (table->CheckField(TypeAliases::VT_I64) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("i64");
+    writer.Number(table->GetField<int64_t>(TypeAliases::VT_I64, 0));
+  }
+  if (table->CheckField(TypeAliases::VT_U64) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("u64");
+    writer.Number(table->GetField<uint64_t>(TypeAliases::VT_U64, 0));
+  }
+  if (table->CheckField(TypeAliases::VT_F32) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("f32");
+    writer.Number(table->GetField<float>(TypeAliases::VT_F32, 0.0f));
+  }
+  if (table->CheckField(TypeAliases::VT_F64) ||
+      writer.options().output_default_scalars_in_json) {
+    writer.Key("f64");
+    writer.Number(table->GetField<double>(TypeAliases::VT_F64, 0.0));
+  }
+  if (table->CheckField(TypeAliases::VT_V8)) {
+    writer.Key("v8");
+    auto vec = table->GetPointer<const flatbuffers::Vector<int8_t> *>(TypeAliases::VT_V8);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.Number(vec->Get(i));
+    }
+    writer.EndArray();
+  }
+  if (table->CheckField(TypeAliases::VT_VF64)) {
+    writer.Key("vf64");
+    auto vec = table->GetPointer<const flatbuffers::Vector<double> *>(TypeAliases::VT_VF64);
+    writer.StartArray();
+    for (flatbuffers::uoffset_t i = 0; i < vec->size(); i++) {
+      writer.Element();
+      writer.Number(vec->Get(i));
+    }
+    writer.EndArray();
+  }
+  writer.EndObject();
+  return writer.ok();
+}
+
+inline bool TypeAliasesFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, flatbuffers::Offset<TypeAliases> *_o) {
+  int8_t i8 = 0;
+  uint8_t u8 = 0;
+  int16_t i16 = 0;
+  uint16_t u16 = 0;
+  int32_t i32 = 0;
+  uint32_t u32 = 0;
+  int64_t i64 = 0;
+  uint64_t u64 = 0;
+  float f32 = 0.0f;
+  double f64 = 0.0;
+  flatbuffers::Offset<flatbuffers::Vector<int8_t>> v8 = 0;
+  flatbuffers::Offset<flatbuffers::Vector<double>> vf64 = 0;
+  if (!_reader.StartObject()) return false;
+  while (_reader.NextField()) {
+    if (_reader.KeyIs("i8")) {
+      int8_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      i8 = _val;
+    } else if (_reader.KeyIs("u8")) {
+      uint8_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      u8 = _val;
+    } else if (_reader.KeyIs("i16")) {
+      int16_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      i16 = _val;
+    } else if (_reader.KeyIs("u16")) {
+      uint16_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      u16 = _val;
+    } else if (_reader.KeyIs("i32")) {
+      int32_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      i32 = _val;
+    } else if (_reader.KeyIs("u32")) {
+      uint32_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      u32 = _val;
+    } else if (_reader.KeyIs("i64")) {
+      int64_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      i64 = _val;
+    } else if (_reader.KeyIs("u64")) {
+      uint64_t _val;
+      if (!_reader.Scalar(&_val)) return false;
+      u64 = _val;
+    } else if (_reader.KeyIs("f32")) {
+      float _val;
+      if (!_reader.Scalar(&_val)) return false;
+      f32 = _val;
+    } else if (_reader.KeyIs("f64")) {
+      double _val;
+      if (!_reader.Scalar(&_val)) return false;
+      f64 = _val;
+    } else if (_reader.KeyIs("v8")) {
+      std::vector<int8_t> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        int8_t _val;
+        if (!_reader.Scalar(&_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      v8 = _fbb.CreateVector(_elems);
+    } else if (_reader.KeyIs("vf64")) {
+      std::vector<double> _elems;
+      if (!_reader.StartArray()) return false;
+      while (_reader.NextElement()) {
+        double _val;
+        if (!_reader.Scalar(&_val)) return false;
+        _elems.push_back(_val);
+      }
+      if (!_reader.ok()) return false;
+      vf64 = _fbb.CreateVector(_elems);
+    } else if (!_reader.UnknownField()) {
+      return false;
+    }
+  }
+  if (!_reader.ok()) return false;
+  *_o = CreateTypeAliases(
+      _fbb,
+      i8,
+      u8,
+      i16,
+      u16,
+      i32,
+      u32,
+      i64,
+      u64,
+      f32,
+      f64,
+      v8,
+      vf64);
+  return true;
+}
+
+inline bool AnyToJson(const void *obj, Any type, flatbuffers::JsonWriter &writer) {
+  switch (type) {
+    case Any_Monster: {
+      auto ptr = reinterpret_cast<const MyGame::Example::Monster *>(obj);
+      return MyGame::Example::MonsterToJson(ptr, writer);
+    }
+    case Any_TestSimpleTableWithEnum: {
+      auto ptr = reinterpret_cast<const MyGame::Example::TestSimpleTableWithEnum *>(obj);
+      return MyGame::Example::TestSimpleTableWithEnumToJson(ptr, writer);
+    }
+    case Any_MyGame_Example2_Monster: {
+      auto ptr = reinterpret_cast<const MyGame::Example2::Monster *>(obj);
+      return MyGame::Example2::MonsterToJson(ptr, writer);
+    }
+    default: return false;
+  }
+}
+
+inline bool AnyFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, Any type, flatbuffers::Offset<void> *_o) {
+  switch (type) {
+    case Any_Monster: {
+      flatbuffers::Offset<MyGame::Example::Monster> ptr;
+      if (!MyGame::Example::MonsterFromJson(_reader, _fbb, &ptr)) return false;
+      *_o = ptr.Union();
+      return true;
+    }
+    case Any_TestSimpleTableWithEnum: {
+      flatbuffers::Offset<MyGame::Example::TestSimpleTableWithEnum> ptr;
+      if (!MyGame::Example::TestSimpleTableWithEnumFromJson(_reader, _fbb, &ptr)) return false;
+      *_o = ptr.Union();
+      return true;
+    }
+    case Any_MyGame_Example2_Monster: {
+      flatbuffers::Offset<MyGame::Example2::Monster> ptr;
+      if (!MyGame::Example2::MonsterFromJson(_reader, _fbb, &ptr)) return false;
+      *_o = ptr.Union();
+      return true;
+    }
+    default: return _reader.Error("unknown union type");
+  }
+}
+
+inline bool AnyUniqueAliasesToJson(const void *obj, AnyUniqueAliases type, flatbuffers::JsonWriter &writer) {
+  switch (type) {
+    case AnyUniqueAliases_M: {
+      auto ptr = reinterpret_cast<const MyGame::Example::Monster *>(obj);
+      return MyGame::Example::MonsterToJson(ptr, writer);
+    }
+    case AnyUniqueAliases_TS: {
+      auto ptr = reinterpret_cast<const MyGame::Example::TestSimpleTableWithEnum *>(obj);
+      return MyGame::Example::TestSimpleTableWithEnumToJson(ptr, writer);
+    }
+    case AnyUniqueAliases_M2: {
+      auto ptr = reinterpret_cast<const MyGame::Example2::Monster *>(obj);
+      return MyGame::Example2::MonsterToJson(ptr, writer);
+    }
+    default: return false;
+  }
+}
+
+inline bool AnyUniqueAliasesFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, AnyUniqueAliases type, flatbuffers::Offset<void> *_o) {
+  switch (type) {
+    case AnyUniqueAliases_M: {
+      flatbuffers::Offset<MyGame::Example::Monster> ptr;
+      if (!MyGame::Example::MonsterFromJson(_reader, _fbb, &ptr)) return false;
+      *_o = ptr.Union();
+      return true;
+    }
+    case AnyUniqueAliases_TS: {
+      flatbuffers::Offset<MyGame::Example::TestSimpleTableWithEnum> ptr;
+      if (!MyGame::Example::TestSimpleTableWithEnumFromJson(_reader, _fbb, &ptr)) return false;
+      *_o = ptr.Union();
+      return true;
+    }
+    case AnyUniqueAliases_M2: {
+      flatbuffers::Offset<MyGame::Example2::Monster> ptr;
+      if (!MyGame::Example2::MonsterFromJson(_reader, _fbb, &ptr)) return false;
+      *_o = ptr.Union();
+      return true;
+    }
+    default: return _reader.Error("unknown union type");
+  }
+}
+
+inline bool AnyAmbiguousAliasesToJson(const void *obj, AnyAmbiguousAliases type, flatbuffers::JsonWriter &writer) {
+  switch (type) {
+    case AnyAmbiguousAliases_M1: {
+      auto ptr = reinterpret_cast<const MyGame::Example::Monster *>(obj);
+      return MyGame::Example::MonsterToJson(ptr, writer);
+    }
+    case AnyAmbiguousAliases_M2: {
+      auto ptr = reinterpret_cast<const MyGame::Example::Monster *>(obj);
+      return MyGame::Example::MonsterToJson(ptr, writer);
+    }
+    case AnyAmbiguousAliases_M3: {
+      auto ptr = reinterpret_cast<const MyGame::Example::Monster *>(obj);
+      return MyGame::Example::MonsterToJson(ptr, writer);
+    }
+    default: return false;
+  }
+}
+
+inline bool AnyAmbiguousAliasesFromJson(flatbuffers::JsonReader &_reader, flatbuffers::FlatBufferBuilder &_fbb, AnyAmbiguousAliases type, flatbuffers::Offset<void> *_o) {
+  switch (type) {
+    case AnyAmbiguousAliases_M1: {
+      flatbuffers::Offset<MyGame::Example::Monster> ptr;
+      if (!MyGame::Example::MonsterFromJson(_reader, _fbb, &ptr)) return false;
+      *_o = ptr.Union();
+      return true;
+    }
+    case AnyAmbiguousAliases_M2: {
+      flatbuffers::Offset<MyGame::Example::Monster> ptr;
+      if (!MyGame::Example::MonsterFromJson(_reader, _fbb, &ptr)) return false;
+      *_o = ptr.Union();
+      return true;
+    }
+    case AnyAmbiguousAliases_M3: {
+      flatbuffers::Offset<MyGame::Example::Monster> ptr;
+      if (!MyGame::Example::MonsterFromJson(_reader, _fbb, &ptr)) return false;
+      *_o = ptr.Union();
+      return true;
+    }
+    default: return _reader.Error("unknown union type");
+  }
+}
+
 inline const MyGame::Example::Monster *GetMonster(const void *buf) {
   return flatbuffers::GetRoot<MyGame::Example::Monster>(buf);
 }
@@ -3695,6 +5334,24 @@ inline flatbuffers::unique_ptr<MyGame::Example::MonsterT> UnPackSizePrefixedMons
   return flatbuffers::unique_ptr<MyGame::Example::MonsterT>(GetSizePrefixedMonster(buf)->UnPack(res));
 }
 
+inline bool MonsterBufferToJson(
+    const void *buf, flatbuffers::JsonWriter &writer) {
+  auto ok = MonsterToJson(GetMonster(buf), writer);
+  return writer.Finish() && ok;
+}
+
+inline bool MonsterBufferFromJson(
+    flatbuffers::JsonReader &reader,
+    flatbuffers::FlatBufferBuilder &fbb) {
+  flatbuffers::Offset<MyGame::Example::Monster> root;
+  if (!MonsterFromJson(reader, fbb, &root) ||
+      !reader.Finish()) {
+    return false;
+  }
+  FinishMonsterBuffer(fbb, root);
+  return true;
+}
+
 }  // namespace Example
 }  // namespace MyGame
 
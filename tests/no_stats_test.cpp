@@ -0,0 +1,15 @@
+// The tests are built with FLATBUFFERS_VERIFIER_STATS and
+// FLATBUFFERS_BUILDER_STATS, which may only change what a Verifier or
+// FlatBufferBuilder does, not its layout: a program may mix code built with
+// and without them. Inline functions are shared between translation units, so
+// only the layout can be compared here.
+#undef FLATBUFFERS_VERIFIER_STATS
+#undef FLATBUFFERS_BUILDER_STATS
+
+#include "no_stats_test.h"
+
+#include "flatbuffers/flatbuffers.h"
+
+size_t NoStatsVerifierSize() { return sizeof(flatbuffers::Verifier); }
+
+size_t NoStatsBuilderSize() { return sizeof(flatbuffers::FlatBufferBuilder); }
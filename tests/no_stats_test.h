@@ -0,0 +1,11 @@
+#ifndef NO_STATS_TEST_H
+#define NO_STATS_TEST_H
+
+#include <cstddef>
+
+// Implemented in a translation unit that is built without the statistics
+// macros the rest of the tests use.
+size_t NoStatsVerifierSize();
+size_t NoStatsBuilderSize();
+
+#endif  // NO_STATS_TEST_H
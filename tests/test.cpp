@@ -13,14 +13,20 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <clocale>
 #include <cmath>
 #include <string>
 
 #include "flatbuffers/flatbuffers.h"
 #include "flatbuffers/idl.h"
+#include "flatbuffers/json.h"
+#include "flatbuffers/lazy_verifier.h"
 #include "flatbuffers/minireflect.h"
 #include "flatbuffers/registry.h"
+#include "flatbuffers/string_dictionary.h"
+#include "flatbuffers/thread_pool.h"
 #include "flatbuffers/util.h"
+#include "flatbuffers/verification_cache.h"
 
 // clang-format off
 #ifdef FLATBUFFERS_CPP98_STL
@@ -45,6 +51,7 @@
 #include "flatbuffers/flexbuffers.h"
 #include "monster_test_bfbs_generated.h"  // Generated using --bfbs-comments --bfbs-builtins --cpp --bfbs-gen-embed
 #include "native_type_test_generated.h"
+#include "no_stats_test.h"
 #include "test_assert.h"
 
   // clang-format off
@@ -592,6 +599,236 @@ void ObjectFlatBuffersTest(uint8_t *flatbuf) {
   TEST_EQ(tests[1].b(), 40);
 }
 
+// Records the size of every allocation a builder makes.
+class RecordingAllocator : public flatbuffers::DefaultAllocator {
+ public:
+  uint8_t *allocate(size_t size) FLATBUFFERS_OVERRIDE {
+    sizes.push_back(size);
+    return DefaultAllocator::allocate(size);
+  }
+
+  std::vector<size_t> sizes;
+};
+
+class RecordingGrowth : public flatbuffers::GrowthPolicy {
+ public:
+  size_t Grow(size_t reserved, size_t len) FLATBUFFERS_OVERRIDE {
+    calls.push_back(std::make_pair(reserved, len));
+    return 0;
+  }
+
+  std::vector<std::pair<size_t, size_t>> calls;
+};
+
+void BuilderGrowthTest(const uint8_t *flatbuf) {
+  std::string big(1000, 'x');
+  {
+    RecordingAllocator allocator;
+    flatbuffers::FixedGrowth fixed(256);
+    flatbuffers::FlatBufferBuilder fbb(64, &allocator);
+    fbb.SetGrowthPolicy(&fixed);
+    for (int i = 0; i < 4; i++) fbb.CreateString(big.c_str(), 100);
+    fbb.CreateString(big);
+    TEST_EQ(allocator.sizes.size(), 4U);
+    TEST_EQ(allocator.sizes[0], 64U);
+    TEST_EQ(allocator.sizes[1], 64U + 256U);
+    TEST_EQ(allocator.sizes[2], 64U + 2 * 256U);
+    // More than the increment is needed.
+    TEST_EQ(allocator.sizes[3], 64U + 2 * 256U + big.size());
+  }
+  {
+    RecordingAllocator allocator;
+    flatbuffers::GeometricGrowth doubling(2);
+    flatbuffers::FlatBufferBuilder fbb(64, &allocator);
+    fbb.SetGrowthPolicy(&doubling);
+    for (int i = 0; i < 2; i++) fbb.CreateString(big.c_str(), 40);
+    TEST_EQ(allocator.sizes.size(), 2U);
+    TEST_EQ(allocator.sizes[1], 128U);
+    // A factor of 1 adds nothing, the buffer grows by what is needed.
+    flatbuffers::GeometricGrowth exact(1);
+    TEST_EQ(exact.Grow(64, 40), 0U);
+  }
+  {
+    // A policy that adds nothing grows by exactly what is needed.
+    RecordingAllocator allocator;
+    RecordingGrowth growth;
+    flatbuffers::FlatBufferBuilder fbb(16, &allocator);
+    fbb.SetGrowthPolicy(&growth);
+    fbb.CreateString(big.c_str(), 96);
+    TEST_EQ(growth.calls.size(), 1U);
+    TEST_EQ(growth.calls[0].first, 16U);
+    TEST_EQ(allocator.sizes[1], 16U + growth.calls[0].second);
+    fbb.SetGrowthPolicy(nullptr);
+    fbb.CreateString(big.c_str(), 96);
+    TEST_EQ(growth.calls.size(), 1U);
+  }
+
+  // Reserving the packed size upper bound makes Pack() allocate once.
+  auto monster = UnPackMonster(flatbuf);
+  monster->enemy.reset(UnPackMonster(flatbuf).release());
+  monster->testarrayofstring.push_back(big);
+  auto bound = Monster::PackedSizeUpperBound(*monster);
+  RecordingAllocator allocator;
+  flatbuffers::FlatBufferBuilder fbb(1, &allocator);
+  fbb.Reserve(bound);
+  TEST_EQ(allocator.sizes.size(), 1U);
+  FinishMonsterBuffer(fbb, Monster::Pack(fbb, monster.get()));
+  TEST_EQ(allocator.sizes.size(), 1U);
+  TEST_EQ(fbb.GetSize() <= bound, true);
+  flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize());
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+  // Reserving less than is free already doesn't allocate.
+  fbb.Clear();
+  fbb.Reserve(bound / 2);
+  FinishMonsterBuffer(fbb, Monster::Pack(fbb, monster.get()));
+  TEST_EQ(allocator.sizes.size(), 1U);
+
+  // Unions of tables and strings.
+  MonsterT empty;
+  TEST_EQ(empty.test.PackedSizeUpperBound(), 0U);
+  flatbuffers::FlatBufferBuilder empty_fbb;
+  empty_fbb.Finish(Monster::Pack(empty_fbb, &empty));
+  TEST_EQ(empty_fbb.GetSize() <= Monster::PackedSizeUpperBound(empty), true);
+  empty.test.Set(TestSimpleTableWithEnumT());
+  TEST_EQ(empty.test.PackedSizeUpperBound(),
+          TestSimpleTableWithEnum::PackedSizeUpperBound(
+              *empty.test.AsTestSimpleTableWithEnum()));
+}
+
+static flatbuffers::Offset<Monster> CreateSegmentTestMonster(
+    flatbuffers::FlatBufferBuilder &fbb) {
+  std::vector<flatbuffers::Offset<Monster>> monsters;
+  for (int i = 0; i < 200; i++) {
+    auto name =
+        fbb.CreateSharedString("monster" + flatbuffers::NumToString(i % 50));
+    std::vector<uint8_t> inventory(static_cast<size_t>(i),
+                                   static_cast<uint8_t>(i));
+    Vec3 pos(1, 2, 3, 4, Color_Red, Test(5, 6));
+    monsters.push_back(CreateMonster(fbb, &pos, 100,
+                                     static_cast<int16_t>(i), name,
+                                     fbb.CreateVector(inventory)));
+  }
+  auto tables = fbb.CreateVector(monsters);
+  auto name = fbb.CreateString(std::string(1000, 'x'));
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_testarrayoftables(tables);
+  return mb.Finish();
+}
+
+void SegmentedBuilderTest() {
+  flatbuffers::FlatBufferBuilder contiguous;
+  FinishMonsterBuffer(contiguous, CreateSegmentTestMonster(contiguous));
+  std::vector<uint8_t> expected(
+      contiguous.GetBufferPointer(),
+      contiguous.GetBufferPointer() + contiguous.GetSize());
+
+  RecordingAllocator allocator;
+  flatbuffers::FlatBufferBuilder fbb(1024, &allocator);
+  fbb.SetSegmentSize(256);
+  for (int pass = 0; pass < 2; pass++) {
+    fbb.Clear();
+    FinishMonsterBuffer(fbb, CreateSegmentTestMonster(fbb));
+    TEST_EQ(fbb.GetSize(), expected.size());
+    auto segments = fbb.GetBufferSegments();
+    TEST_EQ(segments.size() > 10, true);
+    std::vector<uint8_t> joined;
+    for (auto it = segments.begin(); it != segments.end(); ++it) {
+      joined.insert(joined.end(), it->data(), it->data() + it->size());
+    }
+    TEST_EQ(joined == expected, true);
+    std::vector<uint8_t> copy(fbb.GetSize());
+    fbb.CopyBufferTo(copy.data());
+    TEST_EQ(copy == expected, true);
+  }
+  // Each segment was allocated once, and the first one is reused.
+  auto allocations = allocator.sizes.size();
+  TEST_EQ(allocations < 2 * fbb.GetBufferSegments().size(), true);
+
+  auto released = fbb.Release();
+  TEST_EQ(released.size(), expected.size());
+  TEST_EQ(memcmp(released.data(), expected.data(), expected.size()), 0);
+  flatbuffers::Verifier verifier(released.data(), released.size());
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+  auto monster = GetMonster(released.data());
+  TEST_EQ(monster->testarrayoftables()->size(), 200U);
+  TEST_EQ_STR(monster->testarrayoftables()->Get(123)->name()->c_str(),
+              "monster23");
+
+  // Without segments, a builder has just one.
+  auto single = contiguous.GetBufferSegments();
+  TEST_EQ(single.size(), 1U);
+  TEST_EQ(single[0].data() == contiguous.GetBufferPointer(), true);
+
+  // Until the first segment is full, objects being built can be read.
+  flatbuffers::FlatBufferBuilder unsealed;
+  unsealed.SetSegmentSize(256);
+  auto name = unsealed.CreateString("temporary");
+  TEST_EQ_STR(flatbuffers::GetTemporaryPointer(unsealed, name)->c_str(),
+              "temporary");
+}
+
+void BuilderStatsTest() {
+  // Statistics don't change the layout of the builder.
+  TEST_EQ(NoStatsBuilderSize(), sizeof(flatbuffers::FlatBufferBuilder));
+
+  flatbuffers::BuilderStats stats;
+  flatbuffers::FlatBufferBuilder fbb(64);
+  // clang-format off
+  #ifdef FLATBUFFERS_BUILDER_STATS
+    TEST_EQ(fbb.SetStats(&stats), true);
+  #else
+    TEST_EQ(fbb.SetStats(&stats), false);
+    return;
+  #endif
+  // clang-format on
+  FinishMonsterBuffer(fbb, CreateSegmentTestMonster(fbb));
+  // 200 tables with the same fields and the root. Only a few vtables differ,
+  // by the padding before the aligned Vec3 or the hp of 100 left out.
+  TEST_EQ(stats.vtables_written + stats.vtables_deduped, 201U);
+  TEST_EQ(stats.vtables_deduped > 190U, true);
+  TEST_EQ(stats.vtable_bytes_saved > stats.vtables_deduped * 4, true);
+  TEST_EQ(stats.shared_string_misses, 50U);
+  TEST_EQ(stats.shared_string_hits, 150U);
+  TEST_EQ(stats.shared_string_bytes_saved >= 150U * 12, true);
+  TEST_EQ(stats.padding_bytes > 0U, true);
+  TEST_EQ(stats.allocations, stats.reallocations + 1);
+  TEST_EQ(stats.bytes_copied > fbb.GetSize() / 2, true);
+  // The scratch holds the offsets of the vtables written so far.
+  TEST_EQ(stats.max_scratch_bytes >=
+              stats.vtables_written * sizeof(flatbuffers::uoffset_t),
+          true);
+
+  // Reserving up front leaves nothing to copy.
+  flatbuffers::BuilderStats reserved;
+  flatbuffers::FlatBufferBuilder reserved_fbb(64);
+  reserved_fbb.SetStats(&reserved);
+  reserved_fbb.Reserve(fbb.GetSize() + 1024);
+  FinishMonsterBuffer(reserved_fbb, CreateSegmentTestMonster(reserved_fbb));
+  TEST_EQ(reserved.allocations, 1U);
+  TEST_EQ(reserved.reallocations, 0U);
+  TEST_EQ(reserved.bytes_copied, 0U);
+
+  flatbuffers::BuilderStats total;
+  total.Merge(stats);
+  total.Merge(reserved);
+  TEST_EQ(total.vtables_deduped, 2 * stats.vtables_deduped);
+  TEST_EQ(total.allocations, stats.allocations + 1);
+  TEST_EQ(total.max_scratch_bytes, stats.max_scratch_bytes);
+  total.Reset();
+  TEST_EQ(total.vtables_deduped, 0U);
+
+  // Stats keep counting over buffers until they are unset.
+  auto deduped = stats.vtables_deduped;
+  fbb.Clear();
+  FinishMonsterBuffer(fbb, CreateSegmentTestMonster(fbb));
+  TEST_EQ(stats.vtables_deduped, 2 * deduped);
+  fbb.SetStats(nullptr);
+  fbb.Clear();
+  FinishMonsterBuffer(fbb, CreateSegmentTestMonster(fbb));
+  TEST_EQ(stats.vtables_deduped, 2 * deduped);
+}
+
 // Prefix a FlatBuffer with a size field.
 void SizePrefixedTest() {
   // Create size prefixed buffer.
@@ -1140,6 +1377,117 @@ void ReflectionTest(uint8_t *flatbuf, size_t length) {
           true);
 }
 
+void FlexBufferTranscodeTest() {
+  std::string schemafile;
+  std::string jsonfile;
+  TEST_EQ(flatbuffers::LoadFile((test_data_path + "monster_test.fbs").c_str(),
+                                false, &schemafile),
+          true);
+  TEST_EQ(flatbuffers::LoadFile(
+              (test_data_path + "monsterdata_test.golden").c_str(), false,
+              &jsonfile),
+          true);
+  auto include_test_path =
+      flatbuffers::ConCatPathFileName(test_data_path, "include_test");
+  const char *include_directories[] = { test_data_path.c_str(),
+                                        include_test_path.c_str(), nullptr };
+  flatbuffers::IDLOptions opts;
+  // For the flexbuffer and nested_flatbuffer attributes.
+  opts.binary_schema_builtins = true;
+  flatbuffers::Parser parser(opts);
+  TEST_EQ(parser.Parse(schemafile.c_str(), include_directories) &&
+              parser.Parse(jsonfile.c_str(), include_directories),
+          true);
+  std::string expected;
+  TEST_EQ(GenerateText(parser, parser.builder_.GetBufferPointer(), &expected),
+          true);
+  std::vector<uint8_t> flatbuf(
+      parser.builder_.GetBufferPointer(),
+      parser.builder_.GetBufferPointer() + parser.builder_.GetSize());
+  parser.Serialize();
+  std::vector<uint8_t> bfbs(
+      parser.builder_.GetBufferPointer(),
+      parser.builder_.GetBufferPointer() + parser.builder_.GetSize());
+  auto &schema = *reflection::GetSchema(bfbs.data());
+  auto &root_table = *schema.root_table();
+
+  // FlatBuffer to FlexBuffer and back.
+  flexbuffers::Builder flex;
+  flatbuffers::FlatBufferToFlexBuffer(schema, root_table, flatbuf.data(),
+                                      &flex);
+  auto map = flexbuffers::GetRoot(flex.GetBuffer()).AsMap();
+  TEST_EQ_STR(map["name"].AsString().c_str(), "MyMonster");
+  TEST_EQ(map["test_type"].AsUInt8(), Any_Monster);
+  TEST_EQ_STR(map["test"].AsMap()["name"].AsString().c_str(), "Fred");
+  TEST_EQ(map["pos"].AsMap()["test3"].AsMap()["b"].AsInt16(), 20);
+  TEST_EQ(map["inventory"].AsTypedVector()[9].AsUInt8(), 9);
+  TEST_EQ(map["flex"].AsInt64(), 1234);
+  TEST_EQ_STR(
+      map["testnestedflatbuffer"].AsMap()["name"].AsString().c_str(),
+      "NestedMonster");
+  flatbuffers::FlatBufferBuilder fbb;
+  std::string error;
+  TEST_EQ(flatbuffers::FlexBufferToFlatBuffer(
+              schema, root_table, flexbuffers::GetRoot(flex.GetBuffer()), &fbb,
+              &error),
+          true);
+  flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize());
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+  std::string text;
+  TEST_EQ(GenerateText(parser, fbb.GetBufferPointer(), &text), true);
+  TEST_EQ_STR(text.c_str(), expected.c_str());
+
+  // The FlexBuffer of the JSON, with enum and union type names, makes the
+  // same FlatBuffer as the JSON.
+  flatbuffers::Parser flex_parser;
+  flexbuffers::Builder json_flex;
+  TEST_EQ(flex_parser.ParseFlexBuffer(jsonfile.c_str(), nullptr, &json_flex),
+          true);
+  fbb.Clear();
+  TEST_EQ(flatbuffers::FlexBufferToFlatBuffer(
+              schema, root_table, flexbuffers::GetRoot(json_flex.GetBuffer()),
+              &fbb, &error),
+          true);
+  text.clear();
+  TEST_EQ(GenerateText(parser, fbb.GetBufferPointer(), &text), true);
+  TEST_EQ_STR(text.c_str(), expected.c_str());
+
+  // Errors say where the value is.
+  const char *errors[][2] = {
+    { "{ name: 'a', inventory: [1, 256] }",
+      "inventory[1]: value out of range: 256" },
+    { "{ hp: 1 }", "root: missing required field: name" },
+    { "{ name: 'a', color: 'Purple' }", "color: unknown enum value: Purple" },
+    { "{ name: 'a', pos: { x: 1, y: 2, z: 3 } }",
+      "pos.test1: missing struct field" },
+    { "{ name: 'a', test: { name: 'b' } }",
+      "test: missing union type: test_type" },
+    { "{ name: 'a', testarrayoftables: [{ name: 'b' },"
+      " { name: 'c', hp: 'x' }] }",
+      "testarrayoftables[1].hp: expecting an integer" },
+    { "{ name: 'a', unknown: 1 }", "root: unknown field: unknown" },
+  };
+  for (size_t i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
+    flexbuffers::Builder bad;
+    TEST_EQ(flex_parser.ParseFlexBuffer(errors[i][0], nullptr, &bad), true);
+    fbb.Clear();
+    TEST_EQ(flatbuffers::FlexBufferToFlatBuffer(
+                schema, root_table, flexbuffers::GetRoot(bad.GetBuffer()),
+                &fbb, &error),
+            false);
+    TEST_EQ_STR(error.c_str(), errors[i][1]);
+  }
+  flexbuffers::Builder unknown;
+  TEST_EQ(flex_parser.ParseFlexBuffer("{ name: 'a', unknown: 1 }", nullptr,
+                                      &unknown),
+          true);
+  fbb.Clear();
+  TEST_EQ(flatbuffers::FlexBufferToFlatBuffer(
+              schema, root_table, flexbuffers::GetRoot(unknown.GetBuffer()),
+              &fbb, &error, true),
+          true);
+}
+
 void MiniReflectFlatBuffersTest(uint8_t *flatbuf) {
   auto s =
       flatbuffers::FlatBufferToString(flatbuf, Monster::MiniReflectTypeTable());
@@ -1185,6 +1533,522 @@ void MiniReflectFlatBuffersTest(uint8_t *flatbuf) {
               "16, b: 32 } }");
 }
 
+void MiniReflectVerifyAndCopyTest(const uint8_t *flatbuf, size_t length) {
+  auto type_table = Monster::MiniReflectTypeTable();
+  TEST_EQ(flatbuffers::VerifyFlatBuffer(flatbuf, length, type_table), true);
+
+  // Checked iteration visits the same as unchecked iteration.
+  flatbuffers::ToStringVisitor visitor(" ", false, "");
+  TEST_EQ(flatbuffers::VerifyAndIterateFlatBuffer(flatbuf, length, type_table,
+                                                  &visitor),
+          true);
+  auto expected = flatbuffers::FlatBufferToString(flatbuf, type_table);
+  TEST_EQ_STR(visitor.s.c_str(), expected.c_str());
+
+  // Damaged buffers are rejected without reading outside of them. This
+  // build asserts on verification failures, so only check this without.
+  // clang-format off
+  #ifndef FLATBUFFERS_DEBUG_VERIFICATION_FAILURE
+  // Truncation is only noticed once it cuts into data reachable from the
+  // root, the same as by the generated verifier. Lengths are kept aligned, as
+  // the generated verifier also checks the padded size of the buffer when
+  // FLATBUFFERS_TRACK_VERIFIER_BUFFER_SIZE is defined.
+  for (size_t len = 0; len < length; len += 8) {
+    std::vector<uint8_t> truncated(flatbuf, flatbuf + len);
+    flatbuffers::Verifier verifier(truncated.data(), truncated.size());
+    TEST_EQ(flatbuffers::VerifyFlatBuffer(truncated.data(), truncated.size(),
+                                          type_table),
+            VerifyMonsterBuffer(verifier));
+  }
+  // Whether a damaged buffer passes depends on where the damage is, the
+  // point is that checking it is safe.
+  std::vector<uint8_t> damaged(flatbuf, flatbuf + length);
+  for (size_t i = 0; i < length; i++) {
+    damaged[i] ^= 0x80;
+    flatbuffers::FlatBufferBuilder fbb;
+    flatbuffers::VerifyAndCopyFlatBuffer(damaged.data(), damaged.size(),
+                                         type_table, fbb);
+    damaged[i] = flatbuf[i];
+  }
+  #endif
+  // clang-format on
+
+  // A copy holds the same data, and is a valid buffer.
+  flatbuffers::FlatBufferBuilder fbb;
+  TEST_EQ(flatbuffers::VerifyAndCopyFlatBuffer(flatbuf, length, type_table,
+                                               fbb, MonsterIdentifier()),
+          true);
+  flatbuffers::Verifier copy_verifier(fbb.GetBufferPointer(), fbb.GetSize());
+  TEST_EQ(VerifyMonsterBuffer(copy_verifier), true);
+  auto copy = flatbuffers::FlatBufferToString(fbb.GetBufferPointer(),
+                                              type_table);
+  TEST_EQ_STR(copy.c_str(), expected.c_str());
+  TEST_EQ(fbb.GetSize() <= length, true);
+
+  // Sharing strings makes it smaller still.
+  flatbuffers::FlatBufferBuilder shared_fbb;
+  flatbuffers::BuilderVisitor builder_visitor(shared_fbb, true);
+  flatbuffers::IterateFlatBuffer(flatbuf, type_table, &builder_visitor);
+  TEST_EQ(builder_visitor.ok(), true);
+  shared_fbb.Finish(builder_visitor.root(), MonsterIdentifier());
+  TEST_EQ(shared_fbb.GetSize() < fbb.GetSize(), true);
+  copy = flatbuffers::FlatBufferToString(shared_fbb.GetBufferPointer(),
+                                         type_table);
+  TEST_EQ_STR(copy.c_str(), expected.c_str());
+
+  // Structs and strings in unions, and union vectors.
+  flatbuffers::FlatBufferBuilder movie_fbb;
+  std::vector<uint8_t> types;
+  types.push_back(static_cast<uint8_t>(Character_Belle));
+  types.push_back(static_cast<uint8_t>(Character_MuLan));
+  types.push_back(static_cast<uint8_t>(Character_Other));
+  std::vector<flatbuffers::Offset<void>> characters;
+  characters.push_back(movie_fbb.CreateStruct(BookReader(7)).Union());
+  characters.push_back(CreateAttacker(movie_fbb, 5).Union());
+  characters.push_back(movie_fbb.CreateString("Other").Union());
+  FinishMovieBuffer(
+      movie_fbb,
+      CreateMovie(movie_fbb, Character_Rapunzel,
+                  movie_fbb.CreateStruct(Rapunzel(6)).Union(),
+                  movie_fbb.CreateVector(types),
+                  movie_fbb.CreateVector(characters)));
+  auto movie_table = MovieTypeTable();
+  flatbuffers::FlatBufferBuilder movie_copy;
+  TEST_EQ(flatbuffers::VerifyAndCopyFlatBuffer(movie_fbb.GetBufferPointer(),
+                                               movie_fbb.GetSize(),
+                                               movie_table, movie_copy),
+          true);
+  flatbuffers::Verifier movie_verifier(movie_copy.GetBufferPointer(),
+                                       movie_copy.GetSize());
+  TEST_EQ(movie_verifier.VerifyBuffer<Movie>(nullptr), true);
+  TEST_EQ_STR(flatbuffers::FlatBufferToString(movie_copy.GetBufferPointer(),
+                                              movie_table)
+                  .c_str(),
+              flatbuffers::FlatBufferToString(movie_fbb.GetBufferPointer(),
+                                              movie_table)
+                  .c_str());
+
+  // clang-format off
+  #ifndef FLATBUFFERS_DEBUG_VERIFICATION_FAILURE
+  // Union structs are copied as soon as they are visited, so their offsets
+  // must be checked first.
+  const auto movie_buf = movie_fbb.GetBufferPointer();
+  const auto movie_len = movie_fbb.GetSize();
+  auto movie = GetMovie(movie_buf);
+  std::vector<size_t> union_offsets;
+  auto movie_root = reinterpret_cast<const flatbuffers::Table *>(movie);
+  union_offsets.push_back(static_cast<size_t>(
+      movie_root->GetAddressOf(Movie::VT_MAIN_CHARACTER) - movie_buf));
+  for (flatbuffers::uoffset_t i = 0; i < movie->characters()->size(); i++) {
+    union_offsets.push_back(static_cast<size_t>(
+        movie->characters()->Data() + i * sizeof(flatbuffers::uoffset_t) -
+        movie_buf));
+  }
+  for (size_t i = 0; i < union_offsets.size(); i++) {
+    std::vector<uint8_t> corrupt(movie_buf, movie_buf + movie_len);
+    flatbuffers::WriteScalar<flatbuffers::uoffset_t>(
+        corrupt.data() + union_offsets[i], 0x10000000);
+    flatbuffers::FlatBufferBuilder corrupt_copy;
+    TEST_EQ(flatbuffers::VerifyAndCopyFlatBuffer(corrupt.data(),
+                                                 corrupt.size(), movie_table,
+                                                 corrupt_copy),
+            false);
+  }
+  // Cutting into the union structs is noticed too.
+  for (size_t len = 0; len < movie_len; len++) {
+    std::vector<uint8_t> truncated(movie_buf, movie_buf + len);
+    flatbuffers::FlatBufferBuilder truncated_copy;
+    TEST_EQ(flatbuffers::VerifyAndCopyFlatBuffer(truncated.data(),
+                                                 truncated.size(), movie_table,
+                                                 truncated_copy),
+            false);
+  }
+  #endif
+  // clang-format on
+}
+
+void VerifierStatsTest(const uint8_t *flatbuf, size_t length) {
+  // Statistics don't change the layout of the Verifier.
+  TEST_EQ(NoStatsVerifierSize(), sizeof(flatbuffers::Verifier));
+
+  flatbuffers::Verifier verifier(flatbuf, length);
+  flatbuffers::VerifierStats stats;
+  if (!verifier.SetStats(&stats)) return;  // Compiled out.
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+  TEST_EQ(stats.failed, false);
+  // The root, test, 3 in testarrayoftables, 1 in scalar_key_sorted_tables.
+  TEST_EQ(stats.tables, 6U);
+  TEST_EQ(stats.max_depth, 2U);
+  TEST_EQ(stats.strings, 12U);
+  TEST_EQ(stats.vectors > 5U, true);
+  TEST_EQ(stats.bytes_checked > 0U, true);
+
+  // Reusing the stats starts over.
+  flatbuffers::Verifier verifier2(flatbuf, length);
+  verifier2.SetStats(&stats);
+  TEST_EQ(VerifyMonsterBuffer(verifier2), true);
+  TEST_EQ(stats.tables, 6U);
+
+  // clang-format off
+  #ifndef FLATBUFFERS_DEBUG_VERIFICATION_FAILURE
+    // Break the terminators of strings in a union and a vector of tables.
+    auto type_table = Monster::MiniReflectTypeTable();
+    std::vector<uint8_t> copy(flatbuf, flatbuf + length);
+    auto monster = GetMonster(copy.data());
+    auto test_name = monster->test_as_Monster()->name();
+    auto barney = monster->testarrayoftables()->Get(0)->name();
+    const uint8_t *ends[] = {
+      reinterpret_cast<const uint8_t *>(test_name->c_str() + test_name->size()),
+      reinterpret_cast<const uint8_t *>(barney->c_str() + barney->size())
+    };
+    const char *paths[] = { "test.name", "testarrayoftables.name" };
+    for (int i = 0; i < 2; i++) {
+      auto end = static_cast<size_t>(ends[i] - copy.data());
+      copy[end] = 'x';
+      flatbuffers::Verifier bad_verifier(copy.data(), copy.size());
+      bad_verifier.SetStats(&stats);
+      TEST_EQ(VerifyMonsterBuffer(bad_verifier), false);
+      TEST_EQ(stats.failed, true);
+      TEST_EQ(stats.failure_offset, end);
+      TEST_EQ(stats.failure_path.size(), 2U);
+      TEST_EQ_STR(flatbuffers::VerifierFailurePath(copy.data(), copy.size(),
+                                                   type_table, stats)
+                      .c_str(),
+                  paths[i]);
+      copy[end] = 0;
+    }
+  #endif
+  // clang-format on
+}
+
+void ParallelVerifierTest() {
+  // clang-format off
+  #if FLATBUFFERS_HAS_THREADS
+  // clang-format on
+  // A vector of tables that themselves contain vectors of tables.
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<flatbuffers::Offset<Monster>> monsters;
+  for (int i = 0; i < 1000; i++) {
+    std::vector<flatbuffers::Offset<Monster>> children;
+    if (i % 10 == 0) {
+      for (int j = 0; j < 20; j++) {
+        children.push_back(CreateMonster(fbb, nullptr, 0, 0,
+                                         fbb.CreateString("c")));
+      }
+    }
+    auto name = fbb.CreateString("m" + flatbuffers::NumToString(i));
+    auto tables = fbb.CreateVector(children);
+    MonsterBuilder mb(fbb);
+    mb.add_name(name);
+    mb.add_hp(static_cast<int16_t>(i));
+    mb.add_testarrayoftables(tables);
+    monsters.push_back(mb.Finish());
+  }
+  auto name = fbb.CreateString("root");
+  auto tables = fbb.CreateVector(monsters);
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_testarrayoftables(tables);
+  FinishMonsterBuffer(fbb, mb.Finish());
+  auto buf = fbb.GetBufferPointer();
+  auto size = fbb.GetSize();
+  const flatbuffers::uoffset_t num_tables = 1 + 1000 + 100 * 20;
+
+  flatbuffers::VerifierStats serial_stats;
+  flatbuffers::Verifier serial(buf, size);
+  auto has_stats = serial.SetStats(&serial_stats);
+  TEST_EQ(VerifyMonsterBuffer(serial), true);
+
+  // Chunks of the outer vector go to the threads, the inner vectors are
+  // below the threshold.
+  flatbuffers::ThreadPool pool(4);
+  TEST_EQ(pool.Concurrency(), 4);
+  flatbuffers::VerifierStats stats;
+  flatbuffers::Verifier verifier(buf, size);
+  verifier.SetStats(&stats);
+  verifier.SetParallel(&pool, 100);
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+  if (has_stats) {
+    TEST_EQ(stats.tables, num_tables);
+    TEST_EQ(stats.tables, serial_stats.tables);
+    TEST_EQ(stats.vectors, serial_stats.vectors);
+    TEST_EQ(stats.strings, serial_stats.strings);
+    TEST_EQ(stats.bytes_checked, serial_stats.bytes_checked);
+    TEST_EQ(stats.max_depth, serial_stats.max_depth);
+  }
+  // clang-format off
+  #ifdef FLATBUFFERS_TRACK_VERIFIER_BUFFER_SIZE
+    TEST_EQ(verifier.GetComputedSize(), serial.GetComputedSize());
+  #endif
+  // clang-format on
+
+  // The table budget is shared by the chunks.
+  flatbuffers::Verifier limited(buf, size, 64, num_tables);
+  limited.SetParallel(&pool, 100);
+  TEST_EQ(VerifyMonsterBuffer(limited), true);
+
+  // clang-format off
+  #ifndef FLATBUFFERS_DEBUG_VERIFICATION_FAILURE
+    flatbuffers::Verifier over_limit(buf, size, 64, num_tables - 1);
+    over_limit.SetParallel(&pool, 100);
+    TEST_EQ(VerifyMonsterBuffer(over_limit), false);
+    flatbuffers::Verifier too_deep(buf, size, 2);
+    too_deep.SetParallel(&pool, 100);
+    TEST_EQ(VerifyMonsterBuffer(too_deep), false);
+
+    // A broken table is found, and reported like the serial verifier does.
+    std::vector<uint8_t> copy(buf, buf + size);
+    auto broken = GetMonster(copy.data())->testarrayoftables()->Get(777);
+    auto end = static_cast<size_t>(
+        reinterpret_cast<const uint8_t *>(broken->name()->c_str()) +
+        broken->name()->size() - copy.data());
+    copy[end] = 'x';
+    flatbuffers::Verifier serial_bad(copy.data(), copy.size());
+    serial_bad.SetStats(&serial_stats);
+    TEST_EQ(VerifyMonsterBuffer(serial_bad), false);
+    flatbuffers::Verifier parallel_bad(copy.data(), copy.size());
+    parallel_bad.SetStats(&stats);
+    parallel_bad.SetParallel(&pool, 100);
+    TEST_EQ(VerifyMonsterBuffer(parallel_bad), false);
+    if (has_stats) {
+      TEST_EQ(stats.failure_offset, end);
+      TEST_EQ(stats.failure_offset, serial_stats.failure_offset);
+      TEST_EQ_STR(flatbuffers::VerifierFailurePath(
+                      copy.data(), copy.size(), Monster::MiniReflectTypeTable(),
+                      stats)
+                      .c_str(),
+                  "testarrayoftables.name");
+    }
+  #endif
+  #endif  // FLATBUFFERS_HAS_THREADS
+  // clang-format on
+}
+
+void LazyVerifierTest(const uint8_t *flatbuf, size_t length) {
+  flatbuffers::LazyVerifier verifier(flatbuf, length);
+  auto monster = verifier.GetRoot<Monster>(MonsterIdentifier());
+  TEST_NOTNULL(monster.get());
+  TEST_EQ(monster.GetField<int16_t>(Monster::VT_HP, 100), 80);
+  TEST_EQ(monster.GetField<int16_t>(Monster::VT_MANA, 150), 150);
+  TEST_EQ_STR(monster.GetString(Monster::VT_NAME)->c_str(), "MyMonster");
+  auto pos = monster.GetStruct<Vec3>(Monster::VT_POS);
+  TEST_EQ(pos->z(), 3);
+  auto inventory = monster.GetVector<uint8_t>(Monster::VT_INVENTORY);
+  TEST_EQ(inventory->size(), 10U);
+  auto test4 = monster.GetVector<const Test *>(Monster::VT_TEST4);
+  TEST_EQ(test4->Get(1)->a(), 30);
+  TEST_EQ(monster.GetField<uint8_t>(Monster::VT_TEST_TYPE, 0),
+          static_cast<uint8_t>(Any_Monster));
+  auto test = monster.GetTable<Monster>(Monster::VT_TEST);
+  TEST_EQ_STR(test.GetString(Monster::VT_NAME)->c_str(), "Fred");
+  TEST_EQ(test.GetTable<Monster>(Monster::VT_ENEMY).get() == nullptr, true);
+
+  auto tables = monster.GetVector<flatbuffers::Offset<Monster>>(
+      Monster::VT_TESTARRAYOFTABLES);
+  TEST_EQ(tables->size(), 3U);
+  auto barney = verifier.GetTable(tables, 0);
+  TEST_EQ_STR(barney.GetString(Monster::VT_NAME)->c_str(), "Barney");
+  auto strings = monster.GetVector<flatbuffers::Offset<flatbuffers::String>>(
+      Monster::VT_TESTARRAYOFSTRING);
+  TEST_EQ_STR(verifier.GetString(strings, 3)->c_str(), "fred");
+  TEST_EQ(verifier.ok(), true);
+
+  // Reading again checks nothing new.
+  auto checked = verifier.num_checked();
+  barney = verifier.GetTable(tables, 0);
+  TEST_EQ_STR(barney.GetString(Monster::VT_NAME)->c_str(), "Barney");
+  TEST_EQ(verifier.num_checked(), checked);
+
+  // clang-format off
+  #ifndef FLATBUFFERS_DEBUG_VERIFICATION_FAILURE
+    // Damage that isn't read goes unnoticed.
+    std::vector<uint8_t> copy(flatbuf, flatbuf + length);
+    auto name = GetMonster(copy.data())->testarrayoftables()->Get(1)->name();
+    copy[static_cast<size_t>(
+        reinterpret_cast<const uint8_t *>(name->c_str()) + name->size() -
+        copy.data())] = 'x';
+    flatbuffers::LazyVerifier damaged(copy.data(), copy.size());
+    auto root = damaged.GetRoot<Monster>();
+    TEST_EQ(root.GetField<int16_t>(Monster::VT_HP, 100), 80);
+    auto broken_tables = root.GetVector<flatbuffers::Offset<Monster>>(
+        Monster::VT_TESTARRAYOFTABLES);
+    TEST_NOTNULL(damaged.GetTable(broken_tables, 1).get());
+    TEST_EQ(damaged.ok(), true);
+    TEST_EQ(damaged.GetTable(broken_tables, 1).GetString(Monster::VT_NAME) ==
+                nullptr,
+            true);
+    TEST_EQ(damaged.ok(), false);
+    TEST_EQ(damaged.GetTable(broken_tables, 3).get() == nullptr, true);
+
+    // A truncated buffer fails at the first read past its end.
+    flatbuffers::LazyVerifier truncated(flatbuf, 16);
+    auto truncated_root = truncated.GetRoot<Monster>();
+    TEST_EQ(truncated_root.GetField<int16_t>(Monster::VT_HP, 100), 100);
+    TEST_EQ(truncated.ok(), false);
+  #endif
+  // clang-format on
+}
+
+void VerifyUtf8Test() {
+  const char *valid[] = { "", "plain ascii, longer than a word",
+                          "caf\xC3\xA9", "\xE2\x82\xAC 1 \xF0\x9F\x98\x80",
+                          "\xED\x9F\xBF\xEE\x80\x80\xF4\x8F\xBF\xBF" };
+  for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++) {
+    TEST_EQ(flatbuffers::IsValidUtf8(valid[i], strlen(valid[i])), true);
+  }
+  const char *invalid[] = {
+    "\x80",              // Stray continuation byte.
+    "abcdefgh\xC3",      // Truncated sequence after a word of ASCII.
+    "\xC0\x80",          // Overlong.
+    "\xE0\x9F\xBF",      // Overlong.
+    "\xED\xA0\x80",      // Surrogate.
+    "\xF4\x90\x80\x80",  // Past U+10FFFF.
+    "\xE2\x28\xA1",      // Bad continuation byte.
+    "\xFF"
+  };
+  for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+    TEST_EQ(flatbuffers::IsValidUtf8(invalid[i], strlen(invalid[i])), false);
+  }
+
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<std::string> strings;
+  for (int i = 0; i < 100; i++) {
+    strings.push_back("caf\xC3\xA9 " + flatbuffers::NumToString(i));
+  }
+  auto names = fbb.CreateVectorOfStrings(strings);
+  auto name = fbb.CreateString("\xE2\x82\xAC");
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_testarrayofstring(names);
+  FinishMonsterBuffer(fbb, mb.Finish());
+  flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize());
+  verifier.SetCheckUtf8(true);
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+
+  // clang-format off
+  #ifndef FLATBUFFERS_DEBUG_VERIFICATION_FAILURE
+    // A string in the vector that isn't UTF-8, or isn't terminated.
+    auto monster = GetMonster(fbb.GetBufferPointer());
+    auto broken = monster->testarrayofstring()->Get(57);
+    auto bytes = const_cast<char *>(broken->c_str());
+    bytes[4] = 'x';
+    flatbuffers::Verifier unchecked(fbb.GetBufferPointer(), fbb.GetSize());
+    TEST_EQ(VerifyMonsterBuffer(unchecked), true);
+    flatbuffers::Verifier checked(fbb.GetBufferPointer(), fbb.GetSize());
+    checked.SetCheckUtf8(true);
+    TEST_EQ(VerifyMonsterBuffer(checked), false);
+    bytes[4] = '\xA9';
+    bytes[broken->size()] = 'x';
+    flatbuffers::Verifier unterminated(fbb.GetBufferPointer(), fbb.GetSize());
+    TEST_EQ(VerifyMonsterBuffer(unterminated), false);
+    bytes[broken->size()] = '\0';
+  #endif
+  // clang-format on
+}
+
+// clang-format off
+#if FLATBUFFERS_HAS_THREADS
+// clang-format on
+static int verify_monster_calls = 0;
+
+static bool CountingVerifyMonster(flatbuffers::Verifier &verifier) {
+  verify_monster_calls++;
+  return VerifyMonsterBuffer(verifier);
+}
+// clang-format off
+#endif  // FLATBUFFERS_HAS_THREADS
+// clang-format on
+
+void VerificationCacheTest() {
+  const char *hashed[] = { "", "a", "abc",
+                           "Nobody inspects the spammish repetition" };
+  const uint64_t hashes[] = { 0xEF46DB3751D8E999ULL, 0xD24EC4F1A98C6E5BULL,
+                              0x44BC2CF5AD770999ULL, 0xFBCEA83C8A378BF1ULL };
+  for (size_t i = 0; i < sizeof(hashed) / sizeof(hashed[0]); i++) {
+    TEST_EQ(flatbuffers::HashXxh64(hashed[i], strlen(hashed[i])), hashes[i]);
+  }
+
+  // clang-format off
+  #if FLATBUFFERS_HAS_THREADS
+  // clang-format on
+  std::vector<flatbuffers::DetachedBuffer> buffers;
+  for (int i = 0; i < 3; i++) {
+    flatbuffers::FlatBufferBuilder fbb;
+    auto name = fbb.CreateString("monster" + flatbuffers::NumToString(i));
+    FinishMonsterBuffer(fbb, CreateMonster(fbb, nullptr, 100, 100, name));
+    buffers.push_back(fbb.Release());
+  }
+  flatbuffers::VerificationCache cache(2);
+  for (int i = 0; i < 2; i++) {
+    TEST_EQ(cache.Verify(buffers[0].data(), buffers[0].size(),
+                         CountingVerifyMonster),
+            true);
+  }
+  TEST_EQ(verify_monster_calls, 1);
+  TEST_EQ(cache.hits(), 1U);
+  // A different verify function is a different entry.
+  TEST_EQ(cache.Verify(buffers[0].data(), buffers[0].size(),
+                       VerifyMonsterBuffer),
+          true);
+  TEST_EQ(cache.size(), 2U);
+  // Buffer 0 was hit since it was added, the other entry goes first.
+  TEST_EQ(cache.Verify(buffers[1].data(), buffers[1].size(),
+                       CountingVerifyMonster),
+          true);
+  TEST_EQ(cache.Verify(buffers[0].data(), buffers[0].size(),
+                       CountingVerifyMonster),
+          true);
+  TEST_EQ(verify_monster_calls, 2);
+  TEST_EQ(cache.misses(), 3U);
+  TEST_EQ(cache.Verify(buffers[0].data(), buffers[0].size(),
+                       VerifyMonsterBuffer),
+          true);
+  TEST_EQ(cache.misses(), 4U);
+  TEST_EQ(cache.size(), 2U);
+
+  // A changed buffer is verified again.
+  std::vector<uint8_t> copy(buffers[2].data(),
+                            buffers[2].data() + buffers[2].size());
+  TEST_EQ(cache.Verify(copy.data(), copy.size(), CountingVerifyMonster), true);
+  const_cast<char *>(GetMonster(copy.data())->name()->c_str())[0] = 'M';
+  TEST_EQ(cache.Verify(copy.data(), copy.size(), CountingVerifyMonster), true);
+  TEST_EQ(verify_monster_calls, 4);
+
+  // clang-format off
+  #ifndef FLATBUFFERS_DEBUG_VERIFICATION_FAILURE
+    // Failures aren't remembered.
+    copy.resize(copy.size() / 2);
+    for (int i = 0; i < 2; i++) {
+      TEST_EQ(cache.Verify(copy.data(), copy.size(), CountingVerifyMonster),
+              false);
+    }
+    TEST_EQ(verify_monster_calls, 6);
+  #endif
+  // clang-format on
+
+  cache.Clear();
+  TEST_EQ(cache.size(), 0U);
+  flatbuffers::VerificationCache shared(8);
+  std::vector<std::thread> threads;
+  std::vector<int> verified(4, 0);
+  for (size_t t = 0; t < verified.size(); t++) {
+    threads.push_back(std::thread([&, t]() {
+      for (int i = 0; i < 100; i++) {
+        auto &buf = buffers[static_cast<size_t>(i) % buffers.size()];
+        verified[t] += shared.Verify(buf.data(), buf.size(),
+                                     VerifyMonsterBuffer);
+      }
+    }));
+  }
+  for (auto it = threads.begin(); it != threads.end(); ++it) it->join();
+  for (size_t t = 0; t < verified.size(); t++) TEST_EQ(verified[t], 100);
+  TEST_EQ(shared.size(), 3U);
+  TEST_EQ(shared.hits() + shared.misses(), 400U);
+  // clang-format off
+  #endif  // FLATBUFFERS_HAS_THREADS
+  // clang-format on
+}
+
 void MiniReflectFixedLengthArrayTest() {
   // VS10 does not support typed enums, exclude from tests
 #if !defined(_MSC_VER) || _MSC_VER >= 1700
@@ -2269,6 +3133,296 @@ void GenerateTableTextTest() {
   TEST_EQ_STR(jsongen.c_str(), "{a: 10,b: 20}");
 }
 
+struct TextChunks {
+  std::string text;
+  size_t max_chunk;
+};
+
+static bool CollectTextChunk(void *context, const char *data, size_t size) {
+  auto chunks = static_cast<TextChunks *>(context);
+  chunks->text.append(data, size);
+  chunks->max_chunk = std::max(chunks->max_chunk, size);
+  return true;
+}
+
+static bool FailTextChunk(void *, const char *, size_t) { return false; }
+
+void GenerateTextSinkTest() {
+  std::string schemafile;
+  std::string jsonfile;
+  bool ok =
+      flatbuffers::LoadFile((test_data_path + "monster_test.fbs").c_str(),
+                            false, &schemafile) &&
+      flatbuffers::LoadFile((test_data_path + "monsterdata_test.json").c_str(),
+                            false, &jsonfile);
+  TEST_EQ(ok, true);
+  auto include_test_path =
+      flatbuffers::ConCatPathFileName(test_data_path, "include_test");
+  const char *include_directories[] = { test_data_path.c_str(),
+                                        include_test_path.c_str(), nullptr };
+  flatbuffers::Parser parser;
+  ok = parser.Parse(schemafile.c_str(), include_directories) &&
+       parser.Parse(jsonfile.c_str(), include_directories);
+  TEST_EQ(ok, true);
+  std::string jsongen;
+  TEST_EQ(GenerateText(parser, parser.builder_.GetBufferPointer(), &jsongen),
+          true);
+
+  // The streamed text is the same, delivered in small chunks.
+  TextChunks chunks;
+  chunks.max_chunk = 0;
+  flatbuffers::CallbackTextSink sink(CollectTextChunk, &chunks, 64);
+  TEST_EQ(GenerateText(parser, parser.builder_.GetBufferPointer(), &sink),
+          true);
+  TEST_EQ_STR(chunks.text.c_str(), jsongen.c_str());
+  TEST_EQ(chunks.max_chunk < jsongen.size() / 4, true);
+
+  // A failing sink fails the generation.
+  flatbuffers::CallbackTextSink failing_sink(FailTextChunk, nullptr, 64);
+  TEST_EQ(GenerateText(parser, parser.builder_.GetBufferPointer(),
+                       &failing_sink),
+          false);
+
+  // FlexBuffers stream through the same sink.
+  flexbuffers::Builder fbb;
+  auto map_start = fbb.StartMap();
+  auto vec_start = fbb.StartVector("vec");
+  for (int i = 0; i < 100; i++) fbb.Int(i);
+  fbb.EndVector(vec_start, false, false);
+  fbb.String("str", "a string");
+  fbb.EndMap(map_start);
+  fbb.Finish();
+  auto root = flexbuffers::GetRoot(fbb.GetBuffer());
+  TextChunks flex_chunks;
+  flex_chunks.max_chunk = 0;
+  flatbuffers::CallbackTextSink flex_sink(CollectTextChunk, &flex_chunks, 16);
+  TEST_EQ(root.ToString(true, true, flex_sink), true);
+  std::string flex_text;
+  root.ToString(true, true, flex_text);
+  TEST_EQ_STR(flex_chunks.text.c_str(), flex_text.c_str());
+  TEST_EQ(flex_chunks.max_chunk < flex_text.size() / 4, true);
+}
+
+void MiniReflectToStringReuseTest(const uint8_t *flatbuf) {
+  // The allocation free number formatting matches NumToString.
+  std::string num;
+  flatbuffers::AppendNumberToString((std::numeric_limits<int64_t>::min)(),
+                                    &num);
+  num += ' ';
+  flatbuffers::AppendNumberToString((std::numeric_limits<uint64_t>::max)(),
+                                    &num);
+  num += ' ';
+  flatbuffers::AppendNumberToString(static_cast<int8_t>(-128), &num);
+  num += ' ';
+  flatbuffers::AppendNumberToString(static_cast<uint8_t>(0), &num);
+  TEST_EQ_STR(num.c_str(),
+              "-9223372036854775808 18446744073709551615 -128 0");
+  const double doubles[] = { 0.0, -0.0, 1.0, -2.5, 3.14159265358979, 1e-13,
+                             123456789.125, 1e40, 1e300, -1e300 };
+  for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); i++) {
+    num.clear();
+    flatbuffers::AppendNumberToString(doubles[i], &num);
+    TEST_EQ_STR(num.c_str(), flatbuffers::NumToString(doubles[i]).c_str());
+    num.clear();
+    auto f = static_cast<float>(doubles[i]);
+    flatbuffers::AppendNumberToString(f, &num);
+    TEST_EQ_STR(num.c_str(), flatbuffers::NumToString(f).c_str());
+  }
+
+  auto type_table = Monster::MiniReflectTypeTable();
+  for (int multi_line = 0; multi_line < 2; multi_line++) {
+    auto expected =
+        flatbuffers::FlatBufferToString(flatbuf, type_table, multi_line != 0);
+
+    // Appends to the caller's string, whose capacity is kept when reused.
+    std::string text = "prefix";
+    flatbuffers::FlatBufferToString(flatbuf, type_table, &text,
+                                    multi_line != 0);
+    TEST_EQ_STR(text.c_str(), ("prefix" + expected).c_str());
+    auto capacity = text.capacity();
+    text.clear();
+    flatbuffers::FlatBufferToString(flatbuf, type_table, &text,
+                                    multi_line != 0);
+    TEST_EQ_STR(text.c_str(), expected.c_str());
+    TEST_EQ(text.capacity(), capacity);
+
+    // Streams in chunks of bounded size.
+    TextChunks chunks = { std::string(), 0 };
+    flatbuffers::CallbackTextSink sink(CollectTextChunk, &chunks, 64);
+    TEST_EQ(flatbuffers::FlatBufferToString(flatbuf, type_table, &sink,
+                                            multi_line != 0),
+            true);
+    TEST_EQ_STR(chunks.text.c_str(), expected.c_str());
+    TEST_EQ(chunks.max_chunk < expected.size(), true);
+  }
+
+  // A reused visitor with an indent produces the same text every time.
+  flatbuffers::ToStringVisitor visitor("\n", true, "  ");
+  flatbuffers::IterateFlatBuffer(flatbuf, type_table, &visitor);
+  auto first = visitor.s;
+  TEST_EQ(first.find("\n    \"x\": 1.0") != std::string::npos, true);
+  visitor.Reset();
+  flatbuffers::IterateFlatBuffer(flatbuf, type_table, &visitor);
+  TEST_EQ_STR(visitor.s.c_str(), first.c_str());
+
+  flatbuffers::CallbackTextSink failing(FailTextChunk, nullptr, 16);
+  TEST_EQ(flatbuffers::FlatBufferToString(flatbuf, type_table, &failing),
+          false);
+}
+
+void ParallelGenerateTextTest() {
+  std::string schemafile;
+  TEST_EQ(flatbuffers::LoadFile((test_data_path + "monster_test.fbs").c_str(),
+                                false, &schemafile),
+          true);
+  auto include_test_path =
+      flatbuffers::ConCatPathFileName(test_data_path, "include_test");
+  const char *include_directories[] = { test_data_path.c_str(),
+                                        include_test_path.c_str(), nullptr };
+  flatbuffers::Parser parser;
+  TEST_EQ(parser.Parse(schemafile.c_str(), include_directories), true);
+
+  // A vector of tables that themselves contain vectors of tables.
+  std::string json = "{ name: \"root\", testarrayoftables: [";
+  for (int i = 0; i < 1000; i++) {
+    auto n = flatbuffers::NumToString(i);
+    json += (i ? ", " : "") + std::string("{ name: \"m") + n + "\", hp: " + n;
+    if (i % 10 == 0) {
+      json += ", testarrayoftables: [";
+      for (int j = 0; j < 20; j++) {
+        json += (j ? ", " : "") + std::string("{ name: \"c\", hp: ") +
+                flatbuffers::NumToString(j) + " }";
+      }
+      json += "]";
+    }
+    json += " }";
+  }
+  json += "] }";
+  TEST_EQ(parser.Parse(json.c_str()), true);
+  std::string serial;
+  TEST_EQ(GenerateText(parser, parser.builder_.GetBufferPointer(), &serial),
+          true);
+
+  // Chunked printing on several threads gives the same text.
+  parser.opts.json_threads = 4;
+  parser.opts.json_chunk_size = 7;
+  std::string parallel;
+  TEST_EQ(GenerateText(parser, parser.builder_.GetBufferPointer(), &parallel),
+          true);
+  TEST_EQ_STR(parallel.c_str(), serial.c_str());
+
+  // A chunk size of 0 doesn't split vectors.
+  parser.opts.json_chunk_size = 0;
+  parallel.clear();
+  TEST_EQ(GenerateText(parser, parser.builder_.GetBufferPointer(), &parallel),
+          true);
+  TEST_EQ_STR(parallel.c_str(), serial.c_str());
+  parser.opts.json_chunk_size = 7;
+
+  TextChunks chunks;
+  chunks.max_chunk = 0;
+  flatbuffers::CallbackTextSink sink(CollectTextChunk, &chunks, 1024);
+  TEST_EQ(GenerateText(parser, parser.builder_.GetBufferPointer(), &sink),
+          true);
+  TEST_EQ_STR(chunks.text.c_str(), serial.c_str());
+
+  parser.opts.strict_json = true;
+  parser.opts.indent_step = -1;
+  parallel.clear();
+  TEST_EQ(GenerateText(parser, parser.builder_.GetBufferPointer(), &parallel),
+          true);
+  parser.opts.json_threads = 1;
+  serial.clear();
+  TEST_EQ(GenerateText(parser, parser.builder_.GetBufferPointer(), &serial),
+          true);
+  TEST_EQ_STR(parallel.c_str(), serial.c_str());
+}
+
+void GeneratedJsonTest() {
+  std::string schemafile;
+  std::string jsonfile;
+  bool ok =
+      flatbuffers::LoadFile((test_data_path + "monster_test.fbs").c_str(),
+                            false, &schemafile) &&
+      flatbuffers::LoadFile((test_data_path + "monsterdata_test.json").c_str(),
+                            false, &jsonfile);
+  TEST_EQ(ok, true);
+  auto include_test_path =
+      flatbuffers::ConCatPathFileName(test_data_path, "include_test");
+  const char *include_directories[] = { test_data_path.c_str(),
+                                        include_test_path.c_str(), nullptr };
+  flatbuffers::Parser parser;
+  ok = parser.Parse(schemafile.c_str(), include_directories) &&
+       parser.Parse(jsonfile.c_str(), include_directories);
+  TEST_EQ(ok, true);
+  auto buf = parser.builder_.GetBufferPointer();
+  std::string expected;
+  TEST_EQ(GenerateText(parser, buf, &expected), true);
+
+  // The generated functions print the same text as GenerateText().
+  std::string json;
+  flatbuffers::JsonWriter writer(json);
+  TEST_EQ(MonsterBufferToJson(buf, writer), true);
+  TEST_EQ_STR(json.c_str(), expected.c_str());
+
+  TextChunks chunks;
+  chunks.max_chunk = 0;
+  flatbuffers::CallbackTextSink sink(CollectTextChunk, &chunks, 64);
+  flatbuffers::JsonWriter sink_writer(sink);
+  TEST_EQ(MonsterBufferToJson(buf, sink_writer), true);
+  TEST_EQ_STR(chunks.text.c_str(), expected.c_str());
+
+  flatbuffers::JsonOptions strict;
+  strict.strict_json = true;
+  strict.indent_step = -1;
+  strict.output_default_scalars_in_json = true;
+  parser.opts.strict_json = true;
+  parser.opts.indent_step = -1;
+  parser.opts.output_default_scalars_in_json = true;
+  expected.clear();
+  TEST_EQ(GenerateText(parser, buf, &expected), true);
+  json.clear();
+  flatbuffers::JsonWriter strict_writer(json, strict);
+  TEST_EQ(MonsterBufferToJson(buf, strict_writer), true);
+  TEST_EQ_STR(json.c_str(), expected.c_str());
+
+  // Reading the JSON back gives a buffer that prints the same, for both the
+  // original file and the strict text.
+  flatbuffers::FlatBufferBuilder fbb;
+  flatbuffers::JsonReader reader(jsonfile);
+  TEST_EQ(MonsterBufferFromJson(reader, fbb), true);
+  flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize());
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+  std::string reparsed;
+  TEST_EQ(GenerateText(parser, fbb.GetBufferPointer(), &reparsed), true);
+  TEST_EQ_STR(reparsed.c_str(), expected.c_str());
+
+  fbb.Clear();
+  flatbuffers::JsonReader strict_reader(json, strict);
+  TEST_EQ(MonsterBufferFromJson(strict_reader, fbb), true);
+  reparsed.clear();
+  TEST_EQ(GenerateText(parser, fbb.GetBufferPointer(), &reparsed), true);
+  TEST_EQ_STR(reparsed.c_str(), expected.c_str());
+
+  // Errors are reported like the parser does.
+  fbb.Clear();
+  flatbuffers::JsonReader unknown("{ name: \"x\", foo: 1 }");
+  TEST_EQ(MonsterBufferFromJson(unknown, fbb), false);
+  TEST_EQ(unknown.error().find("unknown field: foo") == 0, true);
+  flatbuffers::JsonOptions skip;
+  skip.skip_unexpected_fields_in_json = true;
+  flatbuffers::JsonReader skipped("{ name: \"x\", foo: { a: [1] } }", skip);
+  TEST_EQ(MonsterBufferFromJson(skipped, fbb), true);
+  TEST_EQ_STR(GetMonster(fbb.GetBufferPointer())->name()->c_str(), "x");
+  flatbuffers::JsonReader missing("{ hp: 1 }");
+  TEST_EQ(MonsterBufferFromJson(missing, fbb), false);
+  TEST_EQ(missing.error().find("required field is missing: name") == 0, true);
+  flatbuffers::JsonReader bad_enum("{ name: \"x\", color: Purple }");
+  TEST_EQ(MonsterBufferFromJson(bad_enum, fbb), false);
+  flatbuffers::JsonReader trailing("{ name: \"x\" } 1");
+  TEST_EQ(MonsterBufferFromJson(trailing, fbb), false);
+}
+
 template<typename T>
 void NumericUtilsTestInteger(const char *lower, const char *upper) {
   T x;
@@ -2305,6 +3459,60 @@ void NumericUtilsTest() {
   NumericUtilsTestFloat<float>("-1.7977e+308", "+1.7977e+308");
 }
 
+// The locale-free fast paths of StringToNumber must agree with strtod/strtof
+// and strtoll bit for bit.
+void NumericUtilsExactTest() {
+  // The reference functions depend on the C-locale decimal point.
+  if (*localeconv()->decimal_point != '.') return;
+  const char *exact[] = { "0.1",
+                          "-0",
+                          "1e23",
+                          "9007199254740993",
+                          "2.2250738585072011e-308",
+                          "4.9406564584124654e-324",
+                          "1.7976931348623157e308",
+                          "3.4028235e38",
+                          "1.17549435e-38",
+                          "123456789012345678901234567890",
+                          "0.000000000000000000000000000001234",
+                          "7.038531e-26" };
+  for (size_t i = 0; i < sizeof(exact) / sizeof(exact[0]); i++) {
+    double d;
+    float f;
+    TEST_EQ(flatbuffers::StringToNumber(exact[i], &d), true);
+    TEST_EQ(flatbuffers::StringToNumber(exact[i], &f), true);
+    const double ref_d = strtod(exact[i], nullptr);
+    const float ref_f = strtof(exact[i], nullptr);
+    TEST_EQ(memcmp(&d, &ref_d, sizeof(d)), 0);
+    TEST_EQ(memcmp(&f, &ref_f, sizeof(f)), 0);
+  }
+  lcg_reset();
+  char buf[64];
+  for (int i = 0; i < 20000; i++) {
+    const auto m = (static_cast<uint64_t>(lcg_rand()) << 32) | lcg_rand();
+    const auto e = static_cast<int>(lcg_rand() % 700) - 350;
+    snprintf(buf, sizeof(buf), "%s%llu.%ue%d", (i & 1) ? "-" : "",
+             static_cast<unsigned long long>(m >> (lcg_rand() % 64)),
+             lcg_rand() % 1000, e);
+    double d;
+    float f;
+    flatbuffers::StringToNumber(buf, &d);
+    flatbuffers::StringToNumber(buf, &f);
+    const double ref_d = strtod(buf, nullptr);
+    const float ref_f = strtof(buf, nullptr);
+    TEST_EQ(memcmp(&d, &ref_d, sizeof(d)), 0);
+    TEST_EQ(memcmp(&f, &ref_f, sizeof(f)), 0);
+    snprintf(buf, sizeof(buf), "%s%llu", (i & 1) ? "-" : "",
+             static_cast<unsigned long long>(m >> (lcg_rand() % 64)));
+    int64_t i64;
+    errno = 0;
+    char *end;
+    const auto ref_i64 = strtoll(buf, &end, 10);
+    TEST_EQ(flatbuffers::StringToNumber(buf, &i64), errno == 0);
+    TEST_EQ(i64, ref_i64);
+  }
+}
+
 void IsAsciiUtilsTest() {
   char c = -128;
   for (int cnt = 0; cnt < 256; cnt++) {
@@ -3132,6 +4340,515 @@ void FlexBuffersTest() {
   TEST_EQ(slb.GetSize(), 664);
 }
 
+void FlexBuffersMapKeyTest() {
+  // Maps sharing their keys vector, with values sized so the last maps need
+  // wider offsets to reach the keys.
+  const char *names[] = { "", "alpha", "beta", "betamax", "gamma", "zeta" };
+  const size_t num_names = sizeof(names) / sizeof(names[0]);
+  flexbuffers::Builder slb(512, flexbuffers::BUILDER_FLAG_SHARE_ALL);
+  flexbuffers::Builder unshared(
+      512, flexbuffers::BUILDER_FLAG_SHARE_KEYS_AND_STRINGS);
+  for (int shared = 0; shared < 2; shared++) {
+    auto &builder = shared ? slb : unshared;
+    builder.Vector([&]() {
+      for (int m = 0; m < 100; m++) {
+        builder.Map([&]() {
+          for (size_t k = 0; k < num_names; k++) {
+            builder.Int(names[k], m * 10 + static_cast<int>(k));
+          }
+          builder.Key("padding");
+          builder.Blob(std::vector<uint8_t>(static_cast<size_t>(m) * 20, 0));
+        });
+      }
+    });
+    builder.Finish();
+  }
+  // 99 keys vectors of 7 keys less.
+  TEST_EQ(unshared.GetSize() - slb.GetSize() >= 99U * 8, true);
+  auto maps = flexbuffers::GetRoot(slb.GetBuffer()).AsVector();
+
+  flexbuffers::MapKey missing("bet");
+  std::vector<flexbuffers::MapKey> keys;
+  for (size_t k = 0; k < num_names; k++) {
+    keys.push_back(flexbuffers::MapKey(names[k]));
+  }
+  for (size_t m = 0; m < maps.size(); m++) {
+    auto map = maps[m].AsMap();
+    for (size_t k = 0; k < num_names; k++) {
+      auto expected = static_cast<int64_t>(m * 10 + k);
+      TEST_EQ(map[names[k]].AsInt64(), expected);
+      TEST_EQ(map[keys[k]].AsInt64(), expected);
+    }
+    TEST_EQ(map["bet"].IsNull(), true);
+    TEST_EQ(map[missing].IsNull(), true);
+    TEST_EQ(map["zz"].IsNull(), true);
+  }
+
+  // Maps with keys vectors of their own, more than the key remembers.
+  flexbuffers::MapKey beta("beta");
+  std::vector<std::vector<uint8_t>> buffers;
+  for (int m = 0; m < 6; m++) {
+    flexbuffers::Builder fbb;
+    fbb.Map([&]() {
+      for (int k = 0; k <= m; k++) {
+        fbb.Int(("key" + flatbuffers::NumToString(k)).c_str(), k);
+      }
+      fbb.Int("beta", m);
+    });
+    fbb.Finish();
+    buffers.push_back(fbb.GetBuffer());
+  }
+  for (int pass = 0; pass < 2; pass++) {
+    for (size_t m = 0; m < buffers.size(); m++) {
+      auto map = flexbuffers::GetRoot(buffers[m]).AsMap();
+      TEST_EQ(map[beta].AsInt64(), static_cast<int64_t>(m));
+    }
+  }
+  TEST_EQ(flexbuffers::Map::EmptyMap()[beta].IsNull(), true);
+}
+
+// Checks CopyTo() of each element type against reading them one by one.
+template<typename V> void CheckTypedVectorCopy(V vec, size_t len) {
+  std::vector<int64_t> ints(len);
+  std::vector<uint64_t> uints(len);
+  std::vector<double> doubles(len);
+  std::vector<float> floats(len);
+  std::vector<int32_t> int32s(len);
+  TEST_EQ(vec.CopyTo(flatbuffers::vector_data(ints)), true);
+  TEST_EQ(vec.CopyTo(flatbuffers::vector_data(uints)), true);
+  TEST_EQ(vec.CopyTo(flatbuffers::vector_data(doubles)), true);
+  TEST_EQ(vec.CopyTo(flatbuffers::vector_data(floats)), true);
+  TEST_EQ(vec.CopyTo(flatbuffers::vector_data(int32s)), true);
+  for (size_t i = 0; i < len; i++) {
+    TEST_EQ(ints[i], vec[i].AsInt64());
+    TEST_EQ(uints[i], vec[i].AsUInt64());
+    TEST_EQ(doubles[i], vec[i].AsDouble());
+    TEST_EQ(floats[i], vec[i].AsFloat());
+    TEST_EQ(int32s[i], vec[i].AsInt32());
+  }
+}
+
+void FlexBuffersTypedCopyTest() {
+  std::vector<int8_t> int8s;
+  std::vector<int16_t> int16s;
+  std::vector<int32_t> int32s;
+  std::vector<int64_t> int64s;
+  std::vector<uint16_t> uint16s;
+  std::vector<uint64_t> uint64s;
+  std::vector<float> floats;
+  std::vector<double> doubles;
+  // Long enough for the vectorized loops, with a remainder.
+  for (int i = 0; i < 37; i++) {
+    auto v = (i % 2 ? -1 : 1) * i * 3;
+    int8s.push_back(static_cast<int8_t>(v));
+    int16s.push_back(static_cast<int16_t>(v * 1000));
+    int32s.push_back(v * 100000);
+    int64s.push_back(static_cast<int64_t>(v) * 10000000000LL);
+    uint16s.push_back(static_cast<uint16_t>(i * 1500));
+    uint64s.push_back(static_cast<uint64_t>(i) << 60);
+    floats.push_back(static_cast<float>(v) / 7);
+    doubles.push_back(static_cast<double>(v) / 7);
+  }
+  flexbuffers::Builder slb;
+  slb.Vector([&]() {
+    slb.Vector(int8s);
+    slb.Vector(int16s);
+    slb.Vector(int32s);
+    slb.Vector(int64s);
+    slb.Vector(uint16s);
+    slb.Vector(uint64s);
+    slb.Vector(floats);
+    slb.Vector(doubles);
+    slb.TypedVector([&]() {
+      slb.Bool(true);
+      slb.Bool(false);
+    });
+    int32_t fixed[3] = { -1, 2, -3 };
+    slb.FixedTypedVector(fixed, 3);
+    double fixed_doubles[2] = { 0.5, -1.5 };
+    slb.FixedTypedVector(fixed_doubles, 2);
+    slb.TypedVector([&]() {
+      slb.Key("a");
+      slb.Key("b");
+    });
+  });
+  slb.Finish();
+  auto root = flexbuffers::GetRoot(slb.GetBuffer()).AsVector();
+  for (size_t i = 0; i < 9; i++) {
+    auto vec = root[i].AsTypedVector();
+    CheckTypedVectorCopy(vec, vec.size());
+  }
+  TEST_EQ(root[0].AsTypedVector().size(), 37U);
+  CheckTypedVectorCopy(root[9].AsFixedTypedVector(), 3);
+  CheckTypedVectorCopy(root[10].AsFixedTypedVector(), 2);
+  int64_t keys[2];
+  TEST_EQ(root[11].AsTypedVector().CopyTo(keys), false);
+
+  // Converted through a double or a 64-bit integer, like the accessors: an
+  // int64 rounds to a double before a float, a float too large for an int32
+  // goes through an int64.
+  flexbuffers::Builder edge;
+  edge.Vector([&]() {
+    std::vector<int64_t> big(1, (1LL << 53) + (1LL << 29) + 1);
+    edge.Vector(big);
+    std::vector<float> large(1, 3e9f);
+    edge.Vector(large);
+  });
+  edge.Finish();
+  auto edges = flexbuffers::GetRoot(edge.GetBuffer()).AsVector();
+  float big_float;
+  TEST_EQ(edges[0].AsTypedVector().CopyTo(&big_float), true);
+  TEST_EQ(big_float, edges[0].AsTypedVector()[0].AsFloat());
+  int32_t large_int;
+  TEST_EQ(edges[1].AsTypedVector().CopyTo(&large_int), true);
+  TEST_EQ(large_int, edges[1].AsTypedVector()[0].AsInt32());
+  CheckTypedVectorCopy(edges[0].AsTypedVector(), 1);
+  CheckTypedVectorCopy(edges[1].AsTypedVector(), 1);
+}
+
+void FlexBuffersEditorTest() {
+  flexbuffers::Builder slb;
+  slb.Map([&]() {
+    slb.String("name", "server");
+    slb.Int("port", 80);
+    slb.Vector("hosts", [&]() {
+      slb.String("a");
+      slb.String("b");
+    });
+    int16_t ids[3] = { 1, 2, 3 };
+    slb.Vector("ids", ids, 3);
+    int32_t point[2] = { 10, 20 };
+    slb.FixedTypedVector("point", point, 2);
+    slb.Map("limits", [&]() { slb.Double("cpu", 0.5); });
+  });
+  slb.Finish();
+  flexbuffers::Editor editor(slb.GetBuffer());
+  auto size = editor.GetSize();
+
+  // These fit where the old values are.
+  TEST_EQ(editor.SetInt({ "port" }, 81), true);
+  TEST_EQ(editor.SetDouble({ "limits", "cpu" }, 0.25), true);
+  TEST_EQ(editor.SetInt({ "point", 1 }, 30), true);
+  TEST_EQ(editor.GetSize(), size);
+
+  // These don't, and strings are never changed in place.
+  TEST_EQ(editor.SetString({ "hosts", 1 }, "c"), true);
+  TEST_EQ(editor.SetInt({ "port" }, 65536), true);
+  TEST_EQ(editor.SetString({ "name" }, "a longer name"), true);
+  TEST_EQ(editor.SetBool({ "limits", "strict" }, true), true);
+  TEST_EQ(editor.SetString({ "hosts", 2 }, "d"), true);
+  TEST_EQ(editor.SetInt({ "ids", 0 }, 100000), true);
+  TEST_EQ(editor.SetInt({ "ids", 3 }, 4), true);
+  TEST_EQ(editor.Erase({ "hosts", 0 }), true);
+  TEST_EQ(editor.SetUInt({ "owner" }, 7), true);
+  TEST_EQ(editor.Erase({ "owner" }), true);
+  TEST_ASSERT(editor.GetSize() > size);
+
+  // Paths that don't exist, and values that can't be stored there.
+  TEST_EQ(editor.SetInt({ "missing", "port" }, 1), false);
+  TEST_EQ(editor.SetInt({ "hosts", 5 }, 1), false);
+  TEST_EQ(editor.SetInt({ "port", 0 }, 1), false);
+  TEST_EQ(editor.SetInt({ "hosts", "a" }, 1), false);
+  TEST_EQ(editor.SetString({ "ids", 0 }, "x"), false);
+  TEST_EQ(editor.SetInt({ "point", 2 }, 1), false);
+  TEST_EQ(editor.Erase({ "point", 0 }), false);
+  TEST_EQ(editor.Erase({ "missing" }), false);
+
+  auto check = [](flexbuffers::Reference root) {
+    auto map = root.AsMap();
+    TEST_EQ(map.size(), 6U);
+    TEST_EQ_STR(map["name"].AsString().c_str(), "a longer name");
+    TEST_EQ(map["port"].AsInt64(), 65536);
+    auto hosts = map["hosts"].AsVector();
+    TEST_EQ(hosts.size(), 2U);
+    TEST_EQ_STR(hosts[0].AsString().c_str(), "c");
+    TEST_EQ_STR(hosts[1].AsString().c_str(), "d");
+    auto ids = map["ids"].AsTypedVector();
+    TEST_EQ(ids.size(), 4U);
+    TEST_EQ(ids[0].AsInt64(), 100000);
+    TEST_EQ(ids[2].AsInt64(), 3);
+    TEST_EQ(ids[3].AsInt64(), 4);
+    TEST_EQ(map["point"].AsFixedTypedVector()[1].AsInt32(), 30);
+    auto limits = map["limits"].AsMap();
+    TEST_EQ(limits["cpu"].AsDouble(), 0.25);
+    TEST_EQ(limits["strict"].AsBool(), true);
+    TEST_EQ(map["owner"].IsNull(), true);
+  };
+  check(editor.GetRoot());
+
+  // A whole value from another buffer.
+  flexbuffers::Builder sub;
+  sub.Map([&]() { sub.Int("retries", 3); });
+  sub.Finish();
+  TEST_EQ(editor.SetFlexBuffer({ "limits" }, sub.GetBuffer()), true);
+  TEST_EQ(editor.GetRoot().AsMap()["limits"].AsMap()["retries"].AsInt64(), 3);
+  TEST_EQ(editor.SetDouble({ "limits", "cpu" }, 0.25), true);
+  TEST_EQ(editor.SetBool({ "limits", "strict" }, true), true);
+  TEST_EQ(editor.Erase({ "limits", "retries" }), true);
+  check(editor.GetRoot());
+
+  std::string before;
+  editor.GetRoot().ToString(true, false, before);
+  auto edited_size = editor.GetSize();
+  editor.Compact();
+  TEST_ASSERT(editor.GetSize() < edited_size);
+  std::string after;
+  editor.GetRoot().ToString(true, false, after);
+  TEST_EQ_STR(after.c_str(), before.c_str());
+  check(editor.GetRoot());
+  TEST_EQ(editor.SetString({ "hosts", 0 }, "e"), true);
+  TEST_EQ_STR(editor.GetRoot().AsMap()["hosts"].AsVector()[0].AsString().c_str(),
+              "e");
+
+  // The root itself.
+  TEST_EQ(editor.SetInt({}, 5), true);
+  TEST_EQ(editor.GetRoot().AsInt64(), 5);
+
+  // Setting a string that other values share leaves them as they are.
+  flexbuffers::Builder shared(512, flexbuffers::BUILDER_FLAG_SHARE_ALL);
+  shared.Map([&]() {
+    shared.String("primary", "db-1");
+    shared.String("replica", "db-1");
+  });
+  shared.Finish();
+  auto shared_map = flexbuffers::GetRoot(shared.GetBuffer()).AsMap();
+  TEST_EQ(shared_map["primary"].AsString().c_str(),
+          shared_map["replica"].AsString().c_str());
+  flexbuffers::Editor shared_editor(shared.GetBuffer());
+  TEST_EQ(shared_editor.SetString({ "primary" }, "db-2"), true);
+  shared_map = shared_editor.GetRoot().AsMap();
+  TEST_EQ_STR(shared_map["primary"].AsString().c_str(), "db-2");
+  TEST_EQ_STR(shared_map["replica"].AsString().c_str(), "db-1");
+
+  // A typed vector keeps its type when its last element is erased.
+  flexbuffers::Builder typed;
+  int16_t one[1] = { 1 };
+  typed.Vector(one, 1);
+  typed.Finish();
+  flexbuffers::Editor typed_editor(typed.GetBuffer());
+  TEST_EQ(typed_editor.Erase({ 0 }), true);
+  auto empty = typed_editor.GetRoot();
+  TEST_EQ(empty.GetType(), flexbuffers::FBT_VECTOR_INT);
+  TEST_EQ(empty.AsTypedVector().size(), 0U);
+  TEST_EQ(typed_editor.SetInt({ 0 }, 2), true);
+  TEST_EQ(typed_editor.GetRoot().AsTypedVector()[0].AsInt64(), 2);
+}
+
+void FlexBuffersPathTest() {
+  flexbuffers::Builder slb;
+  slb.Map([&]() {
+    slb.Map("request", [&]() {
+      slb.String("user", "ann");
+      slb.String("a/b~c", "escaped");
+      slb.Int("7", 77);
+    });
+    slb.Map("response", [&]() {
+      slb.Int("status", 503);
+      slb.Vector("headers", [&]() {
+        slb.String("a");
+        slb.Map([&]() { slb.String("name", "b"); });
+      });
+    });
+    int16_t ids[3] = { 1, 2, 3 };
+    slb.Vector("ids", ids, 3);
+    int32_t point[2] = { 10, 20 };
+    slb.FixedTypedVector("point", point, 2);
+  });
+  slb.Finish();
+  auto root = flexbuffers::GetRoot(slb.GetBuffer());
+
+  struct {
+    const char *path;
+    const char *value;  // nullptr if null.
+  } paths[] = {
+    { "", nullptr },
+    { "$.request.user", "ann" },
+    { "/request/user", "ann" },
+    { "$['request'][\"user\"]", "ann" },
+    { "/request/a~1b~0c", "escaped" },
+    { "$.request['a/b~c']", "escaped" },
+    { "/request/7", "77" },  // A number is a key in a map.
+    { "$.request[7]", nullptr },
+    { "/response/headers/1/name", "b" },
+    { "$.response.headers[1].name", "b" },
+    { "$.response.headers[2]", nullptr },
+    { "$.ids[2]", "3" },
+    { "/point/1", "20" },
+    { "$.response.status.x", nullptr },
+    { "$.missing.user", nullptr },
+  };
+  flexbuffers::PathSet set;
+  for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+    flexbuffers::CompiledPath path;
+    TEST_EQ(path.Parse(paths[i].path), true);
+    size_t index;
+    TEST_EQ(set.Add(paths[i].path, &index), true);
+    TEST_EQ(index, i);
+    // Twice, the second time from what the MapKeys remember.
+    for (int j = 0; j < 2; j++) {
+      auto ref = path.Evaluate(root);
+      if (paths[i].value) {
+        TEST_EQ_STR(ref.ToString().c_str(), paths[i].value);
+      } else if (*paths[i].path) {
+        TEST_EQ(ref.IsNull(), true);
+      }
+    }
+  }
+  std::vector<flexbuffers::Reference> values;
+  set.Evaluate(root, &values);
+  TEST_EQ(values.size(), set.size());
+  TEST_EQ(values[0].IsMap(), true);
+  for (size_t i = 1; i < values.size(); i++) {
+    if (paths[i].value) {
+      TEST_EQ_STR(values[i].ToString().c_str(), paths[i].value);
+    } else {
+      TEST_EQ(values[i].IsNull(), true);
+    }
+  }
+
+  // The same as PathSteps.
+  flexbuffers::Path steps = { "response", "headers", 1, "name" };
+  auto name = flexbuffers::CompiledPath(steps).Evaluate(root);
+  TEST_EQ_STR(name.AsString().c_str(), "b");
+
+  const char *malformed[] = { "request", "$request", "$.", "$..a", "$[",
+                              "$[x]", "$[01]", "$['a'", "$['a]", "/a~2",
+                              "$[1" };
+  for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++) {
+    flexbuffers::CompiledPath path;
+    TEST_EQ(path.Parse(malformed[i]), false);
+    TEST_EQ(path.size(), 0);
+    TEST_EQ(set.Add(malformed[i]), false);
+  }
+}
+
+void FlexBuffersCanonicalTest() {
+  // The same document, written in different orders, with different value
+  // kinds and flags.
+  flexbuffers::Builder a(256, flexbuffers::BUILDER_FLAG_NONE);
+  a.Map([&]() {
+    a.String("name", "doc");
+    a.Int("count", 3);
+    a.Vector("ids", [&]() {
+      a.Int(1);
+      a.Int(300);
+      a.Int(-2);
+    });
+    a.Double("ratio", 1.5);
+    a.Map("owner", [&]() {
+      a.String("name", "ann");
+      a.UInt("id", 1ULL << 63);
+    });
+    a.Vector("mixed", [&]() {
+      a.String("doc");
+      a.Double(std::numeric_limits<double>::quiet_NaN());
+    });
+  });
+  a.Finish();
+  flexbuffers::Builder b(256, flexbuffers::BUILDER_FLAG_SHARE_ALL);
+  b.Map([&]() {
+    b.Vector("mixed", [&]() {
+      b.String("doc");
+      b.Double(-std::numeric_limits<double>::quiet_NaN());
+    });
+    b.Map("owner", [&]() {
+      b.UInt("id", 1ULL << 63);
+      b.String("name", "ann");
+    });
+    b.Float("ratio", 1.5f);
+    int16_t ids[3] = { 1, 300, -2 };
+    b.Vector("ids", ids, 3);
+    b.IndirectUInt("count", 3);
+    b.String("name", "doc");
+  });
+  b.Finish();
+  TEST_EQ(a.GetBuffer() == b.GetBuffer(), false);
+  auto canonical =
+      flexbuffers::Canonicalize(flexbuffers::GetRoot(a.GetBuffer()));
+  TEST_EQ(canonical == flexbuffers::Canonicalize(
+                           flexbuffers::GetRoot(b.GetBuffer())),
+          true);
+  // Canonical buffers stay as they are.
+  TEST_EQ(canonical ==
+              flexbuffers::Canonicalize(flexbuffers::GetRoot(canonical)),
+          true);
+  auto map = flexbuffers::GetRoot(canonical).AsMap();
+  TEST_EQ(map["count"].GetType(), flexbuffers::FBT_INT);
+  TEST_EQ(map["count"].AsInt64(), 3);
+  TEST_EQ(map["ids"].IsTypedVector(), true);
+  TEST_EQ(map["ids"].AsTypedVector()[1].AsInt64(), 300);
+  TEST_EQ(map["ratio"].AsDouble(), 1.5);
+  TEST_EQ(map["owner"].AsMap()["id"].AsUInt64(), 1ULL << 63);
+  TEST_EQ_STR(map["mixed"].AsVector()[0].AsString().c_str(), "doc");
+
+  auto hash = flexbuffers::CanonicalHash(flexbuffers::GetRoot(b.GetBuffer()));
+  TEST_EQ(hash,
+          flexbuffers::CanonicalHash(flexbuffers::GetRoot(a.GetBuffer())));
+  TEST_EQ(hash, flexbuffers::CanonicalHash(flexbuffers::GetRoot(canonical)));
+
+  // The canonical mode of the Builder.
+  flexbuffers::Builder c(256, flexbuffers::BUILDER_FLAG_CANONICAL);
+  c.Add(flexbuffers::GetRoot(b.GetBuffer()));
+  c.Finish();
+  TEST_EQ(c.GetBuffer() == canonical, true);
+
+  // A different document hashes differently.
+  flexbuffers::Editor editor(c.GetBuffer(),
+                             flexbuffers::BUILDER_FLAG_CANONICAL);
+  TEST_EQ(editor.SetInt({ "count" }, 1LL << 40), true);  // Doesn't fit.
+  TEST_EQ(flexbuffers::CanonicalHash(editor.GetRoot()) == hash, false);
+  TEST_EQ(editor.SetInt({ "count" }, 3), true);
+  TEST_EQ(flexbuffers::CanonicalHash(editor.GetRoot()), hash);
+  // Compact() makes it canonical again.
+  TEST_EQ(editor.GetBuffer() == canonical, false);
+  editor.Compact();
+  TEST_EQ(editor.GetBuffer() == canonical, true);
+}
+
+void FlexBuffersReleaseTest() {
+  flexbuffers::BufferPool pool(2);
+  std::vector<uint8_t> first;
+  {
+    flexbuffers::Builder slb(64, flexbuffers::BUILDER_FLAG_SHARE_KEYS, &pool);
+    slb.Map([&]() { slb.Int("a", 1); });
+    slb.Finish();
+    first = slb.Release();
+    TEST_EQ(slb.GetSize(), 0U);
+    TEST_EQ(flexbuffers::GetRoot(first).AsMap()["a"].AsInt64(), 1);
+
+    // The builder is ready for the next buffer, and gets one from the pool.
+    pool.Deallocate(&first);
+    TEST_EQ(first.empty(), true);
+    TEST_EQ(pool.size(), 1U);
+    slb.Map([&]() { slb.Int("b", 2); });
+    slb.Finish();
+    auto second = slb.Release();
+    TEST_EQ(pool.size(), 0U);
+    TEST_EQ(flexbuffers::GetRoot(second).AsMap()["b"].AsInt64(), 2);
+    TEST_EQ(flexbuffers::GetRoot(second).AsMap()["a"].IsNull(), true);
+  }
+  // Given back by the destructor.
+  TEST_EQ(pool.size(), 1U);
+
+  flexbuffers::Builder slb;
+  slb.SetMaxRetainedCapacity(1024);
+  slb.Vector([&]() {
+    for (int i = 0; i < 1000; i++) slb.Double(i + 0.5);
+  });
+  slb.Finish();
+  slb.Clear();
+  slb.Int(1);
+  slb.Finish();
+  TEST_EQ(flexbuffers::GetRoot(slb.GetBuffer()).AsInt64(), 1);
+  auto small = slb.GetBuffer().capacity();
+  TEST_ASSERT(small <= 1024);
+  slb.Clear();
+  slb.Int(2);
+  slb.Finish();
+  // Small buffers keep their memory.
+  TEST_EQ(slb.GetBuffer().capacity(), small);
+}
+
 void FlexBuffersFloatingPointTest() {
 #if defined(FLATBUFFERS_HAS_NEW_STRTOD) && (FLATBUFFERS_HAS_NEW_STRTOD > 0)
   flexbuffers::Builder slb(512,
@@ -3404,8 +5121,7 @@ void CreateSharedStringTest() {
   TEST_EQ(a[5]->str(), (std::string(chars_c, sizeof(chars_c))));
   TEST_EQ(a[6]->str(), (std::string(chars_b, sizeof(chars_b))));
 
-  // Make sure String::operator< works, too, since it is related to
-  // StringOffsetCompare.
+  // Make sure String::operator< works, too.
   TEST_EQ((*a[0]) < (*a[1]), true);
   TEST_EQ((*a[1]) < (*a[0]), false);
   TEST_EQ((*a[1]) < (*a[2]), false);
@@ -3416,6 +5132,134 @@ void CreateSharedStringTest() {
   TEST_EQ((*a[6]) < (*a[5]), true);
 }
 
+void StringPoolTest() {
+  // Enough strings to grow the pools a few times, each shared three times.
+  std::vector<std::string> strings;
+  for (int i = 0; i < 1000; i++) {
+    strings.push_back("string" + flatbuffers::NumToString(i));
+  }
+  strings.push_back("");
+  strings.push_back(std::string("ab\0c", 4));
+  strings.push_back("ab");
+
+  flatbuffers::FlatBufferBuilder fbb;
+  for (int pass = 0; pass < 2; pass++) {
+    fbb.Clear();
+    std::vector<flatbuffers::Offset<flatbuffers::String>> offsets;
+    for (auto it = strings.begin(); it != strings.end(); ++it) {
+      offsets.push_back(fbb.CreateSharedString(*it));
+    }
+    auto size = fbb.GetSize();
+    for (size_t i = 0; i < strings.size(); i++) {
+      TEST_EQ(fbb.CreateSharedString(strings[i]).o, offsets[i].o);
+      TEST_EQ(fbb.CreateSharedString(strings[i].c_str(), strings[i].size()).o,
+              offsets[i].o);
+    }
+    TEST_EQ(fbb.GetSize(), size);
+    fbb.Finish(fbb.CreateVector(offsets));
+    auto vec = flatbuffers::GetRoot<
+        flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>>(
+        fbb.GetBufferPointer());
+    for (size_t i = 0; i < strings.size(); i++) {
+      TEST_EQ(vec->Get(static_cast<flatbuffers::uoffset_t>(i))->str(),
+              strings[i]);
+    }
+  }
+
+  // The pools of a moved builder still refer to its buffer.
+  flexbuffers::Builder moved(256,
+                             flexbuffers::BUILDER_FLAG_SHARE_KEYS_AND_STRINGS);
+  moved.String("shared");
+  moved.Key("shared");
+  auto size = moved.GetSize();
+  flexbuffers::Builder flex(std::move(moved));
+  flex.String("shared");
+  flex.Key("shared");
+  TEST_EQ(flex.GetSize(), size);
+  flex.Clear();
+  flex.Map([&]() {
+    for (size_t i = 0; i < strings.size(); i++) {
+      auto key = "key" + flatbuffers::NumToString(i);
+      flex.Vector(key.c_str(), [&]() {
+        flex.String(strings[i]);
+        flex.String(strings[strings.size() - 1 - i]);
+      });
+    }
+  });
+  flex.Finish();
+  auto map = flexbuffers::GetRoot(flex.GetBuffer()).AsMap();
+  TEST_EQ(map.size(), strings.size());
+  for (size_t i = 0; i < strings.size(); i++) {
+    auto pair = map[("key" + flatbuffers::NumToString(i)).c_str()].AsVector();
+    TEST_EQ(pair[0].AsString().str(), strings[i]);
+    TEST_EQ(pair[1].AsString().str(), strings[strings.size() - 1 - i]);
+  }
+}
+
+void StringDictionaryTest() {
+  // clang-format off
+  #if FLATBUFFERS_HAS_THREADS
+  // clang-format on
+  flatbuffers::StringDictionary dictionary;
+  const auto &host = dictionary.Intern("host");
+  const auto &metric = dictionary.Intern(std::string("cpu\0load", 8));
+  TEST_EQ(&dictionary.Intern("host"), &host);
+  TEST_EQ(&dictionary.Intern(std::string("cpu")) != &metric, true);
+  TEST_EQ(dictionary.size(), 3U);
+  TEST_EQ(host.id, 0U);
+  TEST_EQ(metric.size, 8U);
+  TEST_EQ(metric.hash, flatbuffers::HashStringBytes(metric.data, 8));
+
+  flatbuffers::FlatBufferBuilder fbb;
+  fbb.SetStringDictionary(&dictionary);
+  for (int pass = 0; pass < 2; pass++) {
+    fbb.Clear();
+    auto first = fbb.CreateSharedString(metric);
+    auto plain = fbb.CreateSharedString("host");
+    auto size = fbb.GetSize();
+    TEST_EQ(fbb.CreateSharedString(metric).o, first.o);
+    // Shared with the strings added by their characters.
+    TEST_EQ(fbb.CreateSharedString(host).o, plain.o);
+    TEST_EQ(fbb.CreateSharedString(std::string("cpu\0load", 8)).o, first.o);
+    TEST_EQ(fbb.GetSize(), size);
+    std::vector<flatbuffers::Offset<flatbuffers::String>> offsets;
+    offsets.push_back(first);
+    offsets.push_back(fbb.CreateSharedString(host));
+    fbb.Finish(fbb.CreateVector(offsets));
+    auto vec = flatbuffers::GetRoot<
+        flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>>(
+        fbb.GetBufferPointer());
+    TEST_EQ(vec->Get(0)->str(), std::string("cpu\0load", 8));
+    TEST_EQ_STR(vec->Get(1)->c_str(), "host");
+  }
+
+  // Interning from several threads gives each string one id.
+  std::vector<std::thread> threads;
+  std::vector<std::vector<const flatbuffers::InternedString *>> interned(4);
+  std::vector<int> shared(interned.size(), 0);
+  for (size_t t = 0; t < interned.size(); t++) {
+    threads.push_back(std::thread([&, t]() {
+      flatbuffers::FlatBufferBuilder builder;
+      builder.SetStringDictionary(&dictionary);
+      for (int i = 0; i < 500; i++) {
+        auto &str = dictionary.Intern("name" + flatbuffers::NumToString(i));
+        interned[t].push_back(&str);
+        auto off = builder.CreateSharedString(str);
+        shared[t] += builder.CreateSharedString(str).o == off.o;
+      }
+    }));
+  }
+  for (auto it = threads.begin(); it != threads.end(); ++it) it->join();
+  TEST_EQ(dictionary.size(), 503U);
+  for (size_t t = 0; t < interned.size(); t++) {
+    TEST_EQ(interned[t] == interned[0], true);
+    TEST_EQ(shared[t], 500);
+  }
+  // clang-format off
+  #endif  // FLATBUFFERS_HAS_THREADS
+  // clang-format on
+}
+
 #if !defined(FLATBUFFERS_SPAN_MINIMAL)
 void FlatbuffersSpanTest() {
   // Compile-time checking of non-const [] to const [] conversions.
@@ -4016,6 +5860,68 @@ void ParseFlexbuffersFromJsonWithNullTest() {
   }
 }
 
+void JsonToFlexBufferTest() {
+  const char *json =
+      "{ // Comments, unquoted keys, single quotes and trailing commas.\n"
+      "  name: 'gizmo \\u00e9\\n', \"id\": 12345678901234, ratio: -0.125,\n"
+      "  tags: [ \"a\", \"b\", \"\u00e9t\u00e9\", ], /* block * comment */\n"
+      "  nested: { on: true, off: false, none: null, list: [[1], [-2, 3e3]] },\n"
+      "  empty: {}, none: [] }";
+  flatbuffers::Parser parser;
+  flexbuffers::Builder expected(512, flexbuffers::BUILDER_FLAG_SHARE_ALL);
+  TEST_EQ(parser.ParseFlexBuffer(json, nullptr, &expected), true);
+
+  // Gives the same buffer as the parser, wherever the chunks are split.
+  const size_t len = strlen(json);
+  const size_t chunk_sizes[] = { 1, 2, 3, 7, 64, len };
+  for (size_t k = 0; k < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); k++) {
+    flexbuffers::Builder builder(512, flexbuffers::BUILDER_FLAG_SHARE_ALL);
+    flatbuffers::JsonToFlexBuffer converter(&builder);
+    for (size_t i = 0; i < len; i += chunk_sizes[k]) {
+      TEST_EQ(converter.Feed(json + i, (std::min)(chunk_sizes[k], len - i)),
+              true);
+    }
+    TEST_EQ(converter.Finish(), true);
+    TEST_EQ(builder.GetBuffer() == expected.GetBuffer(), true);
+  }
+
+  // A root that isn't a map or vector ends with the JSON.
+  flexbuffers::Builder builder;
+  flatbuffers::JsonToFlexBuffer number(&builder);
+  TEST_EQ(number.Feed("12"), true);
+  TEST_EQ(number.Feed("34"), true);
+  TEST_EQ(number.Finish(), true);
+  TEST_EQ(flexbuffers::GetRoot(builder.GetBuffer()).AsInt64(), 1234);
+
+  // Like JsonReader, but unlike the parser, reads hex and integers too big
+  // for int64_t.
+  builder.Clear();
+  flatbuffers::JsonToFlexBuffer numbers(&builder);
+  TEST_EQ(numbers.Feed("[0x1F, -123456789012345678901]"), true);
+  TEST_EQ(numbers.Finish(), true);
+  auto vec = flexbuffers::GetRoot(builder.GetBuffer()).AsVector();
+  TEST_EQ(vec[0].AsInt64(), 31);
+  TEST_EQ(vec[1].AsDouble(), -123456789012345678901.0);
+
+  const char *errors[] = {
+    "{ a: 1 ",        "{ a 1 }",     "[1, 2,, 3]",      "{ a: 1 } 2",
+    "[\"abc]",        "[01x]",       "{ a: 1, a: 2 }",  "[\"\\q\"]",
+    "[\"\\ud800x\"]", "[\"\xff\"]",  "[1 2]",           "/ [1]",
+    "{\"a\":1} /* x", "[1] /* x *",
+  };
+  for (size_t i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
+    builder.Clear();
+    flatbuffers::JsonToFlexBuffer converter(&builder);
+    TEST_EQ(converter.Feed(errors[i]) && converter.Finish(), false);
+    TEST_EQ(converter.error().empty(), false);
+  }
+  flatbuffers::JsonOptions strict;
+  strict.strict_json = true;
+  builder.Clear();
+  flatbuffers::JsonToFlexBuffer trailing_comma(&builder, strict);
+  TEST_EQ(trailing_comma.Feed("[1, 2,]") && trailing_comma.Finish(), false);
+}
+
 void FieldIdentifierTest() {
   using flatbuffers::Parser;
   TEST_EQ(true, Parser().Parse("table T{ f: int (id:0); }"));
@@ -4147,8 +6053,18 @@ int FlatBufferTests() {
   MutateFlatBuffersTest(flatbuf.data(), flatbuf.size());
 
   ObjectFlatBuffersTest(flatbuf.data());
+  BuilderGrowthTest(flatbuf.data());
+  SegmentedBuilderTest();
+  BuilderStatsTest();
 
   MiniReflectFlatBuffersTest(flatbuf.data());
+  MiniReflectVerifyAndCopyTest(flatbuf.data(), flatbuf.size());
+  MiniReflectToStringReuseTest(flatbuf.data());
+  VerifierStatsTest(flatbuf.data(), flatbuf.size());
+  ParallelVerifierTest();
+  LazyVerifierTest(flatbuf.data(), flatbuf.size());
+  VerifyUtf8Test();
+  VerificationCacheTest();
   MiniReflectFixedLengthArrayTest();
 
   SizePrefixedTest();
@@ -4163,6 +6079,7 @@ int FlatBufferTests() {
     FixedLengthArrayJsonTest(false);
     FixedLengthArrayJsonTest(true);
     ReflectionTest(flatbuf.data(), flatbuf.size());
+    FlexBufferTranscodeTest();
     ParseProtoTest();
     ParseProtoTestWithSuffix();
     ParseProtoTestWithIncludes();
@@ -4171,6 +6088,9 @@ int FlatBufferTests() {
     UnionVectorTest();
     LoadVerifyBinaryTest();
     GenerateTableTextTest();
+    GenerateTextSinkTest();
+    ParallelGenerateTextTest();
+    GeneratedJsonTest();
     TestEmbeddedBinarySchema();
   #endif
   // clang-format on
@@ -4202,13 +6122,22 @@ int FlatBufferTests() {
   TypeAliasesTest();
   EndianSwapTest();
   CreateSharedStringTest();
+  StringPoolTest();
+  StringDictionaryTest();
   JsonDefaultTest();
   JsonEnumsTest();
   FlexBuffersTest();
   FlexBuffersDeprecatedTest();
+  FlexBuffersMapKeyTest();
+  FlexBuffersTypedCopyTest();
+  FlexBuffersEditorTest();
+  FlexBuffersPathTest();
+  FlexBuffersCanonicalTest();
+  FlexBuffersReleaseTest();
   UninitializedVectorTest();
   EqualOperatorTest();
   NumericUtilsTest();
+  NumericUtilsExactTest();
   IsAsciiUtilsTest();
   ValidFloatTest();
   InvalidFloatTest();
@@ -4217,6 +6146,7 @@ int FlatBufferTests() {
   NativeTypeTest();
   OptionalScalarsTest();
   ParseFlexbuffersFromJsonWithNullTest();
+  JsonToFlexBufferTest();
   FlatbuffersSpanTest();
   FixedLengthArrayConstructorTest();
   FieldIdentifierTest();